@@ -0,0 +1,470 @@
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <imgui.h>
+#include "bonsai/core/job_system.hpp"
+#include "bonsai/core/platform.hpp"
+#include "bonsai/render_backend/render_backend.hpp"
+#include "benchmark.hpp"
+
+/*
+ * Render backend benchmarks, these run against a real device on a hidden surface.
+ * In CI these run on lavapipe, so results track CPU side backend overhead rather than GPU performance.
+ * Set MESA_VK_WSI_PRESENT_MODE=immediate for software drivers, so frame benchmarks are not limited by the present rate.
+ */
+
+static constexpr char const* DRAW_SHADER_CODE = R"(
+struct VertexOutput
+{
+    float4 position : SV_POSITION;
+};
+
+[shader("vertex")]
+VertexOutput VSmain(uint vertex_id : SV_VertexID)
+{
+    // A tiny triangle, so draw cost is dominated by per draw overhead instead of rasterization
+    float2 const positions[3] = { float2(0.0, -0.01), float2(0.01, 0.01), float2(-0.01, 0.01) };
+    VertexOutput result;
+    result.position = float4(positions[vertex_id % 3], 0, 1);
+    return result;
+}
+
+[shader("pixel")]
+float4 PSmain(VertexOutput input) : SV_TARGET0
+{
+    return float4(1, 1, 1, 1);
+}
+)";
+
+/// @brief Number of draws recorded per frame by the parallel recording benchmark, split evenly across recorders.
+static constexpr uint32_t PARALLEL_DRAW_COUNT = 50'000;
+
+/// @brief Shared benchmark render backend, created on first use so listing benchmarks does not require a device.
+class BackendFixture
+{
+public:
+    BackendFixture()
+    {
+        m_imgui_context = ImGui::CreateContext();
+        m_platform = new Platform();
+
+        PlatformSurfaceConfig surface_config{};
+        surface_config.resizable = false;
+        surface_config.high_dpi = false;
+        surface_config.hidden = true;
+        m_surface = m_platform->create_surface("Bonsai Benchmarks", 1280, 720, surface_config);
+        job_system = new JobSystem(0);
+        backend = RenderBackend::create(m_surface, m_imgui_context, job_system);
+    }
+
+    ~BackendFixture()
+    {
+        if (backend != nullptr)
+        {
+            backend->wait_idle();
+            delete draw_pipeline;
+            delete backend;
+        }
+
+        delete job_system;  // Deleted after the backend, which compiles shaders on the job system
+        m_platform->destroy_surface(m_surface);
+        delete m_platform;
+        ImGui::DestroyContext(m_imgui_context);
+    }
+
+    BackendFixture(BackendFixture const&) = delete;
+    BackendFixture& operator=(BackendFixture const&) = delete;
+
+    RenderBackend* backend = nullptr;
+    ShaderPipeline* draw_pipeline = nullptr;
+    JobSystem* job_system = nullptr;
+
+private:
+    ImGuiContext* m_imgui_context = nullptr;
+    Platform* m_platform = nullptr;
+    PlatformSurface* m_surface = nullptr;
+};
+
+/// @brief Get the shared benchmark fixture.
+static BackendFixture& get_fixture()
+{
+    static BackendFixture fixture{};
+    return fixture;
+}
+
+/// @brief Create the draw benchmark pipeline, rendering to the swap chain format.
+/// @param shader_code HLSL shader code containing the VSmain & PSmain entrypoints.
+static ShaderPipeline* create_draw_pipeline(RenderBackend* backend, char const* shader_code)
+{
+    ShaderSource vertex_shader{};
+    vertex_shader.source_kind = ShaderSourceKindInline;
+    vertex_shader.entrypoint = "VSmain";
+    vertex_shader.shader_source = shader_code;
+
+    ShaderSource fragment_shader{};
+    fragment_shader.source_kind = ShaderSourceKindInline;
+    fragment_shader.entrypoint = "PSmain";
+    fragment_shader.shader_source = shader_code;
+
+    GraphicsPipelineDescriptor pipeline_descriptor{};
+    pipeline_descriptor.vertex_shader = &vertex_shader;
+    pipeline_descriptor.fragment_shader = &fragment_shader;
+    pipeline_descriptor.vertex_input_state.input_attribute_count = 0;
+    pipeline_descriptor.vertex_input_state.input_attributes = nullptr;
+    pipeline_descriptor.input_assembly_state.primitive_topology = PrimitiveTopologyTypeTriangleList;
+    pipeline_descriptor.input_assembly_state.strip_cut_value = IndexBufferStripCutValueDisabled;
+    pipeline_descriptor.rasterization_state.polygon_mode = PolygonModeFill;
+    pipeline_descriptor.rasterization_state.cull_mode = CullModeNone;
+    pipeline_descriptor.multisample_state.sample_count = SampleCount1Sample;
+    pipeline_descriptor.multisample_state.sample_mask = nullptr;
+    pipeline_descriptor.depth_stencil_state.depth_compare_op = CompareOpLess;
+    pipeline_descriptor.color_blend_state.logic_op = LogicOpClear;
+    pipeline_descriptor.color_blend_state.attachments[0].blend_enable = false;
+    pipeline_descriptor.color_blend_state.attachments[0].color_write_mask = ColorComponentAll;
+    pipeline_descriptor.color_attachment_count = 1;
+    pipeline_descriptor.color_attachment_formats[0] = backend->get_swap_format();
+    pipeline_descriptor.depth_stencil_attachment_format = RenderFormatUndefined;
+    pipeline_descriptor.view_mask = 0;
+
+    return backend->create_graphics_pipeline(pipeline_descriptor);
+}
+
+/// @brief Get the backend & draw pipeline, or report an error if the backend is unavailable.
+/// @return A boolean indicating the fixture is usable.
+static bool prepare_fixture(BenchmarkState& state, bool needs_draw_pipeline)
+{
+    BackendFixture& fixture = get_fixture();
+    if (fixture.backend == nullptr)
+    {
+        state.skip_with_error("No render backend available");
+        return false;
+    }
+
+    if (needs_draw_pipeline && fixture.draw_pipeline == nullptr)
+    {
+        fixture.draw_pipeline = create_draw_pipeline(fixture.backend, DRAW_SHADER_CODE);
+        if (fixture.draw_pipeline == nullptr)
+        {
+            state.skip_with_error("Failed to create draw pipeline");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Record draws of the tiny triangle, setting the pipeline & dynamic state first.
+/// @param commands Render commands to record into, either the frame commands or a parallel recorder.
+/// @param render_area Render area, used for the viewport & scissor.
+/// @param draw_count Number of draws to record.
+static void record_draws(RenderCommands* commands, RenderRect2D render_area, uint32_t draw_count)
+{
+    RenderViewport viewport{ 0.0F, 0.0F, static_cast<float>(render_area.extent.width), static_cast<float>(render_area.extent.height), 0.0F, 1.0F };
+    commands->set_pipeline(get_fixture().draw_pipeline);
+    commands->set_primitive_topology(PrimitiveTopologyTypeTriangleList);
+    commands->set_viewports(1, &viewport);
+    commands->set_scissor_rects(1, &render_area);
+    for (uint32_t i = 0; i < draw_count; i++)
+    {
+        commands->draw_instanced(3, 1, 0, 0);
+    }
+}
+
+/// @brief Record & submit a frame drawing to the swap texture.
+/// @param state Benchmark state, timing is paused outside of recording if only recording is measured.
+/// @param draw_count Number of draws recorded in the frame.
+/// @param recorder_count Number of parallel recorders sharing the draws, zero records the draws in the frame commands.
+/// @param time_recording_only Only time command recording, excluding frame acquisition & submission.
+/// @return A boolean indicating success.
+static bool record_frame(BenchmarkState& state, uint32_t draw_count, uint32_t recorder_count, bool time_recording_only)
+{
+    BackendFixture& fixture = get_fixture();
+    RenderBackend* backend = fixture.backend;
+    if (time_recording_only)
+    {
+        state.pause_timing();
+    }
+
+    if (backend->new_frame() != RenderBackendFrameResult::Ok)
+    {
+        state.skip_with_error("Failed to start frame");
+        return false;
+    }
+
+    RenderCommands* commands = backend->get_frame_commands();
+    RenderTexture* swap_texture = backend->get_current_swap_texture();
+    RenderExtent2D const swap_extent = backend->get_swap_extent();
+    commands->begin();
+    commands->transition_texture(swap_texture, RenderResourceStateColorTarget, true);
+    if (time_recording_only)
+    {
+        state.resume_timing();
+    }
+
+    RenderAttachmentInfo color_target{};
+    color_target.render_target = swap_texture;
+    color_target.resolve_target = nullptr;
+    color_target.load_op = RenderLoadOpClear;
+    color_target.store_op = RenderStoreOpStore;
+    color_target.clear_value.color = RenderClearColor{ { 0.0F, 0.0F, 0.0F, 1.0F } };
+
+    RenderRect2D const render_area{ RenderOffset2D{ 0, 0 }, swap_extent };
+    bool recorded = true;
+    if (recorder_count == 0)
+    {
+        commands->begin_render_pass(render_area, &color_target, 1, nullptr, nullptr, 1, 0);
+        record_draws(commands, render_area, draw_count);
+    }
+    else
+    {
+        // Every recorder records its share of the draws in its own job, like a renderer splitting a pass across workers
+        std::atomic<bool> recorders_ok{ true };
+        commands->begin_parallel_render_pass(render_area, &color_target, 1, nullptr, nullptr, 1, 0, recorder_count);
+        fixture.job_system->parallel_for(recorder_count, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                uint32_t const first_draw = static_cast<uint32_t>(draw_count * i / recorder_count);
+                uint32_t const last_draw = static_cast<uint32_t>(draw_count * (i + 1) / recorder_count);
+                RenderCommands* recorder = commands->get_parallel_recorder(static_cast<uint32_t>(i));
+                if (!recorder->begin())
+                {
+                    recorders_ok = false;
+                    continue;
+                }
+                record_draws(recorder, render_area, last_draw - first_draw);
+                recorders_ok = recorder->end() && recorders_ok;
+            }
+        });
+        recorded = recorders_ok;
+    }
+    commands->end_render_pass();
+
+    if (time_recording_only)
+    {
+        state.pause_timing();
+    }
+
+    commands->mark_for_present(swap_texture);
+    commands->end();
+    if (backend->end_frame() == RenderBackendFrameResult::FatalError)
+    {
+        state.skip_with_error("Failed to end frame");
+        return false;
+    }
+
+    if (!recorded)
+    {
+        state.skip_with_error("Failed to record parallel recorder commands");
+        return false;
+    }
+
+    if (time_recording_only)
+    {
+        state.resume_timing();
+    }
+    else
+    {
+        backend->wait_idle(); // Submission benchmarks include GPU execution of the frame
+    }
+
+    return true;
+}
+
+static void bench_buffer_create_destroy(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, false))
+    {
+        return;
+    }
+
+    RenderBackend* backend = get_fixture().backend;
+    size_t const size = static_cast<size_t>(state.argument());
+    while (state.keep_running())
+    {
+        RenderBuffer* buffer = backend->create_buffer(size, RenderBufferUsageStorageBuffer | RenderBufferUsageTransferDst, false);
+        if (buffer == nullptr)
+        {
+            state.skip_with_error("Failed to create buffer");
+            break;
+        }
+        delete buffer;
+    }
+    state.set_bytes_processed(state.iterations() * size);
+}
+BONSAI_BENCHMARK_ARGS(bench_buffer_create_destroy, 256, 64 << 10, 16 << 20);
+
+static void bench_texture_create_destroy(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, false))
+    {
+        return;
+    }
+
+    RenderBackend* backend = get_fixture().backend;
+    uint32_t const size = static_cast<uint32_t>(state.argument());
+    while (state.keep_running())
+    {
+        RenderTexture* texture = backend->create_texture(
+            RenderTextureType2D,
+            RenderFormatRGBA8_UNORM,
+            size, size, 1, 1,
+            SampleCount1Sample,
+            RenderTextureUsageSampled | RenderTextureUsageTransferDst,
+            RenderTextureTilingOptimal
+        );
+        if (texture == nullptr)
+        {
+            state.skip_with_error("Failed to create texture");
+            break;
+        }
+        delete texture;
+    }
+}
+BONSAI_BENCHMARK_ARGS(bench_texture_create_destroy, 64, 512, 2048);
+
+static void bench_mapped_write(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, false))
+    {
+        return;
+    }
+
+    RenderBackend* backend = get_fixture().backend;
+    size_t const size = static_cast<size_t>(state.argument());
+    RenderBuffer* buffer = backend->create_buffer(size, RenderBufferUsageStorageBuffer, true);
+    if (buffer == nullptr)
+    {
+        state.skip_with_error("Failed to create mapped buffer");
+        return;
+    }
+
+    std::vector<uint8_t> const source(size, 0xA5);
+    while (state.keep_running())
+    {
+        void* data = nullptr;
+        if (!buffer->map(&data, size, 0))
+        {
+            state.skip_with_error("Failed to map buffer");
+            break;
+        }
+        std::memcpy(data, source.data(), size);
+        buffer->unmap();
+    }
+    state.set_bytes_processed(state.iterations() * size);
+    delete buffer;
+}
+BONSAI_BENCHMARK_ARGS(bench_mapped_write, 4 << 10, 1 << 20, 16 << 20);
+
+static void bench_pipeline_create_cold(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, false))
+    {
+        return;
+    }
+
+    // Every iteration uses unique shader code, so no compiler or driver cache can be hit
+    static uint32_t s_variant = 0;
+    RenderBackend* backend = get_fixture().backend;
+    while (state.keep_running())
+    {
+        state.pause_timing();
+        std::string const shader_code = std::string(DRAW_SHADER_CODE) + "\n// variant " + std::to_string(s_variant++) + "\n";
+        state.resume_timing();
+
+        ShaderPipeline* pipeline = create_draw_pipeline(backend, shader_code.c_str());
+        if (pipeline == nullptr)
+        {
+            state.skip_with_error("Failed to create pipeline");
+            break;
+        }
+        delete pipeline;
+    }
+}
+BONSAI_BENCHMARK_ITERATIONS(bench_pipeline_create_cold, 8);
+
+static void bench_pipeline_create_warm(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, true))
+    {
+        return;
+    }
+
+    // The fixture already created a pipeline from the same code, so any caches are warm
+    RenderBackend* backend = get_fixture().backend;
+    while (state.keep_running())
+    {
+        ShaderPipeline* pipeline = create_draw_pipeline(backend, DRAW_SHADER_CODE);
+        if (pipeline == nullptr)
+        {
+            state.skip_with_error("Failed to create pipeline");
+            break;
+        }
+        delete pipeline;
+    }
+}
+BONSAI_BENCHMARK(bench_pipeline_create_warm);
+
+static void bench_command_recording(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, true))
+    {
+        return;
+    }
+
+    uint32_t const draw_count = static_cast<uint32_t>(state.argument());
+    while (state.keep_running())
+    {
+        if (!record_frame(state, draw_count, 0, true))
+        {
+            break;
+        }
+    }
+    state.set_items_processed(state.iterations() * draw_count);
+}
+BONSAI_BENCHMARK_ARGS(bench_command_recording, 1'000, 10'000, 100'000);
+
+static void bench_draw_submission(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, true))
+    {
+        return;
+    }
+
+    uint32_t const draw_count = static_cast<uint32_t>(state.argument());
+    while (state.keep_running())
+    {
+        if (!record_frame(state, draw_count, 0, false))
+        {
+            break;
+        }
+    }
+    state.set_items_processed(state.iterations() * draw_count);
+}
+BONSAI_BENCHMARK_ARGS(bench_draw_submission, 1, 10, 100, 1'000, 10'000, 100'000);
+
+static void bench_parallel_command_recording(BenchmarkState& state)
+{
+    if (!prepare_fixture(state, true))
+    {
+        return;
+    }
+
+    // The argument is the recorder count, the draw count stays fixed so results show how recording scales across cores
+    uint32_t const recorder_count = static_cast<uint32_t>(state.argument());
+    if (recorder_count > get_fixture().backend->get_frame_commands()->get_max_parallel_recorders())
+    {
+        state.skip_with_error("Recorder count exceeds the maximum parallel recorder count");
+        return;
+    }
+
+    while (state.keep_running())
+    {
+        if (!record_frame(state, PARALLEL_DRAW_COUNT, recorder_count, true))
+        {
+            break;
+        }
+    }
+    state.set_items_processed(state.iterations() * PARALLEL_DRAW_COUNT);
+}
+BONSAI_BENCHMARK_ARGS(bench_parallel_command_recording, 1, 2, 4, 8);
@@ -0,0 +1,224 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <volk.h>
+#include "render_backend/vulkan/vulkan_buffer.hpp"
+#include "render_backend/vulkan/vulkan_render_commands.hpp"
+#include "render_backend/vulkan/vulkan_shader_pipeline.hpp"
+#include "render_backend/vulkan/vulkan_texture.hpp"
+#include "benchmark.hpp"
+
+/*
+ * Render command recording benchmark, measures the CPU overhead of VulkanRenderCommands per recorded command.
+ * Vulkan entry points are replaced by no-op stubs while recording, so no device is required and only the backend recording
+ * cost is measured. The benchmark fails if recording allocates heap memory once warmed up.
+ */
+
+/// @brief Number of commands recorded per benchmark iteration.
+static constexpr uint32_t COMMAND_COUNT = 100'000;
+
+/// @brief Number of heap allocations since program start, used to verify the recording hot path does not allocate.
+/// Allocations of the whole benchmark executable are counted, other benchmarks also allocate from job system workers.
+static std::atomic<size_t> g_allocation_count{ 0 };
+
+void* operator new(size_t size)
+{
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size != 0 ? size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL stub_begin_command_buffer(VkCommandBuffer, VkCommandBufferBeginInfo const*) { return VK_SUCCESS; }
+static VKAPI_ATTR VkResult VKAPI_CALL stub_end_command_buffer(VkCommandBuffer) { return VK_SUCCESS; }
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_begin_rendering(VkCommandBuffer, VkRenderingInfo const*) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_end_rendering(VkCommandBuffer) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_pipeline_barrier2(VkCommandBuffer, VkDependencyInfo const*) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_bind_pipeline(VkCommandBuffer, VkPipelineBindPoint, VkPipeline) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_set_primitive_topology(VkCommandBuffer, VkPrimitiveTopology) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_set_viewport_with_count(VkCommandBuffer, uint32_t, VkViewport const*) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_set_scissor_with_count(VkCommandBuffer, uint32_t, VkRect2D const*) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_bind_vertex_buffers(VkCommandBuffer, uint32_t, uint32_t, VkBuffer const*, VkDeviceSize const*) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_bind_index_buffer(VkCommandBuffer, VkBuffer, VkDeviceSize, VkIndexType) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_draw(VkCommandBuffer, uint32_t, uint32_t, uint32_t, uint32_t) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_draw_indexed(VkCommandBuffer, uint32_t, uint32_t, uint32_t, int32_t, uint32_t) {}
+static VKAPI_ATTR void VKAPI_CALL stub_destroy_pipeline(VkDevice, VkPipeline, VkAllocationCallbacks const*) {}
+static VKAPI_ATTR void VKAPI_CALL stub_destroy_pipeline_layout(VkDevice, VkPipelineLayout, VkAllocationCallbacks const*) {}
+
+/// @brief Replaces the Vulkan entry points used for recording with no-op stubs, the original entry points are restored
+/// on destruction so benchmarks using a real device are not affected.
+class VulkanStubScope
+{
+public:
+    VulkanStubScope()
+    {
+        m_begin_command_buffer = vkBeginCommandBuffer;
+        m_end_command_buffer = vkEndCommandBuffer;
+        m_cmd_begin_rendering = vkCmdBeginRendering;
+        m_cmd_end_rendering = vkCmdEndRendering;
+        m_cmd_pipeline_barrier2 = vkCmdPipelineBarrier2;
+        m_cmd_bind_pipeline = vkCmdBindPipeline;
+        m_cmd_set_primitive_topology = vkCmdSetPrimitiveTopology;
+        m_cmd_set_viewport_with_count = vkCmdSetViewportWithCount;
+        m_cmd_set_scissor_with_count = vkCmdSetScissorWithCount;
+        m_cmd_bind_vertex_buffers = vkCmdBindVertexBuffers;
+        m_cmd_bind_index_buffer = vkCmdBindIndexBuffer;
+        m_cmd_draw = vkCmdDraw;
+        m_cmd_draw_indexed = vkCmdDrawIndexed;
+        m_destroy_pipeline = vkDestroyPipeline;
+        m_destroy_pipeline_layout = vkDestroyPipelineLayout;
+
+        vkBeginCommandBuffer = stub_begin_command_buffer;
+        vkEndCommandBuffer = stub_end_command_buffer;
+        vkCmdBeginRendering = stub_cmd_begin_rendering;
+        vkCmdEndRendering = stub_cmd_end_rendering;
+        vkCmdPipelineBarrier2 = stub_cmd_pipeline_barrier2;
+        vkCmdBindPipeline = stub_cmd_bind_pipeline;
+        vkCmdSetPrimitiveTopology = stub_cmd_set_primitive_topology;
+        vkCmdSetViewportWithCount = stub_cmd_set_viewport_with_count;
+        vkCmdSetScissorWithCount = stub_cmd_set_scissor_with_count;
+        vkCmdBindVertexBuffers = stub_cmd_bind_vertex_buffers;
+        vkCmdBindIndexBuffer = stub_cmd_bind_index_buffer;
+        vkCmdDraw = stub_cmd_draw;
+        vkCmdDrawIndexed = stub_cmd_draw_indexed;
+        vkDestroyPipeline = stub_destroy_pipeline;
+        vkDestroyPipelineLayout = stub_destroy_pipeline_layout;
+    }
+
+    ~VulkanStubScope()
+    {
+        vkBeginCommandBuffer = m_begin_command_buffer;
+        vkEndCommandBuffer = m_end_command_buffer;
+        vkCmdBeginRendering = m_cmd_begin_rendering;
+        vkCmdEndRendering = m_cmd_end_rendering;
+        vkCmdPipelineBarrier2 = m_cmd_pipeline_barrier2;
+        vkCmdBindPipeline = m_cmd_bind_pipeline;
+        vkCmdSetPrimitiveTopology = m_cmd_set_primitive_topology;
+        vkCmdSetViewportWithCount = m_cmd_set_viewport_with_count;
+        vkCmdSetScissorWithCount = m_cmd_set_scissor_with_count;
+        vkCmdBindVertexBuffers = m_cmd_bind_vertex_buffers;
+        vkCmdBindIndexBuffer = m_cmd_bind_index_buffer;
+        vkCmdDraw = m_cmd_draw;
+        vkCmdDrawIndexed = m_cmd_draw_indexed;
+        vkDestroyPipeline = m_destroy_pipeline;
+        vkDestroyPipelineLayout = m_destroy_pipeline_layout;
+    }
+
+    VulkanStubScope(VulkanStubScope const&) = delete;
+    VulkanStubScope& operator=(VulkanStubScope const&) = delete;
+
+private:
+    PFN_vkBeginCommandBuffer m_begin_command_buffer = nullptr;
+    PFN_vkEndCommandBuffer m_end_command_buffer = nullptr;
+    PFN_vkCmdBeginRendering m_cmd_begin_rendering = nullptr;
+    PFN_vkCmdEndRendering m_cmd_end_rendering = nullptr;
+    PFN_vkCmdPipelineBarrier2 m_cmd_pipeline_barrier2 = nullptr;
+    PFN_vkCmdBindPipeline m_cmd_bind_pipeline = nullptr;
+    PFN_vkCmdSetPrimitiveTopology m_cmd_set_primitive_topology = nullptr;
+    PFN_vkCmdSetViewportWithCount m_cmd_set_viewport_with_count = nullptr;
+    PFN_vkCmdSetScissorWithCount m_cmd_set_scissor_with_count = nullptr;
+    PFN_vkCmdBindVertexBuffers m_cmd_bind_vertex_buffers = nullptr;
+    PFN_vkCmdBindIndexBuffer m_cmd_bind_index_buffer = nullptr;
+    PFN_vkCmdDraw m_cmd_draw = nullptr;
+    PFN_vkCmdDrawIndexed m_cmd_draw_indexed = nullptr;
+    PFN_vkDestroyPipeline m_destroy_pipeline = nullptr;
+    PFN_vkDestroyPipelineLayout m_destroy_pipeline_layout = nullptr;
+};
+
+/// @brief Record a render pass with the given number of commands, cycling through a typical draw sequence.
+/// @return The number of recorded commands.
+static uint32_t record_commands(
+    VulkanRenderCommands& commands,
+    RenderTexture* target,
+    ShaderPipeline* pipeline,
+    RenderBuffer* vertex_buffer,
+    RenderBuffer* index_buffer
+)
+{
+    RenderAttachmentInfo color_target{};
+    color_target.render_target = target;
+    color_target.resolve_target = nullptr;
+    color_target.load_op = RenderLoadOpClear;
+    color_target.store_op = RenderStoreOpStore;
+
+    RenderRect2D const render_area{ RenderOffset2D{ 0, 0 }, RenderExtent2D{ 1920, 1080 } };
+    RenderViewport viewport{ 0.0F, 0.0F, 1920.0F, 1080.0F, 0.0F, 1.0F };
+    RenderRect2D scissor = render_area;
+    RenderBuffer* vertex_buffers[] = { vertex_buffer };
+    size_t vertex_offsets[] = { 0 };
+
+    commands.begin();
+    commands.begin_render_pass(render_area, &color_target, 1, nullptr, nullptr, 1, 0);
+
+    uint32_t command_count = 0;
+    while (command_count < COMMAND_COUNT)
+    {
+        switch (command_count % 8)
+        {
+        case 0: commands.set_pipeline(pipeline); break;
+        case 1: commands.set_primitive_topology(PrimitiveTopologyTypeTriangleList); break;
+        case 2: commands.set_viewports(1, &viewport); break;
+        case 3: commands.set_scissor_rects(1, &scissor); break;
+        case 4: commands.bind_vertex_buffers(0, 1, vertex_buffers, vertex_offsets); break;
+        case 5: commands.bind_index_buffer(index_buffer, 0, IndexTypeUint32); break;
+        case 6: commands.draw_indexed_instanced(36, 1, 0, 0, 0); break;
+        default: commands.draw_instanced(3, 1, 0, 0); break;
+        }
+        command_count++;
+    }
+
+    commands.end_render_pass();
+    commands.end();
+    return command_count;
+}
+
+static void bench_render_command_recording(BenchmarkState& state)
+{
+    VulkanStubScope const stubs{};
+
+    // All handles are NULL, the stubbed entry points never dereference them
+    VulkanTextureDesc target_desc{};
+    target_desc.format = RenderFormatRGBA8_UNORM;
+    target_desc.extent = RenderExtent3D{ 1920, 1080, 1 };
+    target_desc.mip_levels = 1;
+    target_desc.array_layers = 1;
+    target_desc.vk_aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT;
+    target_desc.vk_sample_count = VK_SAMPLE_COUNT_1_BIT;
+    VulkanTexture target(VK_NULL_HANDLE, VK_NULL_HANDLE, target_desc);
+    VulkanShaderPipeline pipeline(ShaderPipeline::Graphics, ShaderPipeline::WorkgroupSize{}, VK_NULL_HANDLE, {}, VK_NULL_HANDLE, VK_NULL_HANDLE);
+
+    // Buffers are intentionally leaked, VMA cannot destroy buffers without an allocator. They are shared by all runs.
+    static VulkanBuffer* s_vertex_buffer = new VulkanBuffer(VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VulkanBufferDesc{ 1024 });
+    static VulkanBuffer* s_index_buffer = new VulkanBuffer(VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VulkanBufferDesc{ 1024 });
+
+    VulkanRenderCommands commands(VK_NULL_HANDLE, nullptr, nullptr, nullptr, 1);
+    record_commands(commands, &target, &pipeline, s_vertex_buffer, s_index_buffer); // Warm up, grows reused barrier storage
+
+    // The recording hot path must not allocate once its storage has grown
+    size_t const allocation_count = g_allocation_count.load(std::memory_order_relaxed);
+    while (state.keep_running())
+    {
+        benchmark_do_not_optimize(record_commands(commands, &target, &pipeline, s_vertex_buffer, s_index_buffer));
+    }
+
+    if (g_allocation_count.load(std::memory_order_relaxed) != allocation_count)
+    {
+        state.skip_with_error("Render command recording allocated heap memory after warm up");
+        return;
+    }
+    state.set_items_processed(state.iterations() * COMMAND_COUNT);
+}
+BONSAI_BENCHMARK(bench_render_command_recording);
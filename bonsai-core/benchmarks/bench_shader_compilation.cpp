@@ -0,0 +1,96 @@
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "bonsai/core/job_system.hpp"
+#include "render_backend/shader_compiler_pool.hpp"
+#include "benchmark.hpp"
+
+/*
+ * Shader compilation throughput benchmarks, compiles a batch of shader permutations with an increasing number of threads.
+ * Throughput is reported as items per second, i.e. compiled shaders per second.
+ */
+
+/// @brief Number of shader permutations compiled per iteration.
+static constexpr uint32_t PERMUTATION_COUNT = 64;
+
+/// @brief Maximum number of compiling threads benchmarked.
+static constexpr uint32_t MAX_THREAD_COUNT = 16;
+
+static constexpr char const* PERMUTATION_SHADER_CODE = R"(
+[[vk::binding(0, 0)]] RWStructuredBuffer<float4> out_buffer : register(u0, space0);
+
+[shader("compute")]
+[numthreads(64, 1, 1)]
+void CSMain(uint3 thread_id : SV_DispatchThreadID)
+{
+    float4 value = float4(thread_id, 1);
+    [unroll]
+    for (uint i = 0; i < PERMUTATION_ITERATIONS; i++)
+    {
+        value = sin(value) * PERMUTATION_SCALE + cos(value.yzwx);
+    }
+    out_buffer[thread_id.x] = value;
+}
+)";
+
+/// @brief Shader permutation define values, permutations differ in their loop count & constants.
+struct PermutationDefines
+{
+    std::string iterations;
+    std::string scale;
+    ShaderDefine defines[2];
+};
+
+/// @brief Get the shader permutation defines.
+static std::vector<PermutationDefines> const& get_permutation_defines()
+{
+    static std::vector<PermutationDefines> permutations{};
+    if (permutations.empty())
+    {
+        permutations.resize(PERMUTATION_COUNT);
+        for (uint32_t i = 0; i < PERMUTATION_COUNT; i++)
+        {
+            PermutationDefines& permutation = permutations[i];
+            permutation.iterations = std::to_string(1 + i % 8);
+            permutation.scale = std::to_string(1.0 + i * 0.25);
+            permutation.defines[0] = ShaderDefine{ "PERMUTATION_ITERATIONS", permutation.iterations.c_str() };
+            permutation.defines[1] = ShaderDefine{ "PERMUTATION_SCALE", permutation.scale.c_str() };
+        }
+    }
+
+    return permutations;
+}
+
+static void bench_shader_compile_many(BenchmarkState& state)
+{
+    // The calling thread compiles alongside the workers, so one worker less than the maximum thread count is needed
+    static JobSystem s_job_system(MAX_THREAD_COUNT - 1);
+    static ShaderCompilerPool s_shader_compiler_pool(MAX_THREAD_COUNT, &s_job_system);
+    std::vector<PermutationDefines> const& permutations = get_permutation_defines();
+    std::vector<ShaderCompileRequest> requests(permutations.size());
+    for (size_t i = 0; i < permutations.size(); i++)
+    {
+        requests[i] = ShaderCompileRequest{
+            "permutation", "CSMain", BONSAI_TARGET_PROFILE_CS,
+            { PERMUTATION_SHADER_CODE, std::strlen(PERMUTATION_SHADER_CODE), 0 },
+            nullptr, nullptr, true,
+            permutations[i].defines, std::size(permutations[i].defines),
+        };
+    }
+
+    // The first batch creates the compiler instances, so they are not part of the measurement
+    uint32_t const thread_count = static_cast<uint32_t>(state.argument());
+    std::vector<ShaderCompileResult> results(requests.size());
+    s_shader_compiler_pool.compile_many(requests.data(), requests.size(), results.data(), thread_count);
+    while (state.keep_running())
+    {
+        if (s_shader_compiler_pool.compile_many(requests.data(), requests.size(), results.data(), thread_count) != requests.size())
+        {
+            state.skip_with_error("Failed to compile shader permutations");
+            break;
+        }
+    }
+    state.set_items_processed(state.iterations() * requests.size());
+}
+BONSAI_BENCHMARK_ARGS(bench_shader_compile_many, 1, 2, 4, 8, 16);
@@ -0,0 +1,165 @@
+#pragma once
+#ifndef BONSAI_RENDERER_BENCHMARK_HPP
+#define BONSAI_RENDERER_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/*
+ * Minimal benchmark harness, benchmarks register themselves with BONSAI_BENCHMARK & are run by benchmark_main.cpp.
+ * Results are written in the Google Benchmark JSON format, so existing regression tracking tools can read them.
+ */
+
+/// @brief Benchmark run state, passed to benchmark functions.
+/// Benchmark functions loop while @ref BenchmarkState::keep_running returns true, only the loop body is timed.
+class BenchmarkState
+{
+public:
+    BenchmarkState(int64_t argument, uint64_t iteration_count)
+        :
+        m_argument(argument),
+        m_iteration_count(iteration_count)
+    {
+        //
+    }
+
+    /// @brief Check if another iteration should run, starts timing on the first call & stops timing after the last iteration.
+    bool keep_running()
+    {
+        if (!m_started)
+        {
+            m_started = true;
+            resume_timing();
+        }
+        else
+        {
+            m_completed_iterations++;
+        }
+
+        if (m_completed_iterations < m_iteration_count && m_error.empty())
+        {
+            return true;
+        }
+
+        pause_timing();
+        return false;
+    }
+
+    /// @brief Stop timing, e.g. around per iteration setup that should not be measured.
+    void pause_timing()
+    {
+        if (m_timing)
+        {
+            m_elapsed += std::chrono::steady_clock::now() - m_timing_start;
+            m_timing = false;
+        }
+    }
+
+    /// @brief Resume timing after @ref BenchmarkState::pause_timing.
+    void resume_timing()
+    {
+        if (!m_timing)
+        {
+            m_timing_start = std::chrono::steady_clock::now();
+            m_timing = true;
+        }
+    }
+
+    /// @brief Stop the benchmark & report it as failed.
+    /// @param message Error message.
+    void skip_with_error(char const* message) { m_error = message; }
+
+    /// @brief Set the number of items processed by all iterations, reported as items per second.
+    void set_items_processed(uint64_t count) { m_items_processed = count; }
+
+    /// @brief Set the number of bytes processed by all iterations, reported as bytes per second.
+    void set_bytes_processed(uint64_t count) { m_bytes_processed = count; }
+
+    /// @brief Get the benchmark argument, zero for benchmarks without arguments.
+    [[nodiscard]]
+    int64_t argument() const { return m_argument; }
+
+    /// @brief Get the number of iterations this run executes.
+    [[nodiscard]]
+    uint64_t iterations() const { return m_iteration_count; }
+
+    /// @brief Get the timed duration in nanoseconds.
+    [[nodiscard]]
+    double elapsed_ns() const { return std::chrono::duration<double, std::nano>(m_elapsed).count(); }
+
+    [[nodiscard]]
+    uint64_t items_processed() const { return m_items_processed; }
+
+    [[nodiscard]]
+    uint64_t bytes_processed() const { return m_bytes_processed; }
+
+    [[nodiscard]]
+    std::string const& error() const { return m_error; }
+
+private:
+    int64_t m_argument = 0;
+    uint64_t m_iteration_count = 0;
+    uint64_t m_completed_iterations = 0;
+    bool m_started = false;
+    bool m_timing = false;
+    std::chrono::steady_clock::time_point m_timing_start = {};
+    std::chrono::steady_clock::duration m_elapsed = {};
+    uint64_t m_items_processed = 0;
+    uint64_t m_bytes_processed = 0;
+    std::string m_error = {};
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkState& state);
+
+/// @brief Registered benchmark.
+struct BenchmarkDefinition
+{
+    char const* name;
+    BenchmarkFunction function;
+    std::vector<int64_t> arguments;     /// @brief Arguments, the benchmark is run once per argument.
+    uint64_t fixed_iteration_count;     /// @brief Fixed iteration count, zero scales iterations to the minimum benchmark time.
+};
+
+/// @brief Get the registered benchmarks.
+std::vector<BenchmarkDefinition>& get_registered_benchmarks();
+
+/// @brief Static benchmark registration helper, used by the BONSAI_BENCHMARK macros.
+struct BenchmarkRegistration
+{
+    BenchmarkRegistration(char const* name, BenchmarkFunction function, std::initializer_list<int64_t> arguments, uint64_t fixed_iteration_count)
+    {
+        get_registered_benchmarks().push_back(BenchmarkDefinition{ name, function, arguments, fixed_iteration_count });
+    }
+};
+
+/// @brief Prevent the compiler from optimizing away a value that is only computed for benchmarking.
+template<typename Type>
+inline void benchmark_do_not_optimize(Type const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char const* sink = nullptr;
+    sink = reinterpret_cast<char const volatile*>(&value);
+#endif
+}
+
+#define BONSAI_BENCHMARK_CONCAT_IMPL(a, b)  a##b
+#define BONSAI_BENCHMARK_CONCAT(a, b)       BONSAI_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// @brief Register a benchmark function.
+#define BONSAI_BENCHMARK(function) \
+    static BenchmarkRegistration BONSAI_BENCHMARK_CONCAT(bonsai_benchmark_, __LINE__)(#function, function, {}, 0)
+
+/// @brief Register a benchmark function that is run once per argument.
+#define BONSAI_BENCHMARK_ARGS(function, ...) \
+    static BenchmarkRegistration BONSAI_BENCHMARK_CONCAT(bonsai_benchmark_, __LINE__)(#function, function, { __VA_ARGS__ }, 0)
+
+/// @brief Register a benchmark function that runs a fixed number of iterations, e.g. for cold start measurements.
+#define BONSAI_BENCHMARK_ITERATIONS(function, iteration_count) \
+    static BenchmarkRegistration BONSAI_BENCHMARK_CONCAT(bonsai_benchmark_, __LINE__)(#function, function, {}, iteration_count)
+
+#endif //BONSAI_RENDERER_BENCHMARK_HPP
@@ -0,0 +1,241 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+/*
+ * Benchmark runner, usage: <benchmark executable> [options]
+ *
+ *  --benchmark_filter=<substring>      Only run benchmarks whose name contains the substring.
+ *  --benchmark_min_time=<seconds>      Minimum timed duration of each benchmark, 0.5 seconds by default.
+ *  --benchmark_out=<path>              Write the results as Google Benchmark compatible JSON.
+ *  --benchmark_list                    List the registered benchmarks without running them.
+ */
+
+/// @brief Maximum number of iterations of a single benchmark run.
+static constexpr uint64_t MAX_ITERATION_COUNT = 1'000'000'000;
+
+/// @brief Completed benchmark run.
+struct BenchmarkResult
+{
+    std::string name;
+    uint64_t iterations;
+    double real_time_ns;        /// @brief Timed duration per iteration.
+    double items_per_second;
+    double bytes_per_second;
+    std::string error;
+};
+
+std::vector<BenchmarkDefinition>& get_registered_benchmarks()
+{
+    static std::vector<BenchmarkDefinition> benchmarks{};
+    return benchmarks;
+}
+
+/// @brief Get the value of a "--name=value" argument.
+/// @return The value, or nullptr if the argument does not match the name.
+static char const* get_argument_value(char const* argument, char const* name)
+{
+    size_t const name_length = std::strlen(name);
+    if (std::strncmp(argument, name, name_length) != 0 || argument[name_length] != '=')
+    {
+        return nullptr;
+    }
+
+    return argument + name_length + 1;
+}
+
+/// @brief Run a benchmark, scaling the iteration count until the minimum time is reached.
+static BenchmarkResult run_benchmark(BenchmarkDefinition const& benchmark, std::string const& name, int64_t argument, double min_time_ns)
+{
+    uint64_t iteration_count = benchmark.fixed_iteration_count > 0 ? benchmark.fixed_iteration_count : 1;
+    while (true)
+    {
+        BenchmarkState state(argument, iteration_count);
+        benchmark.function(state);
+
+        // Iterations are scaled up by the missing time with some headroom, like Google Benchmark does
+        double const elapsed_ns = state.elapsed_ns();
+        bool const done = benchmark.fixed_iteration_count > 0
+            || !state.error().empty()
+            || elapsed_ns >= min_time_ns
+            || iteration_count >= MAX_ITERATION_COUNT;
+        if (done)
+        {
+            double const elapsed_seconds = elapsed_ns * 1e-9;
+            BenchmarkResult result{};
+            result.name = name;
+            result.iterations = iteration_count;
+            result.real_time_ns = elapsed_ns / static_cast<double>(iteration_count);
+            result.items_per_second = elapsed_seconds > 0.0 ? static_cast<double>(state.items_processed()) / elapsed_seconds : 0.0;
+            result.bytes_per_second = elapsed_seconds > 0.0 ? static_cast<double>(state.bytes_processed()) / elapsed_seconds : 0.0;
+            result.error = state.error();
+            return result;
+        }
+
+        double const multiplier = elapsed_ns > 0.0 ? std::min(10.0, std::max(1.4 * min_time_ns / elapsed_ns, 2.0)) : 10.0;
+        iteration_count = std::min(MAX_ITERATION_COUNT, static_cast<uint64_t>(std::ceil(static_cast<double>(iteration_count) * multiplier)));
+    }
+}
+
+/// @brief Write a string as a JSON string literal, escaping quotes & backslashes.
+static void write_json_string(std::ofstream& file, std::string const& str)
+{
+    file << '"';
+    for (char const c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            file << '\\';
+        }
+        file << c;
+    }
+    file << '"';
+}
+
+/// @brief Write benchmark results in the Google Benchmark JSON format.
+static bool write_json_results(char const* path, char const* executable, std::vector<BenchmarkResult> const& results)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    char date[64] = {};
+    std::time_t const now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    file << "{\n  \"context\": {\n";
+    file << "    \"date\": \"" << date << "\",\n";
+    file << "    \"executable\": ";
+    write_json_string(file, executable);
+    file << ",\n    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    file << "    \"library_build_type\": \"release\"\n";
+#else
+    file << "    \"library_build_type\": \"debug\"\n";
+#endif
+    file << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        BenchmarkResult const& result = results[i];
+        file << (i > 0 ? ",\n" : "\n") << "    {\n      \"name\": ";
+        write_json_string(file, result.name);
+        file << ",\n      \"run_name\": ";
+        write_json_string(file, result.name);
+        file << ",\n      \"run_type\": \"iteration\",\n";
+        if (!result.error.empty())
+        {
+            file << "      \"error_occurred\": true,\n      \"error_message\": ";
+            write_json_string(file, result.error);
+            file << ",\n";
+        }
+
+        // The harness only measures wall clock time, which is also reported as CPU time for tool compatibility
+        file << "      \"iterations\": " << result.iterations << ",\n";
+        file << "      \"real_time\": " << result.real_time_ns << ",\n";
+        file << "      \"cpu_time\": " << result.real_time_ns << ",\n";
+        file << "      \"time_unit\": \"ns\"";
+        if (result.items_per_second > 0.0)
+        {
+            file << ",\n      \"items_per_second\": " << result.items_per_second;
+        }
+        if (result.bytes_per_second > 0.0)
+        {
+            file << ",\n      \"bytes_per_second\": " << result.bytes_per_second;
+        }
+        file << "\n    }";
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+int main(int argc, char** argv)
+{
+    char const* filter = "";
+    char const* output_path = nullptr;
+    double min_time_seconds = 0.5;
+    bool list_only = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (char const* value = get_argument_value(argv[i], "--benchmark_filter"))
+        {
+            filter = value;
+        }
+        else if (char const* min_time = get_argument_value(argv[i], "--benchmark_min_time"))
+        {
+            min_time_seconds = std::atof(min_time);
+        }
+        else if (char const* path = get_argument_value(argv[i], "--benchmark_out"))
+        {
+            output_path = path;
+        }
+        else if (std::strcmp(argv[i], "--benchmark_list") == 0)
+        {
+            list_only = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<BenchmarkResult> results{};
+    bool failed = false;
+    for (auto const& benchmark : get_registered_benchmarks())
+    {
+        std::vector<int64_t> const arguments = benchmark.arguments.empty() ? std::vector<int64_t>{ 0 } : benchmark.arguments;
+        for (auto const& argument : arguments)
+        {
+            std::string const name = benchmark.arguments.empty() ? benchmark.name : std::string(benchmark.name) + "/" + std::to_string(argument);
+            if (name.find(filter) == std::string::npos)
+            {
+                continue;
+            }
+
+            if (list_only)
+            {
+                std::printf("%s\n", name.c_str());
+                continue;
+            }
+
+            BenchmarkResult const result = run_benchmark(benchmark, name, argument, min_time_seconds * 1e9);
+            if (!result.error.empty())
+            {
+                std::printf("%-48s ERROR: %s\n", result.name.c_str(), result.error.c_str());
+                failed = true;
+            }
+            else
+            {
+                std::printf("%-48s %14.1f ns %12llu iterations", result.name.c_str(), result.real_time_ns, static_cast<unsigned long long>(result.iterations));
+                if (result.items_per_second > 0.0)
+                {
+                    std::printf("  %.4g items/s", result.items_per_second);
+                }
+                if (result.bytes_per_second > 0.0)
+                {
+                    std::printf("  %.4g B/s", result.bytes_per_second);
+                }
+                std::printf("\n");
+            }
+            std::fflush(stdout);
+            results.push_back(result);
+        }
+    }
+
+    if (output_path != nullptr && !write_json_results(output_path, argv[0], results))
+    {
+        std::fprintf(stderr, "Failed to write benchmark results to %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -34,8 +34,13 @@ public:
     Application() = default;
     virtual ~Application() = default;
 
-    /// @brief Update the application state.
-    /// @param delta Time delta between frame updates.
+    /// @brief Update the simulation state by a fixed timestep, called zero or more times per frame before update.
+    /// @param timestep Fixed timestep in seconds.
+    virtual void fixed_update([[maybe_unused]] double timestep) {}
+
+    /// @brief Update the application state, called once per frame.
+    /// Simulation state may be interpolated using the interpolation alpha in the engine frame timings.
+    /// @param delta Time delta between frame updates in seconds.
     virtual void update(double delta) = 0;
 
     /// @brief Get the application name.
@@ -0,0 +1,22 @@
+#pragma once
+#ifndef BONSAI_RENDERER_CHECKED_CAST_HPP
+#define BONSAI_RENDERER_CHECKED_CAST_HPP
+
+#include "bonsai/core/assert.hpp"
+
+/// @brief Downcast a pointer to a derived type, the cast is only checked using RTTI in debug builds.
+/// Use this in hot paths where the derived type is guaranteed by construction, e.g. backend resources in backend commands.
+/// @tparam Derived Derived pointer type to cast to.
+/// @tparam Base Base type to cast from.
+/// @param base Pointer to cast, may be NULL.
+/// @return The downcast pointer.
+template<typename Derived, typename Base>
+inline Derived checked_cast(Base* base)
+{
+#ifndef NDEBUG
+    BONSAI_ASSERT((base == nullptr || dynamic_cast<Derived>(base) != nullptr) && "Checked cast to invalid derived type!");
+#endif //NDEBUG
+    return static_cast<Derived>(base);
+}
+
+#endif //BONSAI_RENDERER_CHECKED_CAST_HPP
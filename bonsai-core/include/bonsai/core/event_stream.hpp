@@ -0,0 +1,151 @@
+#pragma once
+#ifndef BONSAI_RENDERER_EVENT_STREAM_HPP
+#define BONSAI_RENDERER_EVENT_STREAM_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct MappedFileHandle;
+
+/// @brief Event stream file magic, "BEVS" in little endian.
+static constexpr uint32_t BONSAI_EVENT_STREAM_MAGIC = 0x5356'4542;
+
+/// @brief Event stream file format version, incremented on layout changes.
+static constexpr uint32_t BONSAI_EVENT_STREAM_VERSION = 1;
+
+/// @brief Default number of records in an event stream ring, 32 MiB of records.
+static constexpr uint64_t BONSAI_EVENT_STREAM_DEFAULT_CAPACITY = 1ULL << 20;
+
+/// @brief Structured event types, values are stored in event stream files & must not be reordered.
+enum EventType : uint32_t
+{
+    EventTypeFrameBegin = 0,            /// @brief data[0]: frame index.
+    EventTypeFrameEnd = 1,              /// @brief data[0]: frame index, data[1]: CPU frame time in nanoseconds.
+    EventTypePipelineCreated = 2,       /// @brief data[0]: pipeline type (0 graphics, 1 compute), data[1]: creation time in nanoseconds.
+    EventTypeAllocation = 3,            /// @brief data[0]: resource type (0 buffer, 1 texture), data[1]: allocation size in bytes.
+    EventTypeSwapchainRecreated = 4,    /// @brief data[0]: swap chain width, data[1]: swap chain height.
+    EventTypeCount,
+};
+
+/// @brief Event stream record, records are written into a fixed size ring following the file header.
+struct EventRecord
+{
+    uint64_t timestamp_ns;  /// @brief Time in nanoseconds since the stream was opened.
+    uint32_t type;          /// @brief Event type, an EventType value.
+    uint32_t thread_id;     /// @brief Event stream thread ID, threads are numbered in order of their first event.
+    uint64_t data[2];       /// @brief Event type specific payload.
+};
+
+/// @brief Event stream file header, followed by `capacity` event records.
+struct EventStreamHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t header_size;
+    uint64_t capacity;
+    uint64_t start_unix_ns;             /// @brief Wall clock time in nanoseconds since the Unix epoch at stream creation.
+    std::atomic<uint64_t> write_count;  /// @brief Total number of records written, records are stored at write_count % capacity.
+    uint64_t reserved[3];               /// @brief Pads the header to a cache line, so no record straddles two cache lines.
+};
+
+static_assert(sizeof(EventRecord) == 32, "Event records must stay compact");
+static_assert(sizeof(EventStreamHeader) == 64, "Event records must be cache line aligned after the header");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The event stream write counter must be lock free to be shared through a file");
+
+/// @brief Decoded event stream file properties.
+struct EventStreamInfo
+{
+    uint64_t capacity;
+    uint64_t start_unix_ns;
+    uint64_t write_count;   /// @brief Total number of records written, records older than the capacity were overwritten.
+};
+
+/// @brief The event stream records timestamped structured events into a memory mapped ring buffer file.
+/// Writing an event reserves a slot with a single atomic increment, so it is lock free & safe from any thread.
+/// The OS writes the mapping back to the file, so recorded events survive a crash of the process.
+class EventStream
+{
+public:
+    EventStream() = default;
+    ~EventStream();
+
+    EventStream(EventStream const&) = delete;
+    EventStream& operator=(EventStream const&) = delete;
+
+    /// @brief Access the engine event stream.
+    static EventStream* get();
+
+    /// @brief Create an event stream file & start recording events, replacing an existing file.
+    /// Must not be called concurrently with event writes.
+    /// @param path Event stream file path.
+    /// @param capacity Number of records in the ring, rounded up to a power of two. Older records are overwritten once the ring is full.
+    /// @return A boolean indicating success.
+    bool open(char const* path, uint64_t capacity = BONSAI_EVENT_STREAM_DEFAULT_CAPACITY);
+
+    /// @brief Stop recording & close the event stream file, must not be called concurrently with event writes.
+    void close();
+
+    /// @brief Check if the event stream is recording events.
+    [[nodiscard]]
+    bool is_open() const { return m_header != nullptr; }
+
+    /// @brief Write an event, does nothing if the event stream is not open.
+    /// @param type Event type.
+    /// @param data0 First event payload value.
+    /// @param data1 Second event payload value.
+    void write(EventType type, uint64_t data0 = 0, uint64_t data1 = 0)
+    {
+        if (m_header == nullptr)
+        {
+            return;
+        }
+
+        uint64_t const index = m_header->write_count.fetch_add(1, std::memory_order_relaxed);
+        EventRecord& record = m_records[index & m_capacity_mask];
+        record.timestamp_ns = now();
+        record.type = type;
+        record.thread_id = get_thread_id();
+        record.data[0] = data0;
+        record.data[1] = data1;
+    }
+
+    /// @brief Get the current event stream time.
+    /// @return The time in nanoseconds since the stream was opened.
+    [[nodiscard]]
+    uint64_t now() const;
+
+private:
+    /// @brief Get the event stream ID of the calling thread.
+    static uint32_t get_thread_id();
+
+private:
+    MappedFileHandle* m_file = nullptr;
+    EventStreamHeader* m_header = nullptr;
+    EventRecord* m_records = nullptr;
+    uint64_t m_capacity_mask = 0;
+    uint64_t m_epoch = 0;
+};
+
+/// @brief Read the records of an event stream file.
+/// Records that were being written when the process exited may be incomplete.
+/// @param path Event stream file path.
+/// @param info Output event stream properties.
+/// @param records Output records, ordered from oldest to newest.
+/// @return A boolean indicating success.
+bool read_event_stream(char const* path, EventStreamInfo& info, std::vector<EventRecord>& records);
+
+/// @brief Get the name of an event type.
+/// @param type Event type value.
+/// @return The event type name, or "Unknown" for values this version does not know.
+char const* get_event_type_name(uint32_t type);
+
+#if BONSAI_USE_EVENT_STREAM
+    #define BONSAI_ENGINE_EVENT(type, data0, data1)  EventStream::get()->write(type, data0, data1)
+#else
+    #define BONSAI_ENGINE_EVENT(type, data0, data1)
+#endif
+
+#endif //BONSAI_RENDERER_EVENT_STREAM_HPP
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef BONSAI_RENDERER_FRAME_CLOCK_HPP
+#define BONSAI_RENDERER_FRAME_CLOCK_HPP
+
+#include <cstdint>
+
+/// @brief Frame clock configuration.
+struct FrameClockConfig
+{
+    double fixed_timestep;      /// @brief Fixed update timestep in seconds.
+    uint32_t max_fixed_steps;   /// @brief Maximum fixed updates per frame, excess simulation time is dropped.
+    double max_frame_delta;     /// @brief Maximum frame delta in seconds, longer frames (e.g. breakpoints) are clamped.
+    double target_frame_rate;   /// @brief Frame rate cap in frames per second, zero disables the cap.
+};
+
+/// @brief Timings of the most recently completed frame.
+struct FrameTimings
+{
+    uint64_t frame_index;
+    double frame_delta;         /// @brief Wall time between the start of this frame & the previous frame in seconds.
+    double cpu_time_ms;         /// @brief CPU time spent in the frame, excluding frame cap waits.
+    double gpu_time_ms;         /// @brief GPU time of the most recently resolved frame, lags the CPU by a few frames.
+    uint32_t fixed_step_count;  /// @brief Number of fixed updates run this frame.
+    double interpolation_alpha; /// @brief Fraction of a fixed timestep left in the accumulator, in [0, 1).
+};
+
+/// @brief The frame clock measures frame time, drives fixed timestep updates & paces frames to a frame rate cap.
+class FrameClock
+{
+public:
+    explicit FrameClock(FrameClockConfig const& config);
+    ~FrameClock() = default;
+
+    FrameClock(FrameClock const&) = delete;
+    FrameClock& operator=(FrameClock const&) = delete;
+
+    /// @brief Replace the clock configuration, the simulation accumulator is kept.
+    /// @param config New clock configuration.
+    void set_config(FrameClockConfig const& config);
+
+    /// @brief Get the clock configuration.
+    [[nodiscard]]
+    FrameClockConfig const& get_config() const { return m_config; }
+
+    /// @brief Start a new frame, measuring the frame delta & advancing the simulation accumulator.
+    void begin_frame();
+
+    /// @brief Advance the simulation accumulator by a frame delta.
+    /// @param delta Frame delta in seconds, clamped to the maximum frame delta.
+    void advance(double delta);
+
+    /// @brief Consume a fixed timestep from the simulation accumulator, call in a loop to run all fixed updates.
+    /// @return True if a fixed update should run, false if the accumulator holds less than a timestep.
+    bool consume_fixed_step();
+
+    /// @brief End the current frame, recording its timings & waiting for the frame rate cap.
+    /// Waits sleep until shortly before the deadline & spin for the remainder, since sleeps tend to overshoot.
+    /// @param gpu_time_ms GPU time of the most recently resolved frame.
+    void end_frame(double gpu_time_ms);
+
+    /// @brief Get the timings of the most recent frame.
+    [[nodiscard]]
+    FrameTimings const& get_timings() const { return m_timings; }
+
+private:
+    /// @brief Wait until a clock time using sleep & spin.
+    /// @param deadline_ns Deadline in steady clock nanoseconds.
+    static void wait_until(uint64_t deadline_ns);
+
+private:
+    FrameClockConfig m_config = {};
+    FrameTimings m_timings = {};
+    double m_accumulator = 0.0;
+    uint64_t m_frame_start_ns = 0;
+    uint64_t m_next_deadline_ns = 0;
+};
+
+#endif //BONSAI_RENDERER_FRAME_CLOCK_HPP
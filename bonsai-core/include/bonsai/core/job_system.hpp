@@ -0,0 +1,157 @@
+#pragma once
+#ifndef BONSAI_RENDERER_JOB_SYSTEM_HPP
+#define BONSAI_RENDERER_JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+typedef std::function<void()> JobFunction;
+typedef std::function<void(size_t begin, size_t end)> JobRangeFunction;
+
+/// @brief Job counter, counts the unfinished jobs that signal it. Jobs may depend on a counter reaching zero.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    ~JobCounter() = default;
+
+    JobCounter(JobCounter const&) = delete;
+    JobCounter& operator=(JobCounter const&) = delete;
+
+    /// @brief Check if all jobs signalling this counter have finished.
+    [[nodiscard]]
+    bool is_done() const { return m_value.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> m_value{ 0 };
+};
+
+/// @brief The job system runs jobs on a pool of worker threads, each with its own job deque.
+/// Workers pop their own jobs newest first & steal jobs from other workers oldest first when they run out.
+/// Main thread jobs are only run by the main thread, for APIs such as SDL that must be called from the main thread.
+class JobSystem
+{
+public:
+    /// @brief Create a new job system.
+    /// @param worker_count Number of worker threads, zero uses one worker per hardware thread besides the main thread.
+    explicit JobSystem(uint32_t worker_count);
+    ~JobSystem();
+
+    JobSystem(JobSystem const&) = delete;
+    JobSystem& operator=(JobSystem const&) = delete;
+
+    /// @brief Submit a job to the worker threads.
+    /// @param function Job function.
+    /// @param signal Optional counter, incremented on submission & decremented once the job has finished.
+    /// @param dependency Optional counter that must reach zero before the job runs, the job is parked until then.
+    void submit(JobFunction function, JobCounter* signal = nullptr, JobCounter* dependency = nullptr);
+
+    /// @brief Submit a job that runs on the main thread, either in @ref JobSystem::run_main_thread_jobs or while
+    /// the main thread waits on a counter.
+    /// @param function Job function.
+    /// @param signal Optional counter, incremented on submission & decremented once the job has finished.
+    void submit_main_thread(JobFunction function, JobCounter* signal = nullptr);
+
+    /// @brief Run a function over a range in batches on the worker threads, the calling thread helps until all batches finish.
+    /// @param count Number of elements in the range.
+    /// @param batch_size Number of elements per batch.
+    /// @param function Range function, called with the [begin, end) element range of each batch.
+    void parallel_for(size_t count, size_t batch_size, JobRangeFunction const& function);
+
+    /// @brief Wait for a counter to reach zero, running queued jobs on the calling thread while waiting & sleeping
+    /// when there are none.
+    /// @param counter Counter to wait on.
+    void wait(JobCounter& counter);
+
+    /// @brief Run all queued main thread jobs, must be called from the main thread.
+    void run_main_thread_jobs();
+
+    /// @brief Check if the calling thread is the main thread, i.e. the thread that created the job system.
+    [[nodiscard]]
+    bool is_main_thread() const { return std::this_thread::get_id() == m_main_thread_id; }
+
+    /// @brief Get the number of worker threads.
+    [[nodiscard]]
+    uint32_t worker_count() const { return static_cast<uint32_t>(m_workers.size()); }
+
+private:
+    /// @brief Queued job.
+    struct Job
+    {
+        JobFunction function;
+        JobCounter* signal;
+        JobCounter* dependency;
+    };
+
+    /// @brief Worker job deque, the owning worker uses the back & thieves use the front.
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    /// @brief Worker thread loop.
+    /// @param worker_index Index of the worker.
+    void worker_main(uint32_t worker_index);
+
+    /// @brief Push a job onto a worker queue & wake a sleeping worker.
+    /// @param job Job to push.
+    void push_job(Job&& job);
+
+    /// @brief Pop a job from the own queue, or steal one from another worker.
+    /// @param worker_index Index of the calling worker, or UINT32_MAX for non-worker threads.
+    /// @param job Output job.
+    /// @return A boolean indicating a job was found.
+    bool pop_job(uint32_t worker_index, Job& job);
+
+    /// @brief Pop a main thread job.
+    /// @param job Output job.
+    /// @return A boolean indicating a job was found.
+    bool pop_main_thread_job(Job& job);
+
+    /// @brief Check if there are queued main thread jobs.
+    /// @return A boolean indicating main thread jobs are queued.
+    bool has_main_thread_jobs();
+
+    /// @brief Park a job until its dependency reaches zero.
+    /// @param job Job to park, left untouched if its dependency has already finished.
+    /// @return A boolean indicating the job was parked.
+    bool park_job(Job& job);
+
+    /// @brief Requeue the parked jobs that depend on a counter that has just reached zero.
+    /// @param counter Finished counter.
+    void release_parked_jobs(JobCounter* counter);
+
+    /// @brief Run a job & signal its counter, or park it if its dependency has not finished yet.
+    /// Jobs never wait on their dependency, a waiting job would hold its worker's stack & can deadlock dependency chains.
+    /// @param job Job to run.
+    void run_job(Job& job);
+
+private:
+    std::thread::id m_main_thread_id;
+    std::vector<std::thread> m_workers = {};
+    std::vector<WorkerQueue*> m_queues = {};
+    std::atomic<uint32_t> m_next_queue{ 0 };
+    std::atomic<uint32_t> m_queued_job_count{ 0 };
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake_condition;
+    std::condition_variable m_wait_condition;
+    uint32_t m_sleeping_wait_count = 0;
+    bool m_stop = false;
+    std::mutex m_main_thread_mutex;
+    std::deque<Job> m_main_thread_jobs = {};
+    std::mutex m_parked_mutex;
+    std::vector<Job> m_parked_jobs = {};
+};
+
+#endif //BONSAI_RENDERER_JOB_SYSTEM_HPP
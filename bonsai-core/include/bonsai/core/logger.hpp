@@ -2,8 +2,16 @@
 #ifndef BONSAI_RENDERER_LOGGER_HPP
 #define BONSAI_RENDERER_LOGGER_HPP
 
+#include <cstddef>
 #include <spdlog/spdlog.h>
 
+namespace spdlog::details { class thread_pool; }
+
+/// @brief Compile time minimum log level, log macros below this level compile to nothing & do not evaluate their arguments.
+#ifndef BONSAI_ACTIVE_LOG_LEVEL
+    #define BONSAI_ACTIVE_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
 /// @brief Available levels for logging.
 enum class LogLevel
 {
@@ -16,6 +24,30 @@ enum class LogLevel
     Off         = SPDLOG_LEVEL_OFF,
 };
 
+/// @brief Logging modes.
+enum class LogMode
+{
+    Sync,   /// @brief Messages are written on the logging thread.
+    Async,  /// @brief Messages are queued & written on a background thread.
+};
+
+/// @brief Asynchronous logging queue overflow policies.
+enum class LogOverflowPolicy
+{
+    Block,      /// @brief Block the logging thread until the queue has space.
+    Drop,       /// @brief Drop the new message.
+    Overwrite,  /// @brief Overwrite the oldest queued message.
+};
+
+/// @brief Logger configuration.
+struct LoggerConfig
+{
+    LogLevel min_level;
+    LogMode mode;
+    size_t async_queue_size;            /// @brief Number of preallocated queue slots in asynchronous mode.
+    LogOverflowPolicy overflow_policy;  /// @brief Queue overflow policy in asynchronous mode.
+};
+
 /// @brief Logger singleton for easily accessible logging through spdlog.
 class Logger
 {
@@ -30,6 +62,14 @@ public:
     /// @brief Access the logger singleton.
     static Logger* get();
 
+    /// @brief Reconfigure the logger. Messages queued by an asynchronous logger are written before switching mode.
+    /// Must not be called while other threads are logging.
+    /// @param config Logger configuration.
+    void configure(LoggerConfig const& config);
+
+    /// @brief Write all queued messages & switch to synchronous logging, e.g. before shutting down.
+    void shutdown();
+
     /// @brief Set the minimum log level to report.
     /// @param level Minimum log level to report.
     void set_min_log_level(LogLevel level);
@@ -53,13 +93,46 @@ public:
     void critical(Args&&... args) { m_logger->critical(std::forward<Args>(args)...); }
 private:
     std::shared_ptr<spdlog::logger> m_logger;
+    std::shared_ptr<spdlog::details::thread_pool> m_thread_pool;
 };
 
-#define BONSAI_ENGINE_LOG_TRACE(...)       (Logger::get()->trace(__VA_ARGS__))
-#define BONSAI_ENGINE_LOG_DEBUG(...)       (Logger::get()->debug(__VA_ARGS__))
-#define BONSAI_ENGINE_LOG_INFO(...)        (Logger::get()->info(__VA_ARGS__))
-#define BONSAI_ENGINE_LOG_WARN(...)        (Logger::get()->warn(__VA_ARGS__))
-#define BONSAI_ENGINE_LOG_ERROR(...)       (Logger::get()->error(__VA_ARGS__))
-#define BONSAI_ENGINE_LOG_CRITICAL(...)    (Logger::get()->critical(__VA_ARGS__))
+/// @brief Strip a log statement below the compile time minimum log level.
+#define BONSAI_LOG_STRIPPED(...)    ((void)0)
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+    #define BONSAI_ENGINE_LOG_TRACE(...)       (Logger::get()->trace(__VA_ARGS__))
+#else
+    #define BONSAI_ENGINE_LOG_TRACE(...)       BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+    #define BONSAI_ENGINE_LOG_DEBUG(...)       (Logger::get()->debug(__VA_ARGS__))
+#else
+    #define BONSAI_ENGINE_LOG_DEBUG(...)       BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+    #define BONSAI_ENGINE_LOG_INFO(...)        (Logger::get()->info(__VA_ARGS__))
+#else
+    #define BONSAI_ENGINE_LOG_INFO(...)        BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+    #define BONSAI_ENGINE_LOG_WARN(...)        (Logger::get()->warn(__VA_ARGS__))
+#else
+    #define BONSAI_ENGINE_LOG_WARN(...)        BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_ERROR
+    #define BONSAI_ENGINE_LOG_ERROR(...)       (Logger::get()->error(__VA_ARGS__))
+#else
+    #define BONSAI_ENGINE_LOG_ERROR(...)       BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_CRITICAL
+    #define BONSAI_ENGINE_LOG_CRITICAL(...)    (Logger::get()->critical(__VA_ARGS__))
+#else
+    #define BONSAI_ENGINE_LOG_CRITICAL(...)    BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
 
 #endif //BONSAI_RENDERER_LOGGER_HPP
\ No newline at end of file
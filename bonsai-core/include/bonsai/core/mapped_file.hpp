@@ -0,0 +1,36 @@
+#pragma once
+#ifndef BONSAI_RENDERER_MAPPED_FILE_HPP
+#define BONSAI_RENDERER_MAPPED_FILE_HPP
+
+#include <cstddef>
+
+/// @brief Memory mapped file handle as created by the OS specific file mapping.
+struct MappedFileHandle;
+
+/// @brief Create or truncate a file & map it into memory for reading & writing.
+/// Writes to the mapping are written back to the file by the OS, also if the process exits unexpectedly.
+/// @param path File path.
+/// @param size File size in bytes.
+/// @return A new MappedFileHandle object, nullptr on failure.
+MappedFileHandle* bonsai_create_mapped_file(char const* path, size_t size);
+
+/// @brief Open an existing file & map it into memory for reading.
+/// @param path File path.
+/// @return A new MappedFileHandle object, nullptr on failure.
+MappedFileHandle* bonsai_open_mapped_file(char const* path);
+
+/// @brief Unmap & close a memory mapped file.
+/// @param handle Mapped file handle to close.
+void bonsai_close_mapped_file(MappedFileHandle* handle);
+
+/// @brief Get the mapped file contents.
+/// @param handle Mapped file handle.
+/// @return A pointer to the mapped file contents.
+void* bonsai_get_mapped_data(MappedFileHandle const* handle);
+
+/// @brief Get the mapped file size.
+/// @param handle Mapped file handle.
+/// @return The mapped file size in bytes.
+size_t bonsai_get_mapped_size(MappedFileHandle const* handle);
+
+#endif //BONSAI_RENDERER_MAPPED_FILE_HPP
@@ -17,6 +17,7 @@ struct PlatformSurfaceConfig
 {
     bool resizable;
     bool high_dpi;
+    bool hidden;    /// @brief Create the surface without showing it, e.g. for offscreen benchmarks.
 };
 
 /// @brief Opaque platform surface handle.
@@ -0,0 +1,170 @@
+#pragma once
+#ifndef BONSAI_RENDERER_PROFILER_HPP
+#define BONSAI_RENDERER_PROFILER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/// @brief Number of zones each thread can record between flushes, zones beyond this limit are dropped.
+static constexpr size_t BONSAI_PROFILER_THREAD_ZONE_CAPACITY = 16384;
+
+/// @brief Maximum number of ring buffers of exited threads kept for reuse by new threads, further buffers are freed.
+static constexpr size_t BONSAI_PROFILER_MAX_FREE_THREAD_BUFFERS = 8;
+
+/// @brief Maximum length of a profiler thread name, including the null terminator.
+static constexpr size_t BONSAI_PROFILER_MAX_THREAD_NAME_LENGTH = 32;
+
+/// @brief Completed CPU profile zone.
+struct ProfileZone
+{
+    char const* name;   /// @brief Zone name, must be a string with static lifetime.
+    uint64_t start_ns;  /// @brief Start time in nanoseconds since profiler creation.
+    uint64_t end_ns;    /// @brief End time in nanoseconds since profiler creation.
+    uint32_t thread_id; /// @brief Profiler thread ID, threads are numbered in registration order.
+};
+
+/// @brief The CPU profiler records scoped zones into per thread ring buffers.
+/// Recording a zone is lock free, the ring buffers are drained by @ref Profiler::flush on a single thread.
+class Profiler
+{
+public:
+    Profiler();
+    ~Profiler();
+
+    Profiler(Profiler const&) = delete;
+    Profiler& operator=(Profiler const&) = delete;
+
+    /// @brief Access the engine profiler.
+    static Profiler* get();
+
+    /// @brief Get the current profiler time.
+    /// @return The time in nanoseconds since profiler creation.
+    [[nodiscard]]
+    uint64_t now() const;
+
+    /// @brief Record a completed zone for the calling thread.
+    /// @param name Zone name, must be a string with static lifetime.
+    /// @param start_ns Zone start time.
+    /// @param end_ns Zone end time.
+    void record_zone(char const* name, uint64_t start_ns, uint64_t end_ns);
+
+    /// @brief Set the name of the calling thread, shown in exported traces.
+    /// @param name Thread name, truncated to BONSAI_PROFILER_MAX_THREAD_NAME_LENGTH.
+    void set_thread_name(char const* name);
+
+    /// @brief Start or stop capturing flushed zones, zones flushed while not capturing are discarded.
+    /// @param capturing Set to capture zones.
+    void set_capturing(bool capturing);
+
+    /// @brief Check if flushed zones are captured.
+    [[nodiscard]]
+    bool is_capturing() const { return m_capturing; }
+
+    /// @brief Drain the thread ring buffers, appending their zones to the capture if capturing.
+    /// Must not be called concurrently with itself or trace export.
+    void flush();
+
+    /// @brief Write the captured zones as a Chrome trace JSON file, which can also be opened in Perfetto.
+    /// @param path Output file path.
+    /// @return A boolean indicating success.
+    bool write_chrome_trace(char const* path) const;
+
+    /// @brief Remove all captured zones.
+    void clear_capture();
+
+    /// @brief Get the captured zones.
+    [[nodiscard]]
+    std::vector<ProfileZone> const& get_captured_zones() const { return m_captured_zones; }
+
+    /// @brief Get the number of zones dropped because a thread ring buffer was full.
+    [[nodiscard]]
+    uint64_t get_dropped_zone_count() const;
+
+    /// @brief Get the number of allocated thread ring buffers, including buffers of exited threads kept for reuse.
+    [[nodiscard]]
+    size_t get_thread_buffer_count() const;
+
+private:
+    /// @brief Single producer, single consumer zone ring buffer owned by a recording thread.
+    struct ThreadBuffer
+    {
+        uint32_t thread_id;
+        char name[BONSAI_PROFILER_MAX_THREAD_NAME_LENGTH];
+        ProfileZone zones[BONSAI_PROFILER_THREAD_ZONE_CAPACITY];
+        std::atomic<uint64_t> write_index;
+        std::atomic<uint64_t> read_index;
+        std::atomic<uint64_t> dropped_count;
+        std::atomic<uint32_t> reference_count;  /// @brief Held by the profiler & the recording thread, a buffer with one reference is retired.
+    };
+
+    /// @brief Thread local owner of the calling thread's ring buffer, releases the buffer when the thread exits.
+    struct ThreadBufferOwner
+    {
+        ThreadBufferOwner() = default;
+        ~ThreadBufferOwner();
+
+        ThreadBuffer* buffer = nullptr;
+        uint64_t profiler_id = 0;
+    };
+
+    /// @brief Get or register the ring buffer of the calling thread.
+    ThreadBuffer* get_thread_buffer();
+
+    /// @brief Release a reference to a ring buffer, the buffer is deleted once both references are released.
+    static void release_thread_buffer(ThreadBuffer* buffer);
+
+private:
+    /// @brief Ring buffer owner of the calling thread, threads own the buffer of one profiler at a time.
+    static thread_local ThreadBufferOwner t_thread_buffer_owner;
+
+    uint64_t m_id = 0;
+    uint64_t m_epoch = 0;
+    std::atomic<bool> m_capturing{ false };
+    mutable std::mutex m_threads_mutex;
+    uint32_t m_next_thread_id = 0;
+    uint64_t m_retired_dropped_count = 0;
+    std::vector<ThreadBuffer*> m_thread_buffers = {};
+    std::vector<ThreadBuffer*> m_free_thread_buffers = {};
+    std::vector<ProfileZone> m_captured_zones = {};
+};
+
+/// @brief RAII profile zone, records a zone from construction until destruction.
+class ProfileScope
+{
+public:
+    ProfileScope(Profiler* profiler, char const* name)
+        :
+        m_profiler(profiler),
+        m_name(name),
+        m_start_ns(profiler->now())
+    {
+        //
+    }
+
+    ~ProfileScope()
+    {
+        m_profiler->record_zone(m_name, m_start_ns, m_profiler->now());
+    }
+
+    ProfileScope(ProfileScope const&) = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+private:
+    Profiler* m_profiler;
+    char const* m_name;
+    uint64_t m_start_ns;
+};
+
+#define BONSAI_PROFILE_CONCAT_IMPL(a, b)    a##b
+#define BONSAI_PROFILE_CONCAT(a, b)         BONSAI_PROFILE_CONCAT_IMPL(a, b)
+
+#if BONSAI_USE_PROFILER
+    #define BONSAI_ENGINE_PROFILE_SCOPE(name)   ProfileScope BONSAI_PROFILE_CONCAT(bonsai_profile_scope_, __LINE__)(Profiler::get(), name)
+#else
+    #define BONSAI_ENGINE_PROFILE_SCOPE(name)
+#endif
+
+#endif //BONSAI_RENDERER_PROFILER_HPP
@@ -3,7 +3,10 @@
 #define BONSAI_RENDERER_ENGINE_API_HPP
 
 #include <imgui.h>
+#include "core/frame_clock.hpp"
+#include "core/job_system.hpp"
 #include "core/logger.hpp"
+#include "core/profiler.hpp"
 #include "core/platform.hpp"
 
 /// @brief The Engine API class contains engine services. The interface ensures it may be shared across dynamic library
@@ -28,12 +31,24 @@ public:
 
     void register_loggger(Logger* logger) { m_logger = logger; }
 
+    void register_profiler(Profiler* profiler) { m_profiler = profiler; }
+
+    void register_frame_clock(FrameClock* frame_clock) { m_frame_clock = frame_clock; }
+
+    void register_job_system(JobSystem* job_system) { m_job_system = job_system; }
+
     void register_imgui_context(ImGuiContext* context) { m_context = context; }
 
     void register_platform(Platform* platform) { m_platform = platform; }
 
     Logger* get_logger() { return m_logger; }
 
+    Profiler* get_profiler() { return m_profiler; }
+
+    FrameClock* get_frame_clock() { return m_frame_clock; }
+
+    JobSystem* get_job_system() { return m_job_system; }
+
     ImGuiContext* get_imgui_context() { return m_context; }
 
     Platform* get_platform() { return m_platform; }
@@ -43,15 +58,53 @@ private:
     static EngineAPI* s_instance;
 
     Logger* m_logger = nullptr;
+    Profiler* m_profiler = nullptr;
+    FrameClock* m_frame_clock = nullptr;
+    JobSystem* m_job_system = nullptr;
     ImGuiContext* m_context = nullptr;
     Platform* m_platform = nullptr;
 };
 
-#define BONSAI_LOG_TRACE(...)       (EngineAPI::get()->get_logger()->trace(__VA_ARGS__))
-#define BONSAI_LOG_DEBUG(...)       (EngineAPI::get()->get_logger()->debug(__VA_ARGS__))
-#define BONSAI_LOG_INFO(...)        (EngineAPI::get()->get_logger()->info(__VA_ARGS__))
-#define BONSAI_LOG_WARN(...)        (EngineAPI::get()->get_logger()->warn(__VA_ARGS__))
-#define BONSAI_LOG_ERROR(...)       (EngineAPI::get()->get_logger()->error(__VA_ARGS__))
-#define BONSAI_LOG_CRITICAL(...)    (EngineAPI::get()->get_logger()->critical(__VA_ARGS__))
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+    #define BONSAI_LOG_TRACE(...)       (EngineAPI::get()->get_logger()->trace(__VA_ARGS__))
+#else
+    #define BONSAI_LOG_TRACE(...)       BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+    #define BONSAI_LOG_DEBUG(...)       (EngineAPI::get()->get_logger()->debug(__VA_ARGS__))
+#else
+    #define BONSAI_LOG_DEBUG(...)       BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+    #define BONSAI_LOG_INFO(...)        (EngineAPI::get()->get_logger()->info(__VA_ARGS__))
+#else
+    #define BONSAI_LOG_INFO(...)        BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+    #define BONSAI_LOG_WARN(...)        (EngineAPI::get()->get_logger()->warn(__VA_ARGS__))
+#else
+    #define BONSAI_LOG_WARN(...)        BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_ERROR
+    #define BONSAI_LOG_ERROR(...)       (EngineAPI::get()->get_logger()->error(__VA_ARGS__))
+#else
+    #define BONSAI_LOG_ERROR(...)       BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_CRITICAL
+    #define BONSAI_LOG_CRITICAL(...)    (EngineAPI::get()->get_logger()->critical(__VA_ARGS__))
+#else
+    #define BONSAI_LOG_CRITICAL(...)    BONSAI_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if BONSAI_USE_PROFILER
+    #define BONSAI_PROFILE_SCOPE(name)  ProfileScope BONSAI_PROFILE_CONCAT(bonsai_profile_scope_, __LINE__)(EngineAPI::get()->get_profiler(), name)
+#else
+    #define BONSAI_PROFILE_SCOPE(name)
+#endif
 
 #endif //BONSAI_RENDERER_ENGINE_API_HPP
\ No newline at end of file
@@ -4,11 +4,16 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <string>
+#include <vector>
 #include <imgui.h>
 #include "bonsai/core/platform.hpp"
 
 static constexpr uint32_t BONSAI_MAX_COLOR_ATTACHMENT_COUNT = 8;
+static constexpr uint32_t BONSAI_MAX_VERTEX_BUFFER_BINDINGS = 16;
+static constexpr uint32_t BONSAI_MAX_VIEWPORT_COUNT = 16;
 
+class JobSystem;
 class RenderBuffer;
 class RenderTexture;
 
@@ -144,6 +149,22 @@ enum RenderStoreOp : uint32_t
     RenderStoreOpDontCare   = 1,
 };
 
+/// @brief Render resource states, describing how a texture or buffer is accessed by subsequent commands.
+enum RenderResourceState : uint32_t
+{
+    RenderResourceStateUndefined            = 0,    /// @brief Resource contents are undefined, only valid as a previous state.
+    RenderResourceStateColorTarget          = 1,    /// @brief Texture is read and written as a color render target.
+    RenderResourceStateDepthStencilTarget   = 2,    /// @brief Texture is read and written as a depth stencil target.
+    RenderResourceStateShaderRead           = 3,    /// @brief Resource is read by shaders.
+    RenderResourceStateShaderReadWrite      = 4,    /// @brief Resource is read and written by shaders as a storage resource.
+    RenderResourceStateVertexBuffer         = 5,    /// @brief Buffer is read as a vertex buffer.
+    RenderResourceStateIndexBuffer          = 6,    /// @brief Buffer is read as an index buffer.
+    RenderResourceStateIndirectArgument     = 7,    /// @brief Buffer is read as indirect draw or dispatch arguments.
+    RenderResourceStateTransferSrc          = 8,    /// @brief Resource is read by transfer commands.
+    RenderResourceStateTransferDst          = 9,    /// @brief Resource is written by transfer commands.
+    RenderResourceStatePresent              = 10,   /// @brief Texture is ready for presentation.
+};
+
 /// @brief Index type for index buffers.
 enum IndexType : uint32_t
 {
@@ -389,13 +410,31 @@ enum ColorComponent : uint32_t
 };
 typedef uint32_t ColorComponentFlags;
 
+/// @brief Shader preprocessor define, equivalent to a `#define name value` line before the shader source.
+struct ShaderDefine
+{
+    char const* name;   /// @brief Define name.
+    char const* value;  /// @brief Define value, nullptr defines the name as 1.
+};
+
 /// @brief A shader source contains a shader file that can be compiled by the render backend.
 /// All backends support HLSL as shader language.
+/// The defines form the permutation key of the shader, backends compile & cache each unique permutation once.
 struct ShaderSource
 {
     ShaderSourceKind source_kind;   /// @brief Shader source type stored in this structure.
     char const* entrypoint;         /// @brief Shader entrypoint function.
     char const* shader_source;      /// @brief Shader source file path or code.
+    ShaderDefine const* defines;    /// @brief Permutation defines, may be nullptr if define_count is zero.
+    uint32_t define_count;          /// @brief Number of permutation defines.
+};
+
+/// @brief Specialization constant value, applied at pipeline creation to the shader constant with a matching name.
+/// In HLSL specialization constants are declared as `[[vk::constant_id(N)]] const uint NAME = default;`.
+struct SpecializationConstant
+{
+    char const* name;   /// @brief Specialization constant name as declared in the shader.
+    uint32_t value;     /// @brief 32-bit constant value, bool, int & float constants store their bit pattern.
 };
 
 struct VertexAttributeDescription
@@ -500,12 +539,38 @@ struct GraphicsPipelineDescriptor
     uint32_t color_attachment_count;
     RenderFormat color_attachment_formats[BONSAI_MAX_COLOR_ATTACHMENT_COUNT];
     RenderFormat depth_stencil_attachment_format;
+    uint32_t view_mask;     /// @brief Multiview mask of the render passes the pipeline is used in, zero disables multiview.
+    SpecializationConstant const* specialization_constants; /// @brief Specialization constants, applied to each stage declaring them.
+    uint32_t specialization_constant_count;                 /// @brief Number of specialization constants.
 };
 
 /// @brief The compute pipeline descriptor is used for creating compute shader pipelines.
 struct ComputePipelineDescriptor
 {
     ShaderSource compute_shader;
+    SpecializationConstant const* specialization_constants; /// @brief Specialization constants, may be nullptr if the count is zero.
+    uint32_t specialization_constant_count;                 /// @brief Number of specialization constants.
+};
+
+/// @brief Backend memory requirements for placing a resource in a memory heap.
+struct RenderMemoryRequirements
+{
+    size_t size;                /// @brief Required memory size in bytes.
+    size_t alignment;           /// @brief Required offset alignment in bytes.
+    uint32_t memory_type_bits;  /// @brief Backend specific memory types the resource can be placed in.
+};
+
+/// @brief The RenderMemoryHeap represents a block of device memory that resources can be placed in.
+/// Multiple resources can alias the same memory as long as they are not used at the same time.
+class RenderMemoryHeap
+{
+public:
+    virtual ~RenderMemoryHeap() = default;
+
+    /// @brief Get the heap size in bytes.
+    /// @return The heap size in bytes.
+    [[nodiscard]]
+    virtual size_t size() const = 0;
 };
 
 /// @brief The RenderBuffer represents a backend buffer type that can store data.
@@ -545,6 +610,16 @@ public:
     /// @return The texture extent.
     [[nodiscard]]
     virtual RenderExtent3D extent() const = 0;
+
+    /// @brief Get the number of mip levels in the texture.
+    /// @return The texture mip level count.
+    [[nodiscard]]
+    virtual uint32_t mip_levels() const = 0;
+
+    /// @brief Get the number of array layers in the texture, 3D textures always have a single layer.
+    /// @return The texture array layer count.
+    [[nodiscard]]
+    virtual uint32_t array_layers() const = 0;
 };
 
 /// @brief The ShaderPipeline represents a backend shader pipeline that can be used for rendering.
@@ -588,6 +663,45 @@ private:
     WorkgroupSize m_workgroup_size = { 0, 0, 0 };
 };
 
+/// @brief Pipeline statistics gathered for a GPU profile scope.
+struct RenderPipelineStatistics
+{
+    uint64_t vertex_shader_invocations;
+    uint64_t clipping_invocations;          /// @brief Number of primitives processed by the clipping stage.
+    uint64_t clipping_primitives;           /// @brief Number of primitives output by the clipping stage.
+    uint64_t fragment_shader_invocations;
+    uint64_t compute_shader_invocations;
+};
+
+/// @brief Resolved GPU profile scope timing.
+struct RenderProfileScope
+{
+    std::string name;
+    uint32_t parent;                                /// @brief Index of the enclosing scope, UINT32_MAX for top level scopes.
+    uint32_t depth;                                 /// @brief Scope nesting depth, zero for top level scopes.
+    double start_ms;                                /// @brief Scope start relative to the first scope in the frame, in milliseconds.
+    double duration_ms;                             /// @brief Scope GPU duration in milliseconds, zero if the scope was not closed.
+    bool has_pipeline_statistics;                   /// @brief Set if pipeline statistics were gathered for the scope.
+    RenderPipelineStatistics pipeline_statistics;
+};
+
+/// @brief Resolved GPU profile for a single frame, scopes are stored in begin order so children follow their parent.
+struct RenderGpuProfile
+{
+    uint64_t frame_index;
+    std::vector<RenderProfileScope> scopes;
+};
+
+/// @brief Statistics gathered while recording render commands, reset when command recording begins.
+struct RenderCommandStatistics
+{
+    uint32_t pipeline_barriers;     /// @brief Number of recorded pipeline barrier commands, each may contain multiple barriers.
+    uint32_t image_barriers;        /// @brief Number of emitted image barriers.
+    uint32_t memory_barriers;       /// @brief Number of emitted global memory barriers.
+    uint32_t skipped_transitions;   /// @brief Number of resource transitions that did not require a barrier.
+    uint32_t skipped_state_changes; /// @brief Number of pipeline, dynamic state & buffer binds dropped because the state was already bound.
+};
+
 /// @brief The RenderCommands class is used for recording render backend commands.
 class RenderCommands
 {
@@ -608,20 +722,88 @@ public:
     /// @param texture A swap texture to mark for presentation.
     virtual void mark_for_present(RenderTexture* texture) = 0;
 
+    /// @brief Transition a texture to a new resource state, waiting on all previous accesses to the texture.
+    /// Transitions may not be recorded inside a render pass.
+    /// @param texture Texture to transition.
+    /// @param state Next resource state.
+    /// @param discard Discard the previous texture contents.
+    virtual void transition_texture(RenderTexture* texture, RenderResourceState state, bool discard) = 0;
+
+    /// @brief Transition a buffer to a new resource state, waiting on all previous accesses to the buffer.
+    /// Transitions may not be recorded inside a render pass.
+    /// @param buffer Buffer to transition.
+    /// @param state Next resource state.
+    virtual void transition_buffer(RenderBuffer* buffer, RenderResourceState state) = 0;
+
+    /// @brief Hand over aliased memory to a texture, the next transition of the texture waits on the previous users of the memory.
+    /// The texture contents are undefined after the hand over.
+    /// @param texture Texture that starts using aliased memory.
+    /// @param previous_states Last resource states of the previous resources placed in the same memory.
+    /// @param previous_state_count Number of previous resource states.
+    virtual void alias_texture(RenderTexture* texture, RenderResourceState const* previous_states, size_t previous_state_count) = 0;
+
+    /// @brief Hand over aliased memory to a buffer, the next transition of the buffer waits on the previous users of the memory.
+    /// The buffer contents are undefined after the hand over.
+    /// @param buffer Buffer that starts using aliased memory.
+    /// @param previous_states Last resource states of the previous resources placed in the same memory.
+    /// @param previous_state_count Number of previous resource states.
+    virtual void alias_buffer(RenderBuffer* buffer, RenderResourceState const* previous_states, size_t previous_state_count) = 0;
+
     /// @brief Start a new render pass.
     /// @param render_area Target area for render operations.
     /// @param color_targets Render pass color targets.
     /// @param color_target_count Number of color targets.
     /// @param depth_target Render pass depth target.
     /// @param stencil_target Render pass stencil target.
+    /// @param layer_count Number of attachment layers rendered to, shaders select a layer using SV_RenderTargetArrayIndex.
+    /// Ignored for multiview render passes.
+    /// @param view_mask Multiview mask, each set bit renders all draws once to the matching attachment layer with SV_ViewID
+    /// set to the view index. Zero disables multiview, pipelines used in the pass must be created with the same view mask.
     virtual void begin_render_pass(
         RenderRect2D render_area,
         RenderAttachmentInfo* color_targets,
         size_t color_target_count,
         RenderAttachmentInfo* depth_target,
-        RenderAttachmentInfo* stencil_target
+        RenderAttachmentInfo* stencil_target,
+        uint32_t layer_count,
+        uint32_t view_mask
     ) = 0;
 
+    /// @brief Start a new render pass whose contents are recorded by parallel recorders.
+    /// The pass contents are recorded using @ref RenderCommands::get_parallel_recorder, and are executed in recorder order
+    /// when the render pass ends. See @ref RenderCommands::begin_render_pass for the attachment & view parameters.
+    /// @param recorder_count Number of parallel recorders used in the pass, at most @ref RenderCommands::get_max_parallel_recorders.
+    virtual void begin_parallel_render_pass(
+        RenderRect2D render_area,
+        RenderAttachmentInfo* color_targets,
+        size_t color_target_count,
+        RenderAttachmentInfo* depth_target,
+        RenderAttachmentInfo* stencil_target,
+        uint32_t layer_count,
+        uint32_t view_mask,
+        uint32_t recorder_count
+    ) = 0;
+
+    /// @brief Get a parallel recorder for the active parallel render pass.
+    /// Each recorder may be used from a different thread, recorders must be started & ended before the render pass ends.
+    /// Recorders inherit the render pass attachments but no other state, pipelines, viewports, and scissors must be set per recorder.
+    /// Render passes, transitions, and dispatches can not be recorded using a parallel recorder.
+    /// @param recorder_index Recorder index, less than the recorder count passed when starting the pass.
+    /// @return The parallel recorder.
+    [[nodiscard]]
+    virtual RenderCommands* get_parallel_recorder(uint32_t recorder_index) = 0;
+
+    /// @brief Get the maximum number of parallel recorders usable in a single parallel render pass.
+    /// @return The maximum parallel recorder count.
+    [[nodiscard]]
+    virtual uint32_t get_max_parallel_recorders() const = 0;
+
+    /// @brief Get the maximum number of viewports & scissor rects that can be set, at most BONSAI_MAX_VIEWPORT_COUNT.
+    /// Devices without multiple viewport support are limited to a single viewport.
+    /// @return The maximum viewport count.
+    [[nodiscard]]
+    virtual uint32_t get_max_viewport_count() const = 0;
+
     /// @brief End the active render pass.
     virtual void end_render_pass() = 0;
 
@@ -633,14 +815,15 @@ public:
     /// @param primitive_topology
     virtual void set_primitive_topology(PrimitiveTopologyType primitive_topology) = 0;
 
-    /// @brief Set the rasterizer viewports.
-    /// @param count
-    /// @param viewports
+    /// @brief Set the rasterizer viewports. Shaders select a viewport using SV_ViewportArrayIndex, so a single draw
+    /// can render to multiple views, e.g. split screen, shadow cascades or cube faces.
+    /// @param count Number of viewports, at most @ref RenderCommands::get_max_viewport_count. Must match the scissor rect count when drawing.
+    /// @param viewports Viewport array.
     virtual void set_viewports(size_t count, RenderViewport* viewports) = 0;
 
-    /// @brief Set the rasterizer scissor rects.
-    /// @param count
-    /// @param scissor_rects
+    /// @brief Set the rasterizer scissor rects, one for each viewport.
+    /// @param count Number of scissor rects, at most @ref RenderCommands::get_max_viewport_count. Must match the viewport count when drawing.
+    /// @param scissor_rects Scissor rect array.
     virtual void set_scissor_rects(size_t count, RenderRect2D* scissor_rects) = 0;
 
     /// @brief Bind vertex buffers for the input assembly.
@@ -677,9 +860,33 @@ public:
     /// @param z Dispatch dimension z.
     virtual void dispatch(uint32_t x, uint32_t y, uint32_t z) = 0;
 
+    /// @brief Downsample a depth texture into a hierarchical depth pyramid using a single compute dispatch.
+    /// Each pyramid texel stores the farthest depth of the 2x2 texels it covers in the previous level, pyramid mip 0
+    /// covers the depth texture at half resolution. Texels on the last row or column of a level also cover the extra
+    /// row or column of an odd sized previous level, so the pyramid stays conservative for any extent.
+    /// @param depth_texture Depth texture to downsample, must use a depth-only format and be sampleable.
+    /// @param depth_pyramid Pyramid texture, must be a 2D RenderFormatR32_SFLOAT storage texture with up to 12 mip levels.
+    /// Its extent must be half the depth texture extent, rounded up or down.
+    virtual void generate_depth_pyramid(RenderTexture* depth_texture, RenderTexture* depth_pyramid) = 0;
+
+    /// @brief Begin a GPU profile scope, scopes may be nested & must be closed in the same command recording.
+    /// Not available for parallel recorders.
+    /// @param name Scope name, copied by the backend.
+    /// @param pipeline_statistics Gather pipeline statistics for the scope. Statistics scopes must begin & end outside
+    /// of render passes, and are not gathered for scopes nested in another statistics scope or if the device lacks support.
+    virtual void begin_profile_scope(char const* name, bool pipeline_statistics) = 0;
+
+    /// @brief End the innermost open GPU profile scope.
+    virtual void end_profile_scope() = 0;
+
     /// @brief Render ImGui draw data using the render backend.
     /// @param draw_data ImGui draw data, retrieved using ImGui::GetDrawData().
     virtual void imgui_render_draw_data(ImDrawData* draw_data) = 0;
+
+    /// @brief Get the statistics for the current or most recent command recording.
+    /// @return The render command statistics.
+    [[nodiscard]]
+    virtual RenderCommandStatistics get_statistics() const = 0;
 };
 
 /// @brief The RenderBackend wraps a backend graphics API, providing a common interface for the engine to use.
@@ -693,8 +900,10 @@ public:
     /// @brief Create a render backend.
     /// @param platform_surface Main surface to use for rendering, will be used to initialize the render backend.
     /// @param imgui_context ImGui context to use for the render backend.
+    /// @param job_system Job system used for parallel backend work such as shader compilation, may be nullptr to run
+    /// this work on the calling thread. Must outlive the render backend.
     /// @return A new render backend, or nullptr if no backend is active.
-    static RenderBackend* create(PlatformSurface* platform_surface, ImGuiContext* imgui_context);
+    static RenderBackend* create(PlatformSurface* platform_surface, ImGuiContext* imgui_context, JobSystem* job_system);
 
     /// @brief Wait for the backend render device to be idle.
     virtual void wait_idle() const = 0;
@@ -719,6 +928,10 @@ public:
     [[nodiscard]]
     virtual bool is_swap_srgb() const = 0;
 
+    /// @brief Start a new ImGui backend frame, must be called before ImGui::NewFrame on the thread building the UI.
+    /// May not be called while a render backend frame is being recorded on another thread.
+    virtual void imgui_new_frame() = 0;
+
     /// @brief Start a new render backend frame.
     /// @return A render backend frame result.
     [[nodiscard]]
@@ -775,6 +988,69 @@ public:
         RenderTextureTilingMode tiling_mode
     ) = 0;
 
+    /// @brief Get the memory requirements for a render buffer, used for placing buffers in memory heaps.
+    /// @param size Buffer size in bytes.
+    /// @param buffer_usage Buffer usage flags.
+    /// @return The buffer memory requirements.
+    [[nodiscard]]
+    virtual RenderMemoryRequirements get_buffer_memory_requirements(size_t size, RenderBufferUsageFlags buffer_usage) const = 0;
+
+    /// @brief Get the memory requirements for a render texture, used for placing textures in memory heaps.
+    /// See @ref RenderBackend::create_texture for parameter descriptions.
+    /// @return The texture memory requirements.
+    [[nodiscard]]
+    virtual RenderMemoryRequirements get_texture_memory_requirements(
+        RenderTextureType texture_type,
+        RenderFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t depth_or_layers,
+        uint32_t mip_levels,
+        SampleCount sample_count,
+        RenderTextureUsageFlags texture_usage,
+        RenderTextureTilingMode tiling_mode
+    ) const = 0;
+
+    /// @brief Create a device local memory heap.
+    /// @param requirements Heap memory requirements, usually the merged requirements of the resources placed in it.
+    /// @return A new memory heap, or nullptr on failure.
+    [[nodiscard]]
+    virtual RenderMemoryHeap* create_memory_heap(RenderMemoryRequirements const& requirements) = 0;
+
+    /// @brief Create a render buffer placed in a memory heap, the heap must outlive the buffer.
+    /// @param heap Memory heap to place the buffer in.
+    /// @param offset Offset into the heap in bytes, must respect the buffer memory requirements.
+    /// @param size Buffer size in bytes.
+    /// @param buffer_usage Buffer usage flags.
+    /// @return A new render buffer object, or nullptr on failure.
+    [[nodiscard]]
+    virtual RenderBuffer* create_aliased_buffer(
+        RenderMemoryHeap* heap,
+        size_t offset,
+        size_t size,
+        RenderBufferUsageFlags buffer_usage
+    ) = 0;
+
+    /// @brief Create a render texture placed in a memory heap, the heap must outlive the texture.
+    /// See @ref RenderBackend::create_texture for the texture parameter descriptions.
+    /// @param heap Memory heap to place the texture in.
+    /// @param offset Offset into the heap in bytes, must respect the texture memory requirements.
+    /// @return A new render texture object, or nullptr on failure.
+    [[nodiscard]]
+    virtual RenderTexture* create_aliased_texture(
+        RenderMemoryHeap* heap,
+        size_t offset,
+        RenderTextureType texture_type,
+        RenderFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t depth_or_layers,
+        uint32_t mip_levels,
+        SampleCount sample_count,
+        RenderTextureUsageFlags texture_usage,
+        RenderTextureTilingMode tiling_mode
+    ) = 0;
+
     [[nodiscard]]
     virtual ShaderPipeline* create_graphics_pipeline(GraphicsPipelineDescriptor pipeline_descriptor) = 0;
 
@@ -785,6 +1061,12 @@ public:
     /// @return The currently active frame index.
     [[nodiscard]]
     virtual uint64_t get_current_frame_index() const = 0;
+
+    /// @brief Get the most recently resolved GPU profile. GPU timestamps are resolved a few frames after recording
+    /// without stalling, so the profile lags behind the current frame.
+    /// @return The resolved GPU profile.
+    [[nodiscard]]
+    virtual RenderGpuProfile const& get_gpu_profile() const = 0;
 };
 
 #endif //BONSAI_RENDERER_RENDER_BACKEND_HPP
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+#ifndef BONSAI_RENDERER_DRAW_QUEUE_HPP
+#define BONSAI_RENDERER_DRAW_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bonsai/render_backend/render_backend.hpp"
+
+class JobSystem;
+
+/// @brief Draw sort key bit layout, from most to least significant: pass, pipeline, material, mesh & depth.
+/// Sorting by key groups draws by pass first, then minimizes pipeline, material & mesh changes within a pass.
+static constexpr uint32_t DRAW_KEY_PASS_BITS = 6;
+static constexpr uint32_t DRAW_KEY_PIPELINE_BITS = 12;
+static constexpr uint32_t DRAW_KEY_MATERIAL_BITS = 14;
+static constexpr uint32_t DRAW_KEY_MESH_BITS = 14;
+static constexpr uint32_t DRAW_KEY_DEPTH_BITS = 18;
+
+static constexpr uint32_t DRAW_KEY_DEPTH_SHIFT = 0;
+static constexpr uint32_t DRAW_KEY_MESH_SHIFT = DRAW_KEY_DEPTH_SHIFT + DRAW_KEY_DEPTH_BITS;
+static constexpr uint32_t DRAW_KEY_MATERIAL_SHIFT = DRAW_KEY_MESH_SHIFT + DRAW_KEY_MESH_BITS;
+static constexpr uint32_t DRAW_KEY_PIPELINE_SHIFT = DRAW_KEY_MATERIAL_SHIFT + DRAW_KEY_MATERIAL_BITS;
+static constexpr uint32_t DRAW_KEY_PASS_SHIFT = DRAW_KEY_PIPELINE_SHIFT + DRAW_KEY_PIPELINE_BITS;
+static_assert(DRAW_KEY_PASS_SHIFT + DRAW_KEY_PASS_BITS == 64, "Draw key layout must use all 64 bits");
+
+/// @brief Draw packet, stores the state & parameters of a single draw.
+/// Packets without an index buffer are drawn non-indexed, using the index fields as vertex fields.
+struct DrawPacket
+{
+    ShaderPipeline* pipeline;
+    RenderBuffer* vertex_buffer;
+    size_t vertex_buffer_offset;
+    RenderBuffer* index_buffer;
+    size_t index_buffer_offset;
+    IndexType index_type;
+    uint32_t index_count;       /// @brief Number of indices, or vertices for non-indexed draws.
+    uint32_t instance_count;
+    uint32_t first_index;       /// @brief First index, or first vertex for non-indexed draws.
+    int32_t vertex_offset;      /// @brief Offset added to vertex indices, unused for non-indexed draws.
+    uint32_t first_instance;
+};
+
+/// @brief Create a draw sort key, fields wider than their key bits are truncated.
+/// @param pass Pass ID, draws are replayed per pass.
+/// @param pipeline Pipeline ID.
+/// @param material Material ID.
+/// @param mesh Mesh ID.
+/// @param depth Quantized view depth, use an inverted depth for back to front ordering.
+/// @return The draw sort key.
+constexpr uint64_t make_draw_key(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t depth)
+{
+    return ((static_cast<uint64_t>(pass) & ((1ULL << DRAW_KEY_PASS_BITS) - 1)) << DRAW_KEY_PASS_SHIFT)
+        | ((static_cast<uint64_t>(pipeline) & ((1ULL << DRAW_KEY_PIPELINE_BITS) - 1)) << DRAW_KEY_PIPELINE_SHIFT)
+        | ((static_cast<uint64_t>(material) & ((1ULL << DRAW_KEY_MATERIAL_BITS) - 1)) << DRAW_KEY_MATERIAL_SHIFT)
+        | ((static_cast<uint64_t>(mesh) & ((1ULL << DRAW_KEY_MESH_BITS) - 1)) << DRAW_KEY_MESH_SHIFT)
+        | ((static_cast<uint64_t>(depth) & ((1ULL << DRAW_KEY_DEPTH_BITS) - 1)) << DRAW_KEY_DEPTH_SHIFT);
+}
+
+/// @brief Get the pass ID stored in a draw sort key.
+/// @param key Draw sort key.
+/// @return The pass ID.
+constexpr uint32_t get_draw_key_pass(uint64_t key)
+{
+    return static_cast<uint32_t>(key >> DRAW_KEY_PASS_SHIFT);
+}
+
+/// @brief The draw queue collects draw packets for a frame, sorts them by key & replays them through render commands.
+/// Packets with equal keys keep their submission order.
+class DrawQueue
+{
+public:
+    DrawQueue() = default;
+    ~DrawQueue() = default;
+
+    DrawQueue(DrawQueue const&) = delete;
+    DrawQueue& operator=(DrawQueue const&) = delete;
+
+    /// @brief Push a draw packet, the queue must be sorted before it is submitted.
+    /// @param key Draw sort key, see @ref make_draw_key.
+    /// @param packet Draw packet.
+    void push(uint64_t key, DrawPacket const& packet);
+
+    /// @brief Sort the queued packets by key. Large queues are sorted in parallel jobs, small queues on the calling thread.
+    /// @param job_system Job system used to sort large queues, if NULL the queue is always sorted on the calling thread.
+    void sort(JobSystem* job_system = nullptr);
+
+    /// @brief Replay the sorted packets of a pass, state changes between consecutive packets are only recorded once.
+    /// Viewport, scissor & topology state are not part of packets and must be set by the caller.
+    /// @param commands Render commands to record into, a render pass must be active.
+    /// @param pass Pass ID of the packets to replay.
+    /// @return The number of replayed packets.
+    size_t submit(RenderCommands* commands, uint32_t pass) const;
+
+    /// @brief Remove all queued packets, storage is kept for the next frame.
+    void clear();
+
+    /// @brief Get the number of queued packets.
+    [[nodiscard]]
+    size_t size() const { return m_packets.size(); }
+
+    /// @brief Get the key of a packet in sorted order.
+    /// @param index Sorted packet index.
+    /// @return The draw sort key.
+    [[nodiscard]]
+    uint64_t get_key(size_t index) const { return m_sorted_keys[index].key; }
+
+    /// @brief Get a packet in sorted order.
+    /// @param index Sorted packet index.
+    /// @return The draw packet.
+    [[nodiscard]]
+    DrawPacket const& get_packet(size_t index) const { return m_packets[m_sorted_keys[index].packet_index]; }
+
+private:
+    /// @brief Sort key with the index of its packet, packets are not moved while sorting.
+    struct SortKey
+    {
+        uint64_t key;
+        uint32_t packet_index;
+    };
+
+    /// @brief Find the first sorted packet with a pass ID equal or greater than the given pass.
+    [[nodiscard]]
+    size_t find_pass_begin(uint32_t pass) const;
+
+private:
+    std::vector<DrawPacket> m_packets = {};
+    std::vector<SortKey> m_sorted_keys = {};
+    std::vector<SortKey> m_scratch_keys = {};
+    bool m_sorted = true;
+};
+
+#endif //BONSAI_RENDERER_DRAW_QUEUE_HPP
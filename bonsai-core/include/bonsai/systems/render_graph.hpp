@@ -0,0 +1,237 @@
+#pragma once
+#ifndef BONSAI_RENDERER_RENDER_GRAPH_HPP
+#define BONSAI_RENDERER_RENDER_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "bonsai/render_backend/render_backend.hpp"
+
+class RenderGraph;
+
+/// @brief Handle to a texture or buffer resource in a render graph.
+typedef uint32_t RenderGraphResource;
+
+/// @brief Invalid render graph resource handle.
+static constexpr RenderGraphResource RENDER_GRAPH_INVALID_RESOURCE = UINT32_MAX;
+
+/// @brief Render pass callback, records the pass commands. Resources can be retrieved from the graph during execution.
+typedef std::function<void(RenderGraph const& graph, RenderCommands* commands)> RenderGraphPassCallback;
+
+/// @brief Transient render graph texture description, see @ref RenderBackend::create_texture for field descriptions.
+struct RenderGraphTextureDesc
+{
+    RenderTextureType texture_type;
+    RenderFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth_or_layers;
+    uint32_t mip_levels;
+    SampleCount sample_count;
+    RenderTextureUsageFlags texture_usage;
+};
+
+/// @brief Transient render graph buffer description, see @ref RenderBackend::create_buffer for field descriptions.
+struct RenderGraphBufferDesc
+{
+    size_t size;
+    RenderBufferUsageFlags buffer_usage;
+};
+
+/// @brief Render graph statistics, gathered during graph compilation.
+struct RenderGraphStatistics
+{
+    uint32_t pass_count;                /// @brief Number of passes added to the graph.
+    uint32_t culled_pass_count;         /// @brief Number of passes culled because their results are unused.
+    uint32_t transient_resource_count;  /// @brief Number of allocated transient resources.
+    uint32_t memory_heap_count;         /// @brief Number of memory heaps allocated for transient resources.
+    size_t transient_memory_size;       /// @brief Memory required for transient resources without aliasing, in bytes.
+    size_t aliased_memory_size;         /// @brief Memory allocated for transient resources with aliasing, in bytes.
+};
+
+/// @brief The render graph orders frame passes by their declared resource accesses.
+/// Passes declare the resources they read and write, the graph culls passes that do not contribute to an output,
+/// transitions resources before each pass, and places transient resources with disjoint lifetimes in the same memory.
+class RenderGraph
+{
+public:
+    /// @brief The pass builder is used to declare the resource accesses of a pass.
+    class PassBuilder
+    {
+    public:
+        PassBuilder(RenderGraph* graph, uint32_t pass_index);
+
+        /// @brief Declare a resource read, the pass depends on earlier writes to the resource.
+        /// @param resource Resource read by the pass.
+        /// @param state Resource state used by the pass.
+        /// @return The pass builder.
+        PassBuilder& read(RenderGraphResource resource, RenderResourceState state);
+
+        /// @brief Declare a resource write. Writes are assumed to preserve earlier contents, so they also depend on earlier writes.
+        /// @param resource Resource written by the pass.
+        /// @param state Resource state used by the pass.
+        /// @return The pass builder.
+        PassBuilder& write(RenderGraphResource resource, RenderResourceState state);
+
+    private:
+        RenderGraph* m_graph = nullptr;
+        uint32_t m_pass_index = 0;
+    };
+
+    explicit RenderGraph(RenderBackend* render_backend);
+    ~RenderGraph();
+
+    RenderGraph(RenderGraph const&) = delete;
+    RenderGraph& operator=(RenderGraph const&) = delete;
+
+    /// @brief Create a transient texture, the texture is allocated on graph compilation.
+    /// @param name Debug name of the texture.
+    /// @param desc Texture description.
+    /// @return A render graph resource handle.
+    RenderGraphResource create_texture(char const* name, RenderGraphTextureDesc const& desc);
+
+    /// @brief Create a transient buffer, the buffer is allocated on graph compilation.
+    /// @param name Debug name of the buffer.
+    /// @param desc Buffer description.
+    /// @return A render graph resource handle.
+    RenderGraphResource create_buffer(char const* name, RenderGraphBufferDesc const& desc);
+
+    /// @brief Import an externally owned texture, imported resources are always graph outputs.
+    /// @param name Debug name of the texture.
+    /// @param texture Texture to import, may be updated before each execution using @ref RenderGraph::set_imported_texture.
+    /// @param final_state State the texture is transitioned to after graph execution, undefined keeps the last state.
+    /// @return A render graph resource handle.
+    RenderGraphResource import_texture(char const* name, RenderTexture* texture, RenderResourceState final_state);
+
+    /// @brief Import an externally owned buffer, imported resources are always graph outputs.
+    /// @param name Debug name of the buffer.
+    /// @param buffer Buffer to import, may be updated before each execution using @ref RenderGraph::set_imported_buffer.
+    /// @param final_state State the buffer is transitioned to after graph execution, undefined keeps the last state.
+    /// @return A render graph resource handle.
+    RenderGraphResource import_buffer(char const* name, RenderBuffer* buffer, RenderResourceState final_state);
+
+    /// @brief Update an imported texture, e.g. the current swap texture.
+    /// @param resource Imported texture resource.
+    /// @param texture New texture to use.
+    void set_imported_texture(RenderGraphResource resource, RenderTexture* texture);
+
+    /// @brief Update an imported buffer.
+    /// @param resource Imported buffer resource.
+    /// @param buffer New buffer to use.
+    void set_imported_buffer(RenderGraphResource resource, RenderBuffer* buffer);
+
+    /// @brief Mark a transient resource as graph output, passes writing to it are never culled.
+    /// @param resource Resource to mark as output.
+    void set_output(RenderGraphResource resource);
+
+    /// @brief Add a pass to the graph, passes are executed in the order they are added.
+    /// @param name Debug name of the pass.
+    /// @param callback Pass callback that records the pass commands.
+    /// @return A pass builder for declaring resource accesses.
+    PassBuilder add_pass(char const* name, RenderGraphPassCallback callback);
+
+    /// @brief Compile the graph, culling unused passes & allocating transient resources.
+    /// The compiled graph can be executed every frame until it is reset.
+    /// @return A boolean indicating successful compilation.
+    bool compile();
+
+    /// @brief Execute the compiled graph, recording all live passes with their resource transitions.
+    /// @param commands Render commands to record into.
+    void execute(RenderCommands* commands);
+
+    /// @brief Reset the graph, removing all passes & resources and freeing transient memory.
+    /// The render backend must be idle when resetting a compiled graph.
+    void reset();
+
+    /// @brief Get the texture for a resource, transient textures are available after compilation.
+    /// @param resource Texture resource.
+    /// @return The render texture, or nullptr if the resource is not allocated.
+    [[nodiscard]]
+    RenderTexture* get_texture(RenderGraphResource resource) const;
+
+    /// @brief Get the buffer for a resource, transient buffers are available after compilation.
+    /// @param resource Buffer resource.
+    /// @return The render buffer, or nullptr if the resource is not allocated.
+    [[nodiscard]]
+    RenderBuffer* get_buffer(RenderGraphResource resource) const;
+
+    /// @brief Enable or disable gathering pipeline statistics for each executed pass.
+    /// Statistics are only gathered if supported by the render backend.
+    /// @param enabled Set to gather pipeline statistics.
+    void set_pipeline_statistics_enabled(bool enabled) { m_pipeline_statistics_enabled = enabled; }
+
+    /// @brief Check if pipeline statistics are gathered for executed passes.
+    [[nodiscard]]
+    bool pipeline_statistics_enabled() const { return m_pipeline_statistics_enabled; }
+
+    /// @brief Get the graph statistics gathered during the last compilation.
+    /// @return The render graph statistics.
+    [[nodiscard]]
+    RenderGraphStatistics get_statistics() const { return m_statistics; }
+
+private:
+    /// @brief Resource access declared by a pass.
+    struct ResourceAccess
+    {
+        RenderGraphResource resource;
+        RenderResourceState state;
+        bool write;
+    };
+
+    /// @brief Render graph pass.
+    struct Pass
+    {
+        std::string name;
+        RenderGraphPassCallback callback;
+        std::vector<ResourceAccess> accesses;
+        bool live;
+    };
+
+    /// @brief Render graph resource, either transient or imported.
+    struct Resource
+    {
+        std::string name;
+        bool is_texture;
+        bool imported;
+        bool output;
+        RenderGraphTextureDesc texture_desc;
+        RenderGraphBufferDesc buffer_desc;
+        RenderTexture* texture;
+        RenderBuffer* buffer;
+        RenderResourceState final_state;
+        uint32_t first_pass;                                /// @brief First live pass using the resource.
+        uint32_t last_pass;                                 /// @brief Last live pass using the resource.
+        RenderResourceState last_state;                     /// @brief Resource state in the last live pass using the resource.
+        std::vector<RenderGraphResource> alias_predecessors; /// @brief Transient resources that used the same memory earlier in the graph.
+    };
+
+    /// @brief Add a resource access to a pass.
+    void add_access(uint32_t pass_index, RenderGraphResource resource, RenderResourceState state, bool write);
+
+    /// @brief Cull passes that do not contribute to graph outputs.
+    void cull_passes();
+
+    /// @brief Compute live resource lifetimes.
+    void compute_lifetimes();
+
+    /// @brief Place transient resources in memory heaps & create the aliased resources.
+    /// @return A boolean indicating successful allocation.
+    bool allocate_transient_resources();
+
+    /// @brief Free transient resources & memory heaps.
+    void free_transient_resources();
+
+private:
+    RenderBackend* m_render_backend = nullptr;
+    std::vector<Pass> m_passes = {};
+    std::vector<Resource> m_resources = {};
+    std::vector<RenderMemoryHeap*> m_memory_heaps = {};
+    std::vector<RenderResourceState> m_alias_states = {};
+    RenderGraphStatistics m_statistics = {};
+    bool m_compiled = false;
+    bool m_pipeline_statistics_enabled = false;
+};
+
+#endif //BONSAI_RENDERER_RENDER_GRAPH_HPP
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef BONSAI_RENDERER_RENDER_THREAD_HPP
+#define BONSAI_RENDERER_RENDER_THREAD_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "bonsai/systems/renderer.hpp"
+
+/// @brief The render thread renders submitted frames while the main thread simulates the next frame.
+/// Frames are handed off through a pair of snapshots, the main thread fills one while the render thread reads the other.
+class RenderThread
+{
+public:
+    explicit RenderThread(Renderer* renderer);
+    ~RenderThread();
+
+    RenderThread(RenderThread const&) = delete;
+    RenderThread& operator=(RenderThread const&) = delete;
+
+    /// @brief Get the snapshot for the next frame, it is never read by the render thread until submitted.
+    /// @return The snapshot to fill.
+    [[nodiscard]]
+    RenderSnapshot& get_write_snapshot() { return m_snapshots[m_write_index]; }
+
+    /// @brief Submit the write snapshot for rendering & swap snapshots. The render thread must be idle.
+    void submit();
+
+    /// @brief Wait for the render thread to finish the submitted frame.
+    void wait_idle();
+
+private:
+    /// @brief Render thread loop.
+    void run();
+
+private:
+    Renderer* m_renderer = nullptr;
+    RenderSnapshot m_snapshots[2] = {};
+    uint32_t m_write_index = 0;
+    RenderSnapshot* m_submitted_snapshot = nullptr;
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_submit_condition;
+    std::condition_variable m_idle_condition;
+    std::thread m_thread;
+};
+
+#endif //BONSAI_RENDERER_RENDER_THREAD_HPP
@@ -2,12 +2,35 @@
 #ifndef BONSAI_RENDERER_RENDERER_HPP
 #define BONSAI_RENDERER_RENDERER_HPP
 
+#include <cstdint>
+#include <imgui.h>
 #include "bonsai/render_backend/render_backend.hpp"
+#include "bonsai/systems/draw_queue.hpp"
+#include "bonsai/systems/render_graph.hpp"
+
+/// @brief Frame state handed from the main thread to the render thread.
+/// The render thread only reads its snapshot, so the main thread can fill the next snapshot while a frame renders.
+struct RenderSnapshot
+{
+    RenderSnapshot() = default;
+    ~RenderSnapshot();
+
+    RenderSnapshot(RenderSnapshot const&) = delete;
+    RenderSnapshot& operator=(RenderSnapshot const&) = delete;
+
+    uint64_t frame_index = 0;
+    double interpolation_alpha = 0.0;   /// @brief Fixed timestep interpolation alpha of the simulation state.
+    bool has_draw_data = false;         /// @brief Set if the frame was prepared, unset while the surface is minimized.
+    ImDrawData draw_data = {};          /// @brief ImGui draw data, the command lists are cloned & owned by the snapshot.
+};
 
 class Renderer
 {
 public:
-    explicit Renderer(RenderBackend* render_backend);
+    /// @brief Create a new renderer.
+    /// @param render_backend Render backend to render with.
+    /// @param job_system Job system used for parallel frame preparation work, such as sorting large draw queues.
+    Renderer(RenderBackend* render_backend, JobSystem* job_system);
     ~Renderer();
 
     Renderer(Renderer const&) = delete;
@@ -18,15 +41,61 @@ public:
     /// @param height New surface height in pixels.
     void on_resize(uint32_t width, uint32_t height);
 
-    /// @brief Draw a new frame using the renderer.
-    void render();
+    /// @brief Prepare a frame on the main thread, building the UI into the snapshot.
+    /// The render thread must be idle, since the UI reads renderer & backend state.
+    /// @param snapshot Snapshot to prepare.
+    void prepare(RenderSnapshot& snapshot);
+
+    /// @brief Draw a prepared frame, may be called on the render thread.
+    /// @param snapshot Prepared frame snapshot.
+    void render(RenderSnapshot& snapshot);
+
+    /// @brief Get the GPU time of the most recently resolved frame, updated when a frame is prepared.
+    /// @return The GPU frame time in milliseconds, zero if no GPU profile is available.
+    [[nodiscard]]
+    double get_gpu_frame_time_ms() const;
+
+private:
+    /// @brief Build & compile the frame render graph for the current swap extent.
+    void build_render_graph();
+
+    /// @brief Draw the CPU profiler panel, controlling zone capture & Chrome trace export.
+    void draw_cpu_profiler();
+
+    /// @brief Draw the GPU profiler panel, showing the scope hierarchy of the last resolved GPU profile.
+    void draw_gpu_profiler();
+
+    /// @brief Export the last resolved GPU profile as CSV.
+    /// @param path Output file path.
+    /// @return A boolean indicating a successful export.
+    bool export_gpu_profile_csv(char const* path) const;
+
+    /// @brief Queue the frame draws, sorted for submission in the scene pass.
+    void queue_draws();
+
+    /// @brief Record the scene pass.
+    /// @param graph Render graph executing the pass.
+    /// @param commands Render commands to record into.
+    void record_scene_pass(RenderGraph const& graph, RenderCommands* commands);
+
+    /// @brief Record the ImGui pass.
+    /// @param graph Render graph executing the pass.
+    /// @param commands Render commands to record into.
+    void record_imgui_pass(RenderGraph const& graph, RenderCommands* commands);
 
 private:
     RenderBackend* m_render_backend = nullptr;
+    JobSystem* m_job_system = nullptr;
     RenderExtent2D m_swap_extent = {};
     ShaderPipeline* m_shader_pipeline = nullptr;
     RenderBuffer* m_vertex_buffer = nullptr;
     RenderBuffer* m_index_buffer = nullptr;
+    RenderCommandStatistics m_frame_statistics = {};
+    DrawQueue m_draw_queue;
+    RenderGraph m_render_graph;
+    RenderGraphResource m_swap_target = RENDER_GRAPH_INVALID_RESOURCE;
+    RenderSnapshot* m_active_snapshot = nullptr;
+    double m_gpu_frame_time_ms = 0.0;
 };
 
 #endif //BONSAI_RENDERER_RENDERER_HPP
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "bonsai/core/event_stream.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <new>
+#include "bonsai/core/logger.hpp"
+#include "bonsai/core/mapped_file.hpp"
+
+/// @brief Source of event stream thread IDs.
+static std::atomic<uint32_t> s_next_thread_id{ 0 };
+
+/// @brief Event stream thread ID of the calling thread, unset until the thread writes its first event.
+static thread_local uint32_t t_thread_id = UINT32_MAX;
+
+/// @brief Get the steady clock time in nanoseconds.
+static uint64_t get_clock_ns()
+{
+    auto const now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+/// @brief Round a value up to the next power of two.
+static uint64_t round_up_pow2(uint64_t value)
+{
+    uint64_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+EventStream::~EventStream()
+{
+    close();
+}
+
+EventStream* EventStream::get()
+{
+    static EventStream instance{};
+    return &instance;
+}
+
+bool EventStream::open(char const* path, uint64_t capacity)
+{
+    close();
+    capacity = round_up_pow2(capacity > 0 ? capacity : 1);
+    size_t const file_size = sizeof(EventStreamHeader) + capacity * sizeof(EventRecord);
+    MappedFileHandle* file = bonsai_create_mapped_file(path, file_size);
+    if (file == nullptr)
+    {
+        BONSAI_ENGINE_LOG_ERROR("Failed to create event stream file {}", path);
+        return false;
+    }
+
+    // The file is zero filled on creation, so only the header needs initializing
+    void* data = bonsai_get_mapped_data(file);
+    auto const wall_clock_now = std::chrono::system_clock::now().time_since_epoch();
+    EventStreamHeader* header = new(data) EventStreamHeader{};
+    header->magic = BONSAI_EVENT_STREAM_MAGIC;
+    header->version = BONSAI_EVENT_STREAM_VERSION;
+    header->record_size = sizeof(EventRecord);
+    header->header_size = sizeof(EventStreamHeader);
+    header->capacity = capacity;
+    header->start_unix_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wall_clock_now).count());
+
+    m_file = file;
+    m_header = header;
+    m_records = reinterpret_cast<EventRecord*>(static_cast<uint8_t*>(data) + sizeof(EventStreamHeader));
+    m_capacity_mask = capacity - 1;
+    m_epoch = get_clock_ns();
+    BONSAI_ENGINE_LOG_INFO("Recording events to {} ({} records)", path, capacity);
+    return true;
+}
+
+void EventStream::close()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    bonsai_close_mapped_file(m_file);
+    m_file = nullptr;
+    m_header = nullptr;
+    m_records = nullptr;
+    m_capacity_mask = 0;
+}
+
+uint64_t EventStream::now() const
+{
+    return get_clock_ns() - m_epoch;
+}
+
+uint32_t EventStream::get_thread_id()
+{
+    if (t_thread_id == UINT32_MAX)
+    {
+        t_thread_id = s_next_thread_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return t_thread_id;
+}
+
+bool read_event_stream(char const* path, EventStreamInfo& info, std::vector<EventRecord>& records)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::streamoff const file_size = file.tellg();
+    if (file_size < 0 || !file.seekg(0))
+    {
+        return false;
+    }
+
+    // The header is read into aligned storage, since it holds the atomic write counter
+    alignas(EventStreamHeader) uint8_t header_storage[sizeof(EventStreamHeader)] = {};
+    if (!file.read(reinterpret_cast<char*>(header_storage), sizeof(EventStreamHeader)))
+    {
+        return false;
+    }
+
+    EventStreamHeader const* header = reinterpret_cast<EventStreamHeader const*>(header_storage);
+    if (header->magic != BONSAI_EVENT_STREAM_MAGIC
+        || header->version != BONSAI_EVENT_STREAM_VERSION
+        || header->record_size != sizeof(EventRecord)
+        || header->header_size != sizeof(EventStreamHeader)
+        || header->capacity == 0
+        || (header->capacity & (header->capacity - 1)) != 0)
+    {
+        return false;
+    }
+
+    // The header is untrusted, so the ring must fit in the file before it is allocated.
+    // The header was read successfully, so the file is at least as large as the header.
+    uint64_t const available_record_count = (static_cast<uint64_t>(file_size) - sizeof(EventStreamHeader)) / sizeof(EventRecord);
+    if (header->capacity > available_record_count)
+    {
+        return false;
+    }
+
+    info.capacity = header->capacity;
+    info.start_unix_ns = header->start_unix_ns;
+    info.write_count = header->write_count.load(std::memory_order_relaxed);
+
+    std::vector<EventRecord> ring(info.capacity);
+    if (!file.read(reinterpret_cast<char*>(ring.data()), static_cast<std::streamsize>(ring.size() * sizeof(EventRecord))))
+    {
+        return false;
+    }
+
+    // Once the ring has wrapped the oldest record is the one after the last written record
+    uint64_t const record_count = info.write_count < info.capacity ? info.write_count : info.capacity;
+    uint64_t const first_index = info.write_count - record_count;
+    records.clear();
+    records.reserve(record_count);
+    for (uint64_t i = 0; i < record_count; i++)
+    {
+        records.push_back(ring[(first_index + i) % info.capacity]);
+    }
+
+    return true;
+}
+
+char const* get_event_type_name(uint32_t type)
+{
+    switch (type)
+    {
+    case EventTypeFrameBegin:
+        return "FrameBegin";
+    case EventTypeFrameEnd:
+        return "FrameEnd";
+    case EventTypePipelineCreated:
+        return "PipelineCreated";
+    case EventTypeAllocation:
+        return "Allocation";
+    case EventTypeSwapchainRecreated:
+        return "SwapchainRecreated";
+    default:
+        break;
+    }
+
+    return "Unknown";
+}
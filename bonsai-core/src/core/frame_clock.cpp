@@ -0,0 +1,105 @@
+#include "bonsai/core/frame_clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include "bonsai/core/assert.hpp"
+
+/// @brief Time before a frame deadline at which waits switch from sleeping to spinning.
+static constexpr uint64_t FRAME_CAP_SPIN_NS = 2'000'000;
+
+/// @brief Get the steady clock time in nanoseconds.
+static uint64_t get_clock_ns()
+{
+    auto const now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+FrameClock::FrameClock(FrameClockConfig const& config)
+{
+    set_config(config);
+}
+
+void FrameClock::set_config(FrameClockConfig const& config)
+{
+    BONSAI_ASSERT(config.fixed_timestep > 0.0 && "Fixed timestep must be positive!");
+    BONSAI_ASSERT(config.target_frame_rate >= 0.0 && "Target frame rate must not be negative!");
+    m_config = config;
+    m_next_deadline_ns = 0;
+}
+
+void FrameClock::begin_frame()
+{
+    uint64_t const now = get_clock_ns();
+    double const delta = m_frame_start_ns != 0 ? static_cast<double>(now - m_frame_start_ns) * 1e-9 : 0.0;
+    m_frame_start_ns = now;
+
+    m_timings.frame_index++;
+    m_timings.fixed_step_count = 0;
+    advance(delta);
+}
+
+void FrameClock::advance(double delta)
+{
+    m_timings.frame_delta = std::clamp(delta, 0.0, m_config.max_frame_delta);
+    m_accumulator += m_timings.frame_delta;
+    m_timings.interpolation_alpha = m_accumulator / m_config.fixed_timestep;
+}
+
+bool FrameClock::consume_fixed_step()
+{
+    if (m_accumulator < m_config.fixed_timestep)
+    {
+        return false;
+    }
+
+    // Drop simulation time that does not fit in the step budget, otherwise slow frames queue ever more steps
+    if (m_timings.fixed_step_count >= m_config.max_fixed_steps)
+    {
+        m_accumulator = std::fmod(m_accumulator, m_config.fixed_timestep);
+        m_timings.interpolation_alpha = m_accumulator / m_config.fixed_timestep;
+        return false;
+    }
+
+    m_accumulator -= m_config.fixed_timestep;
+    m_timings.fixed_step_count++;
+    m_timings.interpolation_alpha = m_accumulator / m_config.fixed_timestep;
+    return true;
+}
+
+void FrameClock::end_frame(double gpu_time_ms)
+{
+    uint64_t const now = get_clock_ns();
+    m_timings.cpu_time_ms = static_cast<double>(now - m_frame_start_ns) * 1e-6;
+    m_timings.gpu_time_ms = gpu_time_ms;
+    if (m_config.target_frame_rate <= 0.0)
+    {
+        return;
+    }
+
+    // Deadlines advance by whole frame periods so pacing does not drift, missed deadlines restart the schedule
+    uint64_t const frame_period_ns = static_cast<uint64_t>(1e9 / m_config.target_frame_rate);
+    m_next_deadline_ns = m_next_deadline_ns != 0 ? m_next_deadline_ns + frame_period_ns : m_frame_start_ns + frame_period_ns;
+    if (m_next_deadline_ns <= now)
+    {
+        m_next_deadline_ns = now;
+        return;
+    }
+
+    wait_until(m_next_deadline_ns);
+}
+
+void FrameClock::wait_until(uint64_t deadline_ns)
+{
+    uint64_t const now = get_clock_ns();
+    if (now + FRAME_CAP_SPIN_NS < deadline_ns)
+    {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now - FRAME_CAP_SPIN_NS));
+    }
+
+    while (get_clock_ns() < deadline_ns)
+    {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,312 @@
+#include "bonsai/core/job_system.hpp"
+
+#include <algorithm>
+#include <string>
+#include "bonsai/core/assert.hpp"
+#include "bonsai/core/profiler.hpp"
+
+/// @brief Non-worker thread index.
+static constexpr uint32_t NO_WORKER_INDEX = UINT32_MAX;
+
+/// @brief Job system & worker index of the calling worker thread, unset on non-worker threads.
+static thread_local JobSystem const* t_worker_job_system = nullptr;
+static thread_local uint32_t t_worker_index = NO_WORKER_INDEX;
+
+JobSystem::JobSystem(uint32_t worker_count)
+    :
+    m_main_thread_id(std::this_thread::get_id())
+{
+    if (worker_count == 0)
+    {
+        uint32_t const thread_count = std::thread::hardware_concurrency();
+        worker_count = thread_count > 1 ? thread_count - 1 : 1;
+    }
+
+    m_queues.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; i++)
+    {
+        m_queues.push_back(new WorkerQueue());
+    }
+
+    m_workers.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; i++)
+    {
+        m_workers.emplace_back(&JobSystem::worker_main, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_wake_condition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    for (auto& queue : m_queues)
+    {
+        delete queue;
+    }
+}
+
+void JobSystem::submit(JobFunction function, JobCounter* signal, JobCounter* dependency)
+{
+    if (signal != nullptr)
+    {
+        signal->m_value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    push_job(Job{ std::move(function), signal, dependency });
+}
+
+void JobSystem::submit_main_thread(JobFunction function, JobCounter* signal)
+{
+    if (signal != nullptr)
+    {
+        signal->m_value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_main_thread_mutex);
+        m_main_thread_jobs.push_back(Job{ std::move(function), signal, nullptr });
+    }
+
+    // The main thread may be sleeping in a wait
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    if (m_sleeping_wait_count > 0)
+    {
+        m_wait_condition.notify_all();
+    }
+}
+
+void JobSystem::parallel_for(size_t count, size_t batch_size, JobRangeFunction const& function)
+{
+    BONSAI_ASSERT(batch_size > 0 && "Parallel for batch size must be greater than zero!");
+    if (count <= batch_size)
+    {
+        function(0, count); // A single batch is not worth a job
+        return;
+    }
+
+    // The function outlives all batches since this call waits for them
+    JobCounter counter{};
+    for (size_t begin = 0; begin < count; begin += batch_size)
+    {
+        size_t const end = std::min(begin + batch_size, count);
+        submit([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+    wait(counter);
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    BONSAI_ENGINE_PROFILE_SCOPE("JobSystem::wait");
+    uint32_t const worker_index = t_worker_job_system == this ? t_worker_index : NO_WORKER_INDEX;
+    bool const main_thread = is_main_thread();
+    while (!counter.is_done())
+    {
+        Job job{};
+        if ((main_thread && pop_main_thread_job(job)) || pop_job(worker_index, job))
+        {
+            run_job(job);
+            continue;
+        }
+
+        // Sleep until the counter finishes or there is a job to help with, both notify under the sleep mutex
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleeping_wait_count++;
+        m_wait_condition.wait(lock, [this, &counter, main_thread]() {
+            return counter.is_done() || m_queued_job_count.load(std::memory_order_acquire) > 0 || (main_thread && has_main_thread_jobs());
+        });
+        m_sleeping_wait_count--;
+    }
+}
+
+void JobSystem::run_main_thread_jobs()
+{
+    BONSAI_ASSERT(is_main_thread() && "Main thread jobs must be run on the main thread!");
+    Job job{};
+    while (pop_main_thread_job(job))
+    {
+        run_job(job);
+    }
+}
+
+void JobSystem::worker_main(uint32_t worker_index)
+{
+    t_worker_job_system = this;
+    t_worker_index = worker_index;
+    std::string const thread_name = "worker " + std::to_string(worker_index);
+    Profiler::get()->set_thread_name(thread_name.c_str());
+
+    while (true)
+    {
+        Job job{};
+        if (pop_job(worker_index, job))
+        {
+            run_job(job);
+            continue;
+        }
+
+        // Jobs are counted before they are pushed, so a worker never sleeps through a submission
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_wake_condition.wait(lock, [this]() { return m_stop || m_queued_job_count.load(std::memory_order_acquire) > 0; });
+        if (m_stop)
+        {
+            break;
+        }
+    }
+}
+
+void JobSystem::push_job(Job&& job)
+{
+    // Workers push onto their own queue, other threads distribute jobs round-robin
+    uint32_t const queue_index = t_worker_job_system == this
+        ? t_worker_index
+        : m_next_queue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(m_queues.size());
+
+    WorkerQueue* queue = m_queues[queue_index];
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->jobs.push_back(std::move(job));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_queued_job_count.fetch_add(1, std::memory_order_release);
+        if (m_sleeping_wait_count > 0)
+        {
+            m_wait_condition.notify_all();
+        }
+    }
+    m_wake_condition.notify_one();
+}
+
+bool JobSystem::pop_job(uint32_t worker_index, Job& job)
+{
+    if (m_queued_job_count.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    // Own jobs are popped newest first for cache locality, stolen jobs oldest first since they tend to be larger
+    uint32_t const queue_count = static_cast<uint32_t>(m_queues.size());
+    uint32_t const first_queue = worker_index != NO_WORKER_INDEX ? worker_index : 0;
+    for (uint32_t i = 0; i < queue_count; i++)
+    {
+        uint32_t const queue_index = (first_queue + i) % queue_count;
+        WorkerQueue* queue = m_queues[queue_index];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->jobs.empty())
+        {
+            continue;
+        }
+
+        if (queue_index == worker_index)
+        {
+            job = std::move(queue->jobs.back());
+            queue->jobs.pop_back();
+        }
+        else
+        {
+            job = std::move(queue->jobs.front());
+            queue->jobs.pop_front();
+        }
+
+        m_queued_job_count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+bool JobSystem::pop_main_thread_job(Job& job)
+{
+    std::lock_guard<std::mutex> lock(m_main_thread_mutex);
+    if (m_main_thread_jobs.empty())
+    {
+        return false;
+    }
+
+    job = std::move(m_main_thread_jobs.front());
+    m_main_thread_jobs.pop_front();
+    return true;
+}
+
+bool JobSystem::has_main_thread_jobs()
+{
+    std::lock_guard<std::mutex> lock(m_main_thread_mutex);
+    return !m_main_thread_jobs.empty();
+}
+
+bool JobSystem::park_job(Job& job)
+{
+    if (job.dependency == nullptr || job.dependency->is_done())
+    {
+        return false;
+    }
+
+    // The dependency is checked again under the parked mutex, its last job releases parked jobs under the same mutex
+    std::lock_guard<std::mutex> lock(m_parked_mutex);
+    if (job.dependency->is_done())
+    {
+        return false;
+    }
+
+    m_parked_jobs.push_back(std::move(job));
+    return true;
+}
+
+void JobSystem::release_parked_jobs(JobCounter* counter)
+{
+    // The counter may already be destroyed by a thread that waited on it, so it is only compared & never read.
+    // Parked jobs keep their dependency alive, if it was reused in the meantime the job is parked again when run.
+    std::vector<Job> released_jobs{};
+    {
+        std::lock_guard<std::mutex> lock(m_parked_mutex);
+        for (size_t i = 0; i < m_parked_jobs.size();)
+        {
+            if (m_parked_jobs[i].dependency == counter)
+            {
+                released_jobs.push_back(std::move(m_parked_jobs[i]));
+                m_parked_jobs[i] = std::move(m_parked_jobs.back());
+                m_parked_jobs.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    for (auto& job : released_jobs)
+    {
+        push_job(std::move(job));
+    }
+}
+
+void JobSystem::run_job(Job& job)
+{
+    if (park_job(job))
+    {
+        return;
+    }
+
+    job.function();
+    if (job.signal != nullptr && job.signal->m_value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        release_parked_jobs(job.signal);
+
+        // Wake threads waiting on the finished counter
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        if (m_sleeping_wait_count > 0)
+        {
+            m_wait_condition.notify_all();
+        }
+    }
+}
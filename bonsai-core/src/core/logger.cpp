@@ -1,5 +1,27 @@
 #include "bonsai/core/logger.hpp"
 
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+
+/// @brief Name of the logger created when reconfiguring.
+static char const* LOGGER_NAME = "bonsai";
+
+/// @brief Get the spdlog overflow policy for a log overflow policy.
+static spdlog::async_overflow_policy get_spdlog_overflow_policy(LogOverflowPolicy policy)
+{
+    switch (policy)
+    {
+    case LogOverflowPolicy::Block:
+        return spdlog::async_overflow_policy::block;
+    case LogOverflowPolicy::Drop:
+        return spdlog::async_overflow_policy::discard_new;
+    case LogOverflowPolicy::Overwrite:
+        return spdlog::async_overflow_policy::overrun_oldest;
+    }
+
+    return spdlog::async_overflow_policy::block;
+}
+
 Logger::Logger()
 {
     m_logger = spdlog::default_logger();
@@ -11,6 +33,48 @@ Logger* Logger::get()
     return &instance;
 }
 
+void Logger::configure(LoggerConfig const& config)
+{
+    // New loggers write to the same sinks, so output destinations are kept across mode switches
+    std::vector<spdlog::sink_ptr> const sinks = m_logger->sinks();
+
+    // The previous pool is released on return, which writes its queued messages & joins its worker
+    std::shared_ptr<spdlog::details::thread_pool> const previous_thread_pool = m_thread_pool;
+    if (config.mode == LogMode::Async)
+    {
+        // The queue is preallocated, a single worker keeps messages in submission order
+        m_thread_pool = std::make_shared<spdlog::details::thread_pool>(config.async_queue_size, 1);
+        m_logger = std::make_shared<spdlog::async_logger>(
+            LOGGER_NAME,
+            sinks.begin(),
+            sinks.end(),
+            m_thread_pool,
+            get_spdlog_overflow_policy(config.overflow_policy)
+        );
+    }
+    else
+    {
+        m_thread_pool = nullptr;
+        m_logger = std::make_shared<spdlog::logger>(LOGGER_NAME, sinks.begin(), sinks.end());
+    }
+
+    spdlog::set_default_logger(m_logger);
+    set_min_log_level(config.min_level);
+}
+
+void Logger::shutdown()
+{
+    if (m_thread_pool == nullptr)
+    {
+        return;
+    }
+
+    LoggerConfig config{};
+    config.min_level = static_cast<LogLevel>(m_logger->level());
+    config.mode = LogMode::Sync;
+    configure(config);
+}
+
 void Logger::set_min_log_level(LogLevel level)
 {
     spdlog::set_level(static_cast<spdlog::level::level_enum>(level));
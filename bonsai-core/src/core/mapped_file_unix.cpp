@@ -0,0 +1,96 @@
+#include "bonsai/core/mapped_file.hpp"
+#if __unix__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct MappedFileHandle
+{
+    int file;
+    void* data;
+    size_t size;
+};
+
+MappedFileHandle* bonsai_create_mapped_file(char const* path, size_t size)
+{
+    int const file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+    {
+        return nullptr;
+    }
+
+    if (::ftruncate(file, static_cast<off_t>(size)) != 0)
+    {
+        ::close(file);
+        return nullptr;
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(file);
+        return nullptr;
+    }
+
+    return new MappedFileHandle{ file, data, size };
+}
+
+MappedFileHandle* bonsai_open_mapped_file(char const* path)
+{
+    int const file = ::open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat file_stat{};
+    if (::fstat(file, &file_stat) != 0 || file_stat.st_size <= 0)
+    {
+        ::close(file);
+        return nullptr;
+    }
+
+    size_t const size = static_cast<size_t>(file_stat.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(file);
+        return nullptr;
+    }
+
+    return new MappedFileHandle{ file, data, size };
+}
+
+void bonsai_close_mapped_file(MappedFileHandle* handle)
+{
+    if (handle != nullptr)
+    {
+        ::munmap(handle->data, handle->size);
+        ::close(handle->file);
+        delete handle;
+    }
+}
+
+void* bonsai_get_mapped_data(MappedFileHandle const* handle)
+{
+    if (handle == nullptr)
+    {
+        return nullptr;
+    }
+
+    return handle->data;
+}
+
+size_t bonsai_get_mapped_size(MappedFileHandle const* handle)
+{
+    if (handle == nullptr)
+    {
+        return 0;
+    }
+
+    return handle->size;
+}
+
+#endif //__unix__
@@ -0,0 +1,110 @@
+#include "bonsai/core/mapped_file.hpp"
+#if _WIN32
+
+#include <cstdint>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+struct MappedFileHandle
+{
+    HANDLE file;
+    HANDLE mapping;
+    void* data;
+    size_t size;
+};
+
+MappedFileHandle* bonsai_create_mapped_file(char const* path, size_t size)
+{
+    HANDLE file = ::CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    // Mapping a file with a larger size than the file itself extends the file
+    DWORD const size_high = static_cast<DWORD>(static_cast<uint64_t>(size) >> 32);
+    DWORD const size_low = static_cast<DWORD>(static_cast<uint64_t>(size) & 0xFFFF'FFFF);
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, size_high, size_low, nullptr);
+    if (mapping == nullptr)
+    {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (data == nullptr)
+    {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    return new MappedFileHandle{ file, mapping, data, size };
+}
+
+MappedFileHandle* bonsai_open_mapped_file(char const* path)
+{
+    HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (!::GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+    {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    return new MappedFileHandle{ file, mapping, data, static_cast<size_t>(file_size.QuadPart) };
+}
+
+void bonsai_close_mapped_file(MappedFileHandle* handle)
+{
+    if (handle != nullptr)
+    {
+        ::UnmapViewOfFile(handle->data);
+        ::CloseHandle(handle->mapping);
+        ::CloseHandle(handle->file);
+        delete handle;
+    }
+}
+
+void* bonsai_get_mapped_data(MappedFileHandle const* handle)
+{
+    if (handle == nullptr)
+    {
+        return nullptr;
+    }
+
+    return handle->data;
+}
+
+size_t bonsai_get_mapped_size(MappedFileHandle const* handle)
+{
+    if (handle == nullptr)
+    {
+        return 0;
+    }
+
+    return handle->size;
+}
+
+#endif //_WIN32
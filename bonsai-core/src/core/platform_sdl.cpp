@@ -4,6 +4,7 @@
 #include <backends/imgui_impl_sdl3.h>
 #include <SDL3/SDL.h>
 #include "bonsai/core/fatal_exit.hpp"
+#include "bonsai/core/profiler.hpp"
 
 #if     BONSAI_USE_VULKAN
     #include <SDL3/SDL_vulkan.h>
@@ -16,6 +17,8 @@ static int get_sdl_window_flags(PlatformSurfaceConfig const& config)
         flags |= SDL_WINDOW_RESIZABLE;
     if (config.high_dpi)
         flags |= SDL_WINDOW_HIGH_PIXEL_DENSITY;
+    if (config.hidden)
+        flags |= SDL_WINDOW_HIDDEN;
 
     flags |= SDL_WINDOW_VULKAN;
     return flags;
@@ -98,6 +101,7 @@ Platform::~Platform()
 
 bool Platform::pump_messages()
 {
+    BONSAI_ENGINE_PROFILE_SCOPE("Platform::pump_messages");
     ImGuiIO const& io = ImGui::GetIO();
     SDL_Event event{};
     while (SDL_PollEvent(&event))
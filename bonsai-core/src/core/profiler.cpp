@@ -0,0 +1,270 @@
+#include "bonsai/core/profiler.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include "bonsai/core/logger.hpp"
+
+/// @brief Source of unique profiler IDs, IDs are never reused so stale thread buffers of destroyed profilers are ignored.
+static std::atomic<uint64_t> s_next_profiler_id{ 1 };
+
+thread_local Profiler::ThreadBufferOwner Profiler::t_thread_buffer_owner{};
+
+/// @brief Get the steady clock time in nanoseconds.
+static uint64_t get_clock_ns()
+{
+    auto const now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+/// @brief Write a string as a JSON string literal, escaping quotes, backslashes & control characters.
+static void write_json_string(std::ofstream& file, char const* str)
+{
+    file << '"';
+    for (char const* c = str; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            file << '\\' << *c;
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+        {
+            file << ' ';
+        }
+        else
+        {
+            file << *c;
+        }
+    }
+    file << '"';
+}
+
+Profiler::Profiler()
+    :
+    m_id(s_next_profiler_id.fetch_add(1, std::memory_order_relaxed)),
+    m_epoch(get_clock_ns())
+{
+    //
+}
+
+Profiler::~Profiler()
+{
+    // Buffers of running threads are deleted by their thread once it exits or switches profiler
+    for (auto& buffer : m_thread_buffers)
+    {
+        release_thread_buffer(buffer);
+    }
+
+    for (auto& buffer : m_free_thread_buffers)
+    {
+        delete buffer;
+    }
+}
+
+Profiler* Profiler::get()
+{
+    static Profiler instance{};
+    return &instance;
+}
+
+uint64_t Profiler::now() const
+{
+    return get_clock_ns() - m_epoch;
+}
+
+void Profiler::record_zone(char const* name, uint64_t start_ns, uint64_t end_ns)
+{
+    ThreadBuffer* buffer = get_thread_buffer();
+
+    // Only the owning thread writes, so the write index can be read relaxed
+    uint64_t const write_index = buffer->write_index.load(std::memory_order_relaxed);
+    if (write_index - buffer->read_index.load(std::memory_order_acquire) >= BONSAI_PROFILER_THREAD_ZONE_CAPACITY)
+    {
+        buffer->dropped_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ProfileZone& zone = buffer->zones[write_index % BONSAI_PROFILER_THREAD_ZONE_CAPACITY];
+    zone.name = name;
+    zone.start_ns = start_ns;
+    zone.end_ns = end_ns;
+    zone.thread_id = buffer->thread_id;
+    buffer->write_index.store(write_index + 1, std::memory_order_release);
+}
+
+void Profiler::set_thread_name(char const* name)
+{
+    ThreadBuffer* buffer = get_thread_buffer();
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    std::strncpy(buffer->name, name, BONSAI_PROFILER_MAX_THREAD_NAME_LENGTH - 1);
+    buffer->name[BONSAI_PROFILER_MAX_THREAD_NAME_LENGTH - 1] = '\0';
+}
+
+void Profiler::set_capturing(bool capturing)
+{
+    m_capturing = capturing;
+}
+
+void Profiler::flush()
+{
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    bool const capturing = m_capturing;
+    size_t live_buffer_count = 0;
+    for (auto& buffer : m_thread_buffers)
+    {
+        // Retirement is checked before draining, so all zones recorded before the thread exited are drained
+        bool const is_retired = buffer->reference_count.load(std::memory_order_acquire) == 1;
+        uint64_t const read_index = buffer->read_index.load(std::memory_order_relaxed);
+        uint64_t const write_index = buffer->write_index.load(std::memory_order_acquire);
+        if (capturing)
+        {
+            for (uint64_t i = read_index; i < write_index; i++)
+            {
+                m_captured_zones.push_back(buffer->zones[i % BONSAI_PROFILER_THREAD_ZONE_CAPACITY]);
+            }
+        }
+
+        buffer->read_index.store(write_index, std::memory_order_release);
+        if (!is_retired)
+        {
+            m_thread_buffers[live_buffer_count++] = buffer;
+            continue;
+        }
+
+        // Buffers of exited threads are reused by new threads, so short lived threads do not grow the profiler
+        m_retired_dropped_count += buffer->dropped_count.load(std::memory_order_relaxed);
+        if (m_free_thread_buffers.size() < BONSAI_PROFILER_MAX_FREE_THREAD_BUFFERS)
+        {
+            m_free_thread_buffers.push_back(buffer);
+        }
+        else
+        {
+            delete buffer;
+        }
+    }
+    m_thread_buffers.resize(live_buffer_count);
+}
+
+bool Profiler::write_chrome_trace(char const* path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        BONSAI_ENGINE_LOG_ERROR("Failed to open profiler trace file \"{}\"", path);
+        return false;
+    }
+
+    // Trace event timestamps are in microseconds, complete ("X") events nest by time per thread
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first_event = true;
+    {
+        std::lock_guard<std::mutex> lock(m_threads_mutex);
+        for (auto const& buffer : m_thread_buffers)
+        {
+            if (buffer->name[0] == '\0')
+            {
+                continue;
+            }
+
+            file << (first_event ? "\n" : ",\n");
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id << ",\"args\":{\"name\":";
+            write_json_string(file, buffer->name);
+            file << "}}";
+            first_event = false;
+        }
+    }
+
+    for (auto const& zone : m_captured_zones)
+    {
+        file << (first_event ? "\n" : ",\n");
+        file << "{\"name\":";
+        write_json_string(file, zone.name);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.thread_id
+            << ",\"ts\":" << static_cast<double>(zone.start_ns) * 1e-3
+            << ",\"dur\":" << static_cast<double>(zone.end_ns - zone.start_ns) * 1e-3 << "}";
+        first_event = false;
+    }
+    file << "\n]}\n";
+
+    BONSAI_ENGINE_LOG_INFO("Exported profiler trace to \"{}\" ({} zones)", path, m_captured_zones.size());
+    return true;
+}
+
+void Profiler::clear_capture()
+{
+    m_captured_zones.clear();
+}
+
+uint64_t Profiler::get_dropped_zone_count() const
+{
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    uint64_t dropped_count = m_retired_dropped_count;
+    for (auto const& buffer : m_thread_buffers)
+    {
+        dropped_count += buffer->dropped_count.load(std::memory_order_relaxed);
+    }
+
+    return dropped_count;
+}
+
+size_t Profiler::get_thread_buffer_count() const
+{
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    return m_thread_buffers.size() + m_free_thread_buffers.size();
+}
+
+Profiler::ThreadBufferOwner::~ThreadBufferOwner()
+{
+    if (buffer != nullptr)
+    {
+        release_thread_buffer(buffer);
+    }
+}
+
+Profiler::ThreadBuffer* Profiler::get_thread_buffer()
+{
+    ThreadBufferOwner& owner = t_thread_buffer_owner;
+    if (owner.profiler_id == m_id)
+    {
+        return owner.buffer;
+    }
+
+    // Buffers are shared by the profiler & the recording thread, so zones recorded by exited threads can still be flushed.
+    // A thread recording into multiple profilers releases its previous buffer each time it switches profiler.
+    if (owner.buffer != nullptr)
+    {
+        release_thread_buffer(owner.buffer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    ThreadBuffer* buffer = nullptr;
+    if (!m_free_thread_buffers.empty())
+    {
+        buffer = m_free_thread_buffers.back();
+        m_free_thread_buffers.pop_back();
+    }
+    else
+    {
+        buffer = new ThreadBuffer();
+    }
+
+    buffer->thread_id = m_next_thread_id++;
+    buffer->name[0] = '\0';
+    buffer->write_index = 0;
+    buffer->read_index = 0;
+    buffer->dropped_count = 0;
+    buffer->reference_count = 2;
+    m_thread_buffers.push_back(buffer);
+
+    owner.buffer = buffer;
+    owner.profiler_id = m_id;
+    return buffer;
+}
+
+void Profiler::release_thread_buffer(ThreadBuffer* buffer)
+{
+    if (buffer->reference_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete buffer;
+    }
+}
@@ -1,26 +1,97 @@
 #include "bonsai/engine.hpp"
 
+#include <cstdlib>
+#include <cstring>
 #include <imgui.h>
 #include "bonsai/core/assert.hpp"
+#include "bonsai/core/event_stream.hpp"
+#include "bonsai/core/frame_clock.hpp"
+#include "bonsai/core/job_system.hpp"
 #include "bonsai/core/logger.hpp"
 #include "bonsai/core/platform.hpp"
+#include "bonsai/core/profiler.hpp"
 #include "bonsai/render_backend/render_backend.hpp"
+#include "bonsai/systems/render_thread.hpp"
 #include "bonsai/systems/renderer.hpp"
 #include "bonsai/application.hpp"
 #include "bonsai/engine_api.hpp"
 
+/// @brief Default logger configuration, asynchronous with a blocking queue so no messages are lost.
+static constexpr LoggerConfig DEFAULT_LOGGER_CONFIG = {
+#ifndef NDEBUG
+    LogLevel::Debug,
+#else
+    LogLevel::Info,
+#endif
+    LogMode::Async,
+    8192,
+    LogOverflowPolicy::Block,
+};
+
+/// @brief Environment variable overriding the minimum log level, e.g. BONSAI_LOG_LEVEL=trace.
+static char const* LOG_LEVEL_ENV_VAR = "BONSAI_LOG_LEVEL";
+
+/// @brief Environment variable enabling the structured event stream, e.g. BONSAI_EVENT_STREAM=events.bin.
+static char const* EVENT_STREAM_ENV_VAR = "BONSAI_EVENT_STREAM";
+
+/// @brief Default frame clock configuration, a 60 Hz simulation with an uncapped frame rate.
+static constexpr FrameClockConfig DEFAULT_FRAME_CLOCK_CONFIG = {
+    1.0 / 60.0,
+    8,
+    0.25,
+    0.0,
+};
+
 static ImGuiContext* s_imgui_context = nullptr;
+static FrameClock* s_frame_clock = nullptr;
+static JobSystem* s_job_system = nullptr;
 static Platform* s_platform = nullptr;
 static PlatformSurface* s_main_surface = nullptr;
 static RenderBackend* s_render_backend = nullptr;
 static Renderer* s_renderer = nullptr;
+static RenderThread* s_render_thread = nullptr;
+
+/// @brief Get the logger configuration, applying environment overrides to the default configuration.
+/// @return The logger configuration.
+static LoggerConfig get_logger_config()
+{
+    LoggerConfig config = DEFAULT_LOGGER_CONFIG;
+    char const* level_name = std::getenv(LOG_LEVEL_ENV_VAR);
+    if (level_name != nullptr)
+    {
+        // Unknown level names are parsed as "off", those are ignored instead
+        spdlog::level::level_enum const level = spdlog::level::from_str(level_name);
+        if (level != spdlog::level::off || std::strcmp(level_name, "off") == 0)
+        {
+            config.min_level = static_cast<LogLevel>(level);
+        }
+    }
+
+    return config;
+}
 
 Engine::Engine()
 {
     Logger* logger = Logger::get();
-    logger->set_min_log_level(LogLevel::Trace);
+    logger->configure(get_logger_config());
+    Profiler* profiler = Profiler::get();
+    profiler->set_thread_name("main");
     BONSAI_ENGINE_LOG_INFO("Initializing Bonsai Engine");
 
+    char const* event_stream_path = std::getenv(EVENT_STREAM_ENV_VAR);
+    if (event_stream_path != nullptr && event_stream_path[0] != '\0')
+    {
+        BONSAI_ENGINE_LOG_TRACE("Initializing event stream");
+        EventStream::get()->open(event_stream_path);
+    }
+
+    BONSAI_ENGINE_LOG_TRACE("Initializing frame clock");
+    s_frame_clock = new FrameClock(DEFAULT_FRAME_CLOCK_CONFIG);
+
+    BONSAI_ENGINE_LOG_TRACE("Initializing job system");
+    s_job_system = new JobSystem(0);
+    BONSAI_ENGINE_LOG_TRACE("Started {} job system workers", s_job_system->worker_count());
+
     BONSAI_ENGINE_LOG_TRACE("Initializing ImGui");
     IMGUI_CHECKVERSION();
     s_imgui_context = ImGui::CreateContext();
@@ -36,10 +107,11 @@ Engine::Engine()
     PlatformSurfaceConfig main_surface_config{};
     main_surface_config.resizable = true;
     main_surface_config.high_dpi = true;
+    main_surface_config.hidden = false;
     s_main_surface = s_platform->create_surface("Bonsai Application", 1600, 900, main_surface_config);
 
     BONSAI_ENGINE_LOG_TRACE("Initializing Render Backend");
-    s_render_backend = RenderBackend::create(s_main_surface, s_imgui_context);
+    s_render_backend = RenderBackend::create(s_main_surface, s_imgui_context, s_job_system);
     BONSAI_ASSERT(s_render_backend != nullptr && "No Render Backend selected for Bonsai");
     if (s_render_backend->is_swap_srgb())
     {
@@ -47,16 +119,23 @@ Engine::Engine()
     }
 
     BONSAI_ENGINE_LOG_TRACE("Initializing Renderer System");
-    s_renderer = new Renderer(s_render_backend);
+    s_renderer = new Renderer(s_render_backend, s_job_system);
+
+    BONSAI_ENGINE_LOG_TRACE("Initializing Render Thread");
+    s_render_thread = new RenderThread(s_renderer);
 
     BONSAI_ENGINE_LOG_TRACE("Initializing Engine API");
     EngineAPI* engine_api = EngineAPI::get();
     engine_api->register_loggger(logger);
+    engine_api->register_profiler(profiler);
+    engine_api->register_frame_clock(s_frame_clock);
+    engine_api->register_job_system(s_job_system);
     engine_api->register_imgui_context(s_imgui_context);
     engine_api->register_platform(s_platform);
 
     s_platform->set_surface_resized_callback([](PlatformSurface*, uint32_t width, uint32_t height) {
         BONSAI_ENGINE_LOG_TRACE("Window resized ({} x {})", width, height);
+        s_render_thread->wait_idle();
         s_renderer->on_resize(width, height);
     });
 
@@ -66,6 +145,9 @@ Engine::Engine()
 Engine::~Engine()
 {
     BONSAI_ENGINE_LOG_INFO("Shutting down...");
+    BONSAI_ENGINE_LOG_TRACE("Shutting down Render Thread");
+    delete s_render_thread;
+
     BONSAI_ENGINE_LOG_TRACE("Shutting down Renderer System");
     delete s_renderer;
 
@@ -79,7 +161,17 @@ Engine::~Engine()
     BONSAI_ENGINE_LOG_TRACE("Shutting down ImGui");
     ImGui::DestroyContext(s_imgui_context);
 
+    BONSAI_ENGINE_LOG_TRACE("Shutting down job system");
+    delete s_job_system;
+
+    BONSAI_ENGINE_LOG_TRACE("Shutting down frame clock");
+    delete s_frame_clock;
+
+    BONSAI_ENGINE_LOG_TRACE("Shutting down event stream");
+    EventStream::get()->close();
+
     BONSAI_ENGINE_LOG_INFO("Goodbye!");
+    Logger::get()->shutdown();
 }
 
 void Engine::run(char const* app_name)
@@ -102,12 +194,45 @@ void Engine::run(char const* app_name)
     bool running = true;
     while (running)
     {
-        running = s_platform->pump_messages();
-        app->update(0.0);
-        s_renderer->render();
+        s_frame_clock->begin_frame();
+        BONSAI_ENGINE_EVENT(EventTypeFrameBegin, s_frame_clock->get_timings().frame_index, 0);
+        {
+            BONSAI_ENGINE_PROFILE_SCOPE("Engine::frame");
+            running = s_platform->pump_messages();
+            s_job_system->run_main_thread_jobs();
+            {
+                BONSAI_ENGINE_PROFILE_SCOPE("Application::fixed_update");
+                while (s_frame_clock->consume_fixed_step())
+                {
+                    app->fixed_update(s_frame_clock->get_config().fixed_timestep);
+                }
+            }
+            {
+                BONSAI_ENGINE_PROFILE_SCOPE("Application::update");
+                app->update(s_frame_clock->get_timings().frame_delta);
+            }
+
+            // The previous frame renders while this frame updates, the UI is built once the render thread is idle
+            RenderSnapshot& snapshot = s_render_thread->get_write_snapshot();
+            snapshot.frame_index = s_frame_clock->get_timings().frame_index;
+            snapshot.interpolation_alpha = s_frame_clock->get_timings().interpolation_alpha;
+            s_render_thread->wait_idle();
+            s_renderer->prepare(snapshot);
+            s_render_thread->submit();
+        }
+
+        // Zones are flushed outside the frame zone, so the frame zone is part of this frame's flush
+        Profiler::get()->flush();
+        s_frame_clock->end_frame(s_renderer->get_gpu_frame_time_ms());
+        BONSAI_ENGINE_EVENT(
+            EventTypeFrameEnd,
+            s_frame_clock->get_timings().frame_index,
+            static_cast<uint64_t>(s_frame_clock->get_timings().cpu_time_ms * 1e6)
+        );
     }
 
-    // Clean up app module
+    // Clean up app module once its last frame has rendered
+    s_render_thread->wait_idle();
     app_module.destroy_application(app);
     unload_application_module(app_module);
 }
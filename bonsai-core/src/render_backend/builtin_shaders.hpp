@@ -0,0 +1,233 @@
+#pragma once
+#ifndef BONSAI_RENDERER_BUILTIN_SHADERS_HPP
+#define BONSAI_RENDERER_BUILTIN_SHADERS_HPP
+
+#include <cstdint>
+
+/// @brief Maximum number of mip levels the depth pyramid shader can generate in a single dispatch.
+static constexpr uint32_t BONSAI_MAX_DEPTH_PYRAMID_MIPS = 12;
+
+/// @brief Number of depth texels processed by a single depth pyramid workgroup in each dimension.
+static constexpr uint32_t BONSAI_DEPTH_PYRAMID_TILE_SIZE = 64;
+
+/// @brief Depth pyramid push constants, must match the layout of `PyramidConstants` in the shader below.
+struct DepthPyramidConstants
+{
+    uint32_t source_extent[2];
+    uint32_t pyramid_extent[2];
+    uint32_t mip_count;
+    uint32_t workgroup_count;
+};
+
+/*
+ * Single pass depth pyramid downsampler, modelled after AMD's single pass downsampler.
+ *
+ * Every workgroup reduces a 64x64 tile of the depth texture into pyramid mips 0 through 5, all levels after mip 0 are
+ * reduced through group shared memory. The last workgroup to finish, detected through a global atomic counter, then
+ * rebuilds the last row & column of mips 1 through 5 and reduces mip 5 into the remaining mips 6 through 11.
+ *
+ * The pyramid is conservative for odd sized levels, texels on the last row or column also cover the extra texel row or
+ * column of the previous level. That extra texel may belong to another workgroup's tile, which is why the last row &
+ * column are rebuilt once all workgroups have finished.
+ */
+static constexpr char const* BONSAI_DEPTH_PYRAMID_SHADER_ENTRYPOINT = "CSMain";
+static constexpr char const* BONSAI_DEPTH_PYRAMID_SHADER = R"(
+#define MAX_PYRAMID_MIPS 12
+
+struct PyramidConstants
+{
+    uint2 source_extent;
+    uint2 pyramid_extent;
+    uint mip_count;
+    uint workgroup_count;
+};
+
+[[vk::push_constant]] ConstantBuffer<PyramidConstants> constants;
+[[vk::binding(0, 0)]] Texture2D<float> depth_texture;
+[[vk::binding(1, 0)]] [[vk::image_format("r32f")]] globallycoherent RWTexture2D<float> pyramid_mips[MAX_PYRAMID_MIPS];
+[[vk::binding(2, 0)]] globallycoherent RWStructuredBuffer<uint> atomic_counter;
+
+groupshared float lds_depth[32][32];
+groupshared uint lds_is_last_workgroup;
+
+uint2 mip_extent(uint mip)
+{
+    return max(constants.pyramid_extent >> mip, uint2(1, 1));
+}
+
+uint2 previous_extent(uint mip)
+{
+    return mip == 0 ? constants.source_extent : mip_extent(max(mip, 1) - 1);
+}
+
+float load_previous(uint mip, uint2 coord)
+{
+    // Mip 0 is reduced from the depth texture, other mips from the previous pyramid mip
+    if (mip == 0)
+    {
+        return depth_texture.Load(int3(coord, 0));
+    }
+
+    return pyramid_mips[max(mip, 1) - 1][coord];
+}
+
+void store_mip(uint mip, uint2 coord, float value)
+{
+    if (mip < constants.mip_count && all(coord < mip_extent(mip)))
+    {
+        pyramid_mips[mip][coord] = value;
+    }
+}
+
+float reduce_footprint(uint mip, uint2 coord)
+{
+    // Reduce the 2x2 footprint in the previous level, the last row & column also cover the extra texel of odd levels
+    uint2 const extent = mip_extent(mip);
+    uint2 const previous = previous_extent(mip);
+    uint2 const first = min(coord * 2, previous - 1);
+    uint2 last = min(coord * 2 + 1, previous - 1);
+    if (coord.x == extent.x - 1)
+    {
+        last.x = previous.x - 1;
+    }
+    if (coord.y == extent.y - 1)
+    {
+        last.y = previous.y - 1;
+    }
+
+    float value = 0.0;
+    for (uint y = first.y; y <= last.y; y++)
+    {
+        for (uint x = first.x; x <= last.x; x++)
+        {
+            value = max(value, load_previous(mip, uint2(x, y)));
+        }
+    }
+    return value;
+}
+
+float reduce_lds(uint mip, uint2 coord, uint2 local_coord, uint previous_size)
+{
+    // Same footprint as reduce_footprint, but the extra texel of odd levels is only included if it is part of this tile
+    uint2 const extent = mip_extent(mip);
+    uint2 const previous = previous_extent(mip);
+    uint2 const first = local_coord * 2;
+    uint2 last = first + 1;
+    if (coord.x == extent.x - 1 && coord.x * 2 + 2 < previous.x)
+    {
+        last.x = min(first.x + 2, previous_size - 1);
+    }
+    if (coord.y == extent.y - 1 && coord.y * 2 + 2 < previous.y)
+    {
+        last.y = min(first.y + 2, previous_size - 1);
+    }
+
+    float value = 0.0;
+    for (uint y = first.y; y <= last.y; y++)
+    {
+        for (uint x = first.x; x <= last.x; x++)
+        {
+            value = max(value, lds_depth[y][x]);
+        }
+    }
+    return value;
+}
+
+void downsample_tile(uint2 tile, uint thread_index, uint base_mip)
+{
+    // Level 0: each thread reduces four source footprints, one per 16x16 quadrant of the 32x32 output tile
+    uint2 const grid = uint2(thread_index % 16, thread_index / 16);
+    [unroll]
+    for (uint i = 0; i < 4; i++)
+    {
+        uint2 const local_coord = grid + uint2(i & 1, i >> 1) * 16;
+        uint2 const coord = tile * 32 + local_coord;
+        float const value = reduce_footprint(base_mip, coord);
+        store_mip(base_mip, coord, value);
+        lds_depth[local_coord.y][local_coord.x] = value;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Levels 1 through 5: reduce through group shared memory, halving the active threads each level
+    [unroll]
+    for (uint level = 1; level < 6; level++)
+    {
+        uint const level_size = 32 >> level;
+        bool const active = thread_index < level_size * level_size;
+        uint2 const local_coord = uint2(thread_index % level_size, thread_index / level_size);
+        uint2 const coord = tile * level_size + local_coord;
+
+        float value = 0.0;
+        if (active)
+        {
+            value = reduce_lds(base_mip + level, coord, local_coord, level_size * 2);
+            store_mip(base_mip + level, coord, value);
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        if (active)
+        {
+            lds_depth[local_coord.y][local_coord.x] = value;
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+}
+
+void rebuild_edges(uint thread_index)
+{
+    // Rebuild the last column & row of mips 1 through 5 in order, each level reads the rebuilt edges of the previous one
+    [unroll]
+    for (uint mip = 1; mip < 6; mip++)
+    {
+        if (mip < constants.mip_count)
+        {
+            uint2 const extent = mip_extent(mip);
+            for (uint i = thread_index; i < extent.x + extent.y; i += 256)
+            {
+                uint2 const coord = i < extent.y ? uint2(extent.x - 1, i) : uint2(i - extent.y, extent.y - 1);
+                pyramid_mips[mip][coord] = reduce_footprint(mip, coord);
+            }
+        }
+        DeviceMemoryBarrierWithGroupSync();
+    }
+}
+
+[shader("compute")]
+[numthreads(256, 1, 1)]
+void CSMain(uint3 group_id : SV_GroupID, uint thread_index : SV_GroupIndex)
+{
+    downsample_tile(group_id.xy, thread_index, 0);
+    if (constants.mip_count <= 1)
+    {
+        return;
+    }
+
+    // Make this workgroup's pyramid writes visible to the other workgroups before signalling completion
+    DeviceMemoryBarrierWithGroupSync();
+    if (thread_index == 0)
+    {
+        uint previous_count = 0;
+        InterlockedAdd(atomic_counter[0], 1, previous_count);
+        lds_is_last_workgroup = (previous_count == constants.workgroup_count - 1) ? 1 : 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (lds_is_last_workgroup == 0)
+    {
+        return;
+    }
+
+    // The last workgroup resets the counter for the next dispatch, fixes up tile edges and reduces the remaining mips
+    if (thread_index == 0)
+    {
+        atomic_counter[0] = 0;
+    }
+    rebuild_edges(thread_index);
+    if (constants.mip_count > 6)
+    {
+        downsample_tile(uint2(0, 0), thread_index, 6);
+    }
+}
+)";
+
+#endif //BONSAI_RENDERER_BUILTIN_SHADERS_HPP
@@ -4,10 +4,10 @@
 #include "vulkan_render_backend.hpp"
 #endif
 
-RenderBackend* RenderBackend::create(PlatformSurface* platform_surface, ImGuiContext* imgui_context)
+RenderBackend* RenderBackend::create(PlatformSurface* platform_surface, ImGuiContext* imgui_context, JobSystem* job_system)
 {
 #if BONSAI_USE_VULKAN
-    return new VulkanRenderBackend(platform_surface, imgui_context);
+    return new VulkanRenderBackend(platform_surface, imgui_context, job_system);
 #else
     return nullptr;
 #endif
@@ -0,0 +1,212 @@
+#include "shader_bundle.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "bonsai/core/logger.hpp"
+
+/// @brief Check if a data range lies within the index end & file end, written so crafted offsets cannot overflow.
+static bool is_range_valid(uint64_t offset, uint64_t length, uint64_t index_end, uint64_t size)
+{
+    return offset >= index_end && offset <= size && length <= size - offset;
+}
+
+/// @brief Round a file offset up to the shader code & reflection data alignment.
+static uint64_t align_data_offset(uint64_t offset)
+{
+    return (offset + 3) & ~static_cast<uint64_t>(3);
+}
+
+ShaderBundle::~ShaderBundle()
+{
+    close();
+}
+
+bool ShaderBundle::open(char const* path)
+{
+    close();
+    MappedFileHandle* file = bonsai_open_mapped_file(path);
+    if (file == nullptr)
+    {
+        BONSAI_ENGINE_LOG_ERROR("Failed to open shader bundle {}", path);
+        return false;
+    }
+
+    uint8_t const* data = static_cast<uint8_t const*>(bonsai_get_mapped_data(file));
+    size_t const size = bonsai_get_mapped_size(file);
+    ShaderBundleHeader header{};
+    if (size >= sizeof(ShaderBundleHeader))
+    {
+        std::memcpy(&header, data, sizeof(ShaderBundleHeader));
+    }
+
+    uint64_t const index_end = sizeof(ShaderBundleHeader) + static_cast<uint64_t>(header.entry_count) * sizeof(ShaderBundleEntry);
+    if (header.magic != BONSAI_SHADER_BUNDLE_MAGIC || header.version != BONSAI_SHADER_BUNDLE_VERSION || size < index_end)
+    {
+        BONSAI_ENGINE_LOG_ERROR("Shader bundle {} is invalid or was written by an incompatible version", path);
+        bonsai_close_mapped_file(file);
+        return false;
+    }
+
+    // Validate all entries once, so lookups do not need bounds checks
+    ShaderBundleEntry const* entries = reinterpret_cast<ShaderBundleEntry const*>(data + sizeof(ShaderBundleHeader));
+    for (uint32_t i = 0; i < header.entry_count; i++)
+    {
+        ShaderBundleEntry const& entry = entries[i];
+        bool const key_valid = is_range_valid(entry.key_offset, entry.key_size, index_end, size);
+        bool const code_valid = is_range_valid(entry.code_offset, entry.code_size, index_end, size) && entry.code_offset % 4 == 0;
+        bool const reflection_valid = entry.reflection_size == 0
+            || (is_range_valid(entry.reflection_offset, entry.reflection_size, index_end, size) && entry.reflection_offset % 4 == 0);
+        bool const sorted = i == 0 || entries[i - 1].key_hash <= entry.key_hash;
+        if (!key_valid || !code_valid || !reflection_valid || !sorted)
+        {
+            BONSAI_ENGINE_LOG_ERROR("Shader bundle {} has an invalid index entry ({})", path, i);
+            bonsai_close_mapped_file(file);
+            return false;
+        }
+    }
+
+    m_file = file;
+    m_data = data;
+    m_entries = entries;
+    m_entry_count = header.entry_count;
+    BONSAI_ENGINE_LOG_INFO("Opened shader bundle {} ({} permutations)", path, m_entry_count);
+    return true;
+}
+
+void ShaderBundle::close()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    bonsai_close_mapped_file(m_file);
+    m_file = nullptr;
+    m_data = nullptr;
+    m_entries = nullptr;
+    m_entry_count = 0;
+}
+
+bool ShaderBundle::find(std::string const& key, ShaderBundleShader& shader) const
+{
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+
+    uint64_t const key_hash = hash_key(key);
+    ShaderBundleEntry const* entries_end = m_entries + m_entry_count;
+    ShaderBundleEntry const* entry = std::lower_bound(m_entries, entries_end, key_hash, [](ShaderBundleEntry const& bundle_entry, uint64_t hash) {
+        return bundle_entry.key_hash < hash;
+    });
+
+    // Hash collisions are resolved by comparing the full key
+    for (; entry != entries_end && entry->key_hash == key_hash; entry++)
+    {
+        if (entry->key_size == key.size() && std::memcmp(m_data + entry->key_offset, key.data(), key.size()) == 0)
+        {
+            shader.code = m_data + entry->code_offset;
+            shader.code_size = entry->code_size;
+            shader.reflection = entry->reflection_size > 0 ? m_data + entry->reflection_offset : nullptr;
+            shader.reflection_size = entry->reflection_size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint64_t ShaderBundle::hash_key(std::string const& key)
+{
+    uint64_t hash = 0xCBF2'9CE4'8422'2325;
+    for (char const character : key)
+    {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 0x0000'0100'0000'01B3;
+    }
+
+    return hash;
+}
+
+bool ShaderBundleWriter::add(std::string const& key, void const* code, size_t code_size, void const* reflection, size_t reflection_size)
+{
+    auto const existing = std::find_if(m_entries.begin(), m_entries.end(), [&key](PendingEntry const& entry) { return entry.key == key; });
+    if (existing != m_entries.end())
+    {
+        return false;
+    }
+
+    uint8_t const* code_bytes = static_cast<uint8_t const*>(code);
+    uint8_t const* reflection_bytes = static_cast<uint8_t const*>(reflection);
+    m_entries.push_back(PendingEntry{
+        key,
+        std::vector<uint8_t>(code_bytes, code_bytes + code_size),
+        std::vector<uint8_t>(reflection_bytes, reflection_bytes + reflection_size),
+    });
+    return true;
+}
+
+bool ShaderBundleWriter::write(char const* path) const
+{
+    // Sort the index by hash for binary search lookups, the key keeps the order stable for equal hashes
+    std::vector<PendingEntry const*> sorted_entries{};
+    sorted_entries.reserve(m_entries.size());
+    for (auto const& entry : m_entries)
+    {
+        sorted_entries.push_back(&entry);
+    }
+    std::sort(sorted_entries.begin(), sorted_entries.end(), [](PendingEntry const* lhs, PendingEntry const* rhs) {
+        uint64_t const lhs_hash = ShaderBundle::hash_key(lhs->key);
+        uint64_t const rhs_hash = ShaderBundle::hash_key(rhs->key);
+        return lhs_hash != rhs_hash ? lhs_hash < rhs_hash : lhs->key < rhs->key;
+    });
+
+    ShaderBundleHeader header{};
+    header.magic = BONSAI_SHADER_BUNDLE_MAGIC;
+    header.version = BONSAI_SHADER_BUNDLE_VERSION;
+    header.entry_count = static_cast<uint32_t>(sorted_entries.size());
+    header.reserved = 0;
+
+    // Lay out key strings, shader code & reflection data after the index
+    std::vector<ShaderBundleEntry> index(sorted_entries.size());
+    uint64_t offset = sizeof(ShaderBundleHeader) + index.size() * sizeof(ShaderBundleEntry);
+    for (size_t i = 0; i < sorted_entries.size(); i++)
+    {
+        PendingEntry const& pending_entry = *sorted_entries[i];
+        index[i].key_hash = ShaderBundle::hash_key(pending_entry.key);
+        index[i].key_offset = offset;
+        index[i].key_size = static_cast<uint32_t>(pending_entry.key.size());
+        offset = align_data_offset(offset + pending_entry.key.size());
+        index[i].code_offset = offset;
+        index[i].code_size = static_cast<uint32_t>(pending_entry.code.size());
+        offset = align_data_offset(offset + pending_entry.code.size());
+        index[i].reflection_offset = offset;
+        index[i].reflection_size = static_cast<uint32_t>(pending_entry.reflection.size());
+        index[i].reserved = 0;
+        offset += pending_entry.reflection.size();
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    static constexpr char PADDING[4] = {};
+    file.write(reinterpret_cast<char const*>(&header), sizeof(ShaderBundleHeader));
+    file.write(reinterpret_cast<char const*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(ShaderBundleEntry)));
+    for (size_t i = 0; i < sorted_entries.size(); i++)
+    {
+        PendingEntry const& pending_entry = *sorted_entries[i];
+        file.write(pending_entry.key.data(), static_cast<std::streamsize>(pending_entry.key.size()));
+        uint64_t const code_padding = index[i].code_offset - (index[i].key_offset + index[i].key_size);
+        file.write(PADDING, static_cast<std::streamsize>(code_padding));
+        file.write(reinterpret_cast<char const*>(pending_entry.code.data()), static_cast<std::streamsize>(pending_entry.code.size()));
+        uint64_t const reflection_padding = index[i].reflection_offset - (index[i].code_offset + index[i].code_size);
+        file.write(PADDING, static_cast<std::streamsize>(reflection_padding));
+        file.write(reinterpret_cast<char const*>(pending_entry.reflection.data()), static_cast<std::streamsize>(pending_entry.reflection.size()));
+    }
+
+    return file.good();
+}
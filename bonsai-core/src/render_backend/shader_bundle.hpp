@@ -0,0 +1,130 @@
+#pragma once
+#ifndef BONSAI_RENDERER_SHADER_BUNDLE_HPP
+#define BONSAI_RENDERER_SHADER_BUNDLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "bonsai/core/mapped_file.hpp"
+
+/*
+ * Shader bundles store precompiled shader permutations in a single indexed file, as written by the bonsai_shaderc tool.
+ * Layout: ShaderBundleHeader, ShaderBundleEntry[entry_count] sorted by key hash, followed by key strings, shader code
+ * & serialized reflection data (see shader_reflection.hpp).
+ * Entries are keyed by the ShaderVariantCache permutation key, all offsets are relative to the start of the file.
+ */
+
+static constexpr uint32_t BONSAI_SHADER_BUNDLE_MAGIC = 0x4C444E42;   // "BNDL"
+static constexpr uint32_t BONSAI_SHADER_BUNDLE_VERSION = 2;
+
+/// @brief Shader bundle file header.
+struct ShaderBundleHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+};
+
+/// @brief Shader bundle index entry, references the permutation key, compiled shader code & reflection data.
+struct ShaderBundleEntry
+{
+    uint64_t key_hash;          /// @brief FNV-1a hash of the permutation key.
+    uint64_t key_offset;
+    uint64_t code_offset;       /// @brief Shader code offset, aligned to 4 bytes for SPIR-V.
+    uint64_t reflection_offset; /// @brief Serialized reflection data offset, aligned to 4 bytes.
+    uint32_t key_size;
+    uint32_t code_size;
+    uint32_t reflection_size;   /// @brief Serialized reflection data size, zero if the shader was not reflected.
+    uint32_t reserved;
+};
+
+/// @brief Precompiled permutation stored in a shader bundle, points into the mapped bundle file.
+struct ShaderBundleShader
+{
+    void const* code;
+    size_t code_size;
+    void const* reflection;
+    size_t reflection_size;
+};
+
+static_assert(sizeof(ShaderBundleHeader) == 16, "Shader bundle header layout must match the file format");
+static_assert(sizeof(ShaderBundleEntry) == 48, "Shader bundle entry layout must match the file format");
+
+/// @brief Read only shader bundle, the bundle file is memory mapped while open.
+class ShaderBundle
+{
+public:
+    ShaderBundle() = default;
+    ~ShaderBundle();
+
+    ShaderBundle(ShaderBundle const&) = delete;
+    ShaderBundle& operator=(ShaderBundle const&) = delete;
+
+    /// @brief Open & validate a shader bundle file, closes a previously opened bundle.
+    /// @param path Shader bundle file path.
+    /// @return A boolean indicating if the bundle was opened.
+    bool open(char const* path);
+
+    /// @brief Close the bundle, shader code returned by @ref ShaderBundle::find is no longer valid afterwards.
+    void close();
+
+    /// @brief Find a precompiled permutation.
+    /// @param key Permutation key.
+    /// @param shader Output shader code & reflection data.
+    /// @return A boolean indicating if the bundle contains the permutation.
+    bool find(std::string const& key, ShaderBundleShader& shader) const;
+
+    [[nodiscard]]
+    bool is_open() const { return m_file != nullptr; }
+
+    /// @brief Get the number of permutations in the bundle.
+    [[nodiscard]]
+    uint32_t entry_count() const { return m_entry_count; }
+
+    /// @brief Get the FNV-1a hash of a permutation key as stored in the bundle index.
+    static uint64_t hash_key(std::string const& key);
+
+private:
+    MappedFileHandle* m_file = nullptr;
+    uint8_t const* m_data = nullptr;
+    ShaderBundleEntry const* m_entries = nullptr;
+    uint32_t m_entry_count = 0;
+};
+
+/// @brief Shader bundle writer, collects compiled permutations & writes them into a bundle file.
+class ShaderBundleWriter
+{
+public:
+    /// @brief Add a compiled permutation, permutations with a key that was already added are ignored.
+    /// @param key Permutation key.
+    /// @param code Compiled shader code.
+    /// @param code_size Compiled shader code size in bytes.
+    /// @param reflection Serialized reflection data, may be nullptr if reflection_size is zero.
+    /// @param reflection_size Serialized reflection data size in bytes.
+    /// @return A boolean indicating if the permutation was added.
+    bool add(std::string const& key, void const* code, size_t code_size, void const* reflection = nullptr, size_t reflection_size = 0);
+
+    /// @brief Write the bundle file.
+    /// @param path Output file path.
+    /// @return A boolean indicating successful write.
+    bool write(char const* path) const;
+
+    /// @brief Get the number of added permutations.
+    [[nodiscard]]
+    size_t entry_count() const { return m_entries.size(); }
+
+private:
+    /// @brief Bundle entry that has not been written yet.
+    struct PendingEntry
+    {
+        std::string key;
+        std::vector<uint8_t> code;
+        std::vector<uint8_t> reflection;
+    };
+
+    std::vector<PendingEntry> m_entries = {};
+};
+
+#endif //BONSAI_RENDERER_SHADER_BUNDLE_HPP
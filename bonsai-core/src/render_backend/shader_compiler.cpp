@@ -3,8 +3,10 @@
 #include <filesystem>
 #include <string>
 #include <memory>
+#include <vector>
 #include "bonsai/core/fatal_exit.hpp"
 #include "bonsai/core/logger.hpp"
+#include "bonsai/core/profiler.hpp"
 
 ShaderCompiler::ShaderCompiler()
 {
@@ -27,12 +29,32 @@ bool ShaderCompiler::compile_source(
     DxcBuffer source,
     char const* base_include_dir,
     bool compile_into_spirv,
-    IDxcBlob** compiled_shader
+    IDxcBlob** compiled_shader,
+    ShaderDefine const* defines,
+    size_t define_count
 ) const
 {
+    BONSAI_ENGINE_PROFILE_SCOPE("ShaderCompiler::compile_source");
     std::wstring const shader_name(name, name + std::strlen(name) + 1);
     std::wstring const entrypoint_name(entrypoint, entrypoint + std::strlen(entrypoint) + 1);
-    BONSAI_ENGINE_LOG_TRACE("Compiling shader blob ({}::{})", name, entrypoint);
+    BONSAI_ENGINE_LOG_TRACE("Compiling shader blob ({}::{}, {} defines)", name, entrypoint, define_count);
+
+    // DXC takes wide define strings, these must outlive the compiler arguments
+    std::vector<std::wstring> define_strings{};
+    define_strings.reserve(define_count * 2);
+    for (size_t i = 0; i < define_count; i++)
+    {
+        char const* define_value = defines[i].value != nullptr ? defines[i].value : "1";
+        define_strings.emplace_back(defines[i].name, defines[i].name + std::strlen(defines[i].name));
+        define_strings.emplace_back(define_value, define_value + std::strlen(define_value));
+    }
+
+    std::vector<DxcDefine> dxc_defines(define_count);
+    for (size_t i = 0; i < define_count; i++)
+    {
+        dxc_defines[i].Name = define_strings[i * 2].c_str();
+        dxc_defines[i].Value = define_strings[i * 2 + 1].c_str();
+    }
 
     CComPtr<IDxcCompilerArgs> compiler_args{};
     HRESULT const arg_result = m_utils->BuildArguments(
@@ -40,7 +62,7 @@ bool ShaderCompiler::compile_source(
         entrypoint_name.c_str(),
         target_profile,
         const_cast<LPCWSTR*>(DEFAULT_ARGUMENTS.data()), DEFAULT_ARGUMENTS.size(), // Const cast is necessary, pointer *should* not be modified through calling this function.
-        nullptr, 0,
+        dxc_defines.data(), static_cast<UINT32>(dxc_defines.size()),
         &compiler_args
     );
     if (FAILED(arg_result))
@@ -89,7 +111,15 @@ bool ShaderCompiler::compile_source(
     return true;
 }
 
-bool ShaderCompiler::compile_file(char const* file_path, char const* entrypoint, LPCWSTR target_profile, bool compile_into_spirv, IDxcBlob** compiled_shader) const
+bool ShaderCompiler::compile_file(
+    char const* file_path,
+    char const* entrypoint,
+    LPCWSTR target_profile,
+    bool compile_into_spirv,
+    IDxcBlob** compiled_shader,
+    ShaderDefine const* defines,
+    size_t define_count
+) const
 {
     std::wstring const wide_file_path(file_path, file_path + std::strlen(file_path) + 1);
     CComPtr<IDxcBlobEncoding> shader_source{};
@@ -106,5 +136,17 @@ bool ShaderCompiler::compile_file(char const* file_path, char const* entrypoint,
     source_buffer.Ptr = shader_source->GetBufferPointer();
     source_buffer.Size = shader_source->GetBufferSize();
     source_buffer.Encoding = 0;
-    return compile_source(file_path, entrypoint, target_profile, source_buffer, base_include_dir.string().c_str(), compile_into_spirv, compiled_shader);
+    return compile_source(file_path, entrypoint, target_profile, source_buffer, base_include_dir.string().c_str(), compile_into_spirv, compiled_shader, defines, define_count);
+}
+
+bool ShaderCompiler::create_pinned_blob(void const* code, size_t code_size, IDxcBlob** shader_blob) const
+{
+    CComPtr<IDxcBlobEncoding> blob{};
+    if (FAILED(m_utils->CreateBlobFromPinned(code, static_cast<UINT32>(code_size), DXC_CP_ACP, &blob)))
+    {
+        return false;
+    }
+
+    *shader_blob = blob.Detach();
+    return true;
 }
@@ -12,7 +12,9 @@
 #endif
 
 #include <array>
+#include <cstddef>
 #include <dxc/dxcapi.h>
+#include "bonsai/render_backend/render_backend.hpp"
 
 static constexpr LPCWSTR BONSAI_TARGET_PROFILE_VS   = L"vs_6_1";
 static constexpr LPCWSTR BONSAI_TARGET_PROFILE_PS   = L"ps_6_1";
@@ -37,8 +39,20 @@ public:
     /// @param base_include_dir Base include dir to use for #include directives, may be nullptr.
     /// @param compile_into_spirv Compile the shader code into SPIR-V bytecode.
     /// @param compiled_shader Output compiled shader bytecode.
+    /// @param defines Preprocessor defines, may be nullptr if define_count is zero.
+    /// @param define_count Number of preprocessor defines.
     /// @return A boolean indicating successful compilation.
-    bool compile_source(char const* name, char const* entrypoint, LPCWSTR target_profile, DxcBuffer source, char const* base_include_dir, bool compile_into_spirv, IDxcBlob** compiled_shader) const;
+    bool compile_source(
+        char const* name,
+        char const* entrypoint,
+        LPCWSTR target_profile,
+        DxcBuffer source,
+        char const* base_include_dir,
+        bool compile_into_spirv,
+        IDxcBlob** compiled_shader,
+        ShaderDefine const* defines = nullptr,
+        size_t define_count = 0
+    ) const;
 
     /// @brief Compile  a shader file to the backend IL.
     /// @param file_path Relative or absolute file path. Will use base directory as shader include path.
@@ -46,8 +60,25 @@ public:
     /// @param target_profile Target profile for the shader, specifies shader capabilities.
     /// @param compile_into_spirv Compile the shader code into SPIR-V bytecode.
     /// @param compiled_shader Output compiled shader bytecode.
+    /// @param defines Preprocessor defines, may be nullptr if define_count is zero.
+    /// @param define_count Number of preprocessor defines.
     /// @return A boolean indicating successful compilation.
-    bool compile_file(char const* file_path, char const* entrypoint, LPCWSTR target_profile, bool compile_into_spirv, IDxcBlob** compiled_shader) const;
+    bool compile_file(
+        char const* file_path,
+        char const* entrypoint,
+        LPCWSTR target_profile,
+        bool compile_into_spirv,
+        IDxcBlob** compiled_shader,
+        ShaderDefine const* defines = nullptr,
+        size_t define_count = 0
+    ) const;
+
+    /// @brief Wrap precompiled shader code in a blob without copying it, e.g. for shader code loaded from a shader bundle.
+    /// @param code Shader code, must outlive the blob.
+    /// @param code_size Shader code size in bytes.
+    /// @param shader_blob Output shader blob.
+    /// @return A boolean indicating successful blob creation.
+    bool create_pinned_blob(void const* code, size_t code_size, IDxcBlob** shader_blob) const;
 
 private:
     /// @brief Default shader arguments to pass to the shader compiler.
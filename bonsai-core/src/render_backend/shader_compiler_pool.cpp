@@ -0,0 +1,138 @@
+#include "shader_compiler_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "bonsai/core/job_system.hpp"
+#include "bonsai/core/profiler.hpp"
+
+ShaderCompilerPool::ShaderCompilerPool(uint32_t capacity, JobSystem* job_system)
+    :
+    m_capacity(capacity),
+    m_job_system(job_system)
+{
+    if (m_capacity == 0)
+    {
+        uint32_t const thread_count = std::thread::hardware_concurrency();
+        m_capacity = thread_count > 0 ? thread_count : 1;
+    }
+}
+
+ShaderCompilerPool::~ShaderCompilerPool()
+{
+    for (auto& compiler : m_compilers)
+    {
+        delete compiler;
+    }
+}
+
+bool ShaderCompilerPool::compile(ShaderCompileRequest const& request, IDxcBlob** compiled_shader)
+{
+    ShaderCompiler* compiler = acquire(true);
+    bool const success = compile_request(*compiler, request, compiled_shader);
+    release(compiler);
+    return success;
+}
+
+size_t ShaderCompilerPool::compile_many(ShaderCompileRequest const* requests, size_t count, ShaderCompileResult* results, uint32_t max_thread_count)
+{
+    BONSAI_ENGINE_PROFILE_SCOPE("ShaderCompilerPool::compile_many");
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // Jobs claim requests one at a time, so long compilations do not hold up a fixed share of the batch
+    std::atomic<size_t> next_request{ 0 };
+    std::atomic<size_t> success_count{ 0 };
+    auto const compile_loop = [&](ShaderCompiler* compiler) {
+        for (size_t i = next_request.fetch_add(1); i < count; i = next_request.fetch_add(1))
+        {
+            ShaderCompileResult& result = results[i];
+            result.compiled_shader = nullptr;
+            result.has_reflection = false;
+            result.success = compile_request(*compiler, requests[i], &result.compiled_shader);
+            success_count.fetch_add(result.success ? 1 : 0, std::memory_order_relaxed);
+        }
+        release(compiler);
+    };
+
+    // The calling thread helps while waiting on the jobs, so it counts towards the available threads
+    uint32_t const thread_limit = max_thread_count > 0 ? std::min(max_thread_count, m_capacity) : m_capacity;
+    size_t const thread_count = m_job_system != nullptr ? m_job_system->worker_count() + 1 : 1;
+    size_t const job_count = std::min({ static_cast<size_t>(thread_limit), thread_count, count });
+    if (job_count == 1)
+    {
+        compile_loop(acquire(true));
+        return success_count.load();
+    }
+
+    // Only the first job waits for a compiler, it compiles all remaining requests even if no other job finds a free compiler
+    m_job_system->parallel_for(job_count, 1, [&](size_t begin, size_t) {
+        ShaderCompiler* compiler = acquire(begin == 0);
+        if (compiler != nullptr)
+        {
+            compile_loop(compiler);
+        }
+    });
+
+    return success_count.load();
+}
+
+bool ShaderCompilerPool::create_pinned_blob(void const* code, size_t code_size, IDxcBlob** shader_blob)
+{
+    ShaderCompiler* compiler = acquire(true);
+    bool const success = compiler->create_pinned_blob(code, code_size, shader_blob);
+    release(compiler);
+    return success;
+}
+
+ShaderCompiler* ShaderCompilerPool::acquire(bool wait)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_free_compilers.empty() && m_compilers.size() < m_capacity)
+    {
+        ShaderCompiler* compiler = new ShaderCompiler();
+        m_compilers.push_back(compiler);
+        return compiler;
+    }
+
+    if (m_free_compilers.empty() && !wait)
+    {
+        return nullptr;
+    }
+
+    m_release_condition.wait(lock, [this]() { return !m_free_compilers.empty(); });
+    ShaderCompiler* compiler = m_free_compilers.back();
+    m_free_compilers.pop_back();
+    return compiler;
+}
+
+void ShaderCompilerPool::release(ShaderCompiler* compiler)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free_compilers.push_back(compiler);
+    }
+    m_release_condition.notify_one();
+}
+
+bool ShaderCompilerPool::compile_request(ShaderCompiler const& compiler, ShaderCompileRequest const& request, IDxcBlob** compiled_shader)
+{
+    if (request.file_path != nullptr)
+    {
+        return compiler.compile_file(request.file_path, request.entrypoint, request.target_profile, request.compile_into_spirv, compiled_shader, request.defines, request.define_count);
+    }
+
+    return compiler.compile_source(
+        request.name,
+        request.entrypoint,
+        request.target_profile,
+        request.source,
+        request.base_include_dir,
+        request.compile_into_spirv,
+        compiled_shader,
+        request.defines,
+        request.define_count
+    );
+}
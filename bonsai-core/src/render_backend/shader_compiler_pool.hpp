@@ -0,0 +1,95 @@
+#pragma once
+#ifndef BONSAI_RENDERER_SHADER_COMPILER_POOL_HPP
+#define BONSAI_RENDERER_SHADER_COMPILER_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "shader_compiler.hpp"
+#include "shader_reflection.hpp"
+
+class JobSystem;
+
+/// @brief Shader compilation request, either compiles an inline source buffer or a shader file.
+struct ShaderCompileRequest
+{
+    char const* name;               /// @brief Shader source name for use in debug messages, ignored for file requests.
+    char const* entrypoint;         /// @brief Shader entrypoint name.
+    LPCWSTR target_profile;         /// @brief Target profile for the shader.
+    DxcBuffer source;               /// @brief Shader HLSL source, ignored for file requests.
+    char const* base_include_dir;   /// @brief Base include dir for #include directives, may be nullptr. Ignored for file requests.
+    char const* file_path;          /// @brief Shader file path, nullptr compiles the source buffer instead.
+    bool compile_into_spirv;        /// @brief Compile the shader code into SPIR-V bytecode.
+    ShaderDefine const* defines;    /// @brief Preprocessor defines, may be nullptr if define_count is zero.
+    size_t define_count;            /// @brief Number of preprocessor defines.
+};
+
+/// @brief Shader compilation result.
+struct ShaderCompileResult
+{
+    CComPtr<IDxcBlob> compiled_shader;
+    bool success;
+    bool has_reflection;                /// @brief Reflection data is set, the compiler pool itself does not reflect shaders.
+    ShaderReflectionData reflection;
+};
+
+/// @brief The shader compiler pool owns a set of shader compilers, DXC compiler instances are not safe to share across threads.
+/// Each compiling thread acquires its own compiler, compilers are created on first use up to the pool capacity.
+class ShaderCompilerPool
+{
+public:
+    /// @brief Create a new shader compiler pool.
+    /// @param capacity Maximum number of compiler instances, zero uses one compiler per hardware thread.
+    /// @param job_system Job system used to compile batches in parallel, if NULL batches are compiled on the calling thread.
+    ShaderCompilerPool(uint32_t capacity, JobSystem* job_system);
+    ~ShaderCompilerPool();
+
+    ShaderCompilerPool(ShaderCompilerPool const&) = delete;
+    ShaderCompilerPool& operator=(ShaderCompilerPool const&) = delete;
+
+    /// @brief Compile a single shader on the calling thread, waits for a free compiler if all compilers are in use.
+    /// @param request Shader compilation request.
+    /// @param compiled_shader Output compiled shader bytecode.
+    /// @return A boolean indicating successful compilation.
+    bool compile(ShaderCompileRequest const& request, IDxcBlob** compiled_shader);
+
+    /// @brief Compile a batch of shaders in parallel jobs, the calling thread compiles alongside the job system workers.
+    /// Each job uses its own compiler, the number of jobs is limited by the pool capacity & the job system thread count.
+    /// @param requests Shader compilation requests.
+    /// @param count Number of requests.
+    /// @param results Output results, one per request.
+    /// @param max_thread_count Maximum number of compiling threads including the calling thread, zero uses the pool capacity.
+    /// @return The number of successfully compiled shaders.
+    size_t compile_many(ShaderCompileRequest const* requests, size_t count, ShaderCompileResult* results, uint32_t max_thread_count = 0);
+
+    /// @brief Wrap precompiled shader code in a blob without copying it, see @ref ShaderCompiler::create_pinned_blob.
+    bool create_pinned_blob(void const* code, size_t code_size, IDxcBlob** shader_blob);
+
+    /// @brief Get the maximum number of compiler instances.
+    [[nodiscard]]
+    uint32_t capacity() const { return m_capacity; }
+
+private:
+    /// @brief Acquire a free compiler, creating one if the pool is not at capacity.
+    /// @param wait Wait for a compiler to be released if none are available.
+    /// @return A compiler, or nullptr if none are available & wait is not set.
+    ShaderCompiler* acquire(bool wait);
+
+    /// @brief Return a compiler to the pool.
+    void release(ShaderCompiler* compiler);
+
+    /// @brief Compile a request using a compiler.
+    static bool compile_request(ShaderCompiler const& compiler, ShaderCompileRequest const& request, IDxcBlob** compiled_shader);
+
+private:
+    uint32_t m_capacity = 0;
+    JobSystem* m_job_system = nullptr;
+    std::mutex m_mutex;
+    std::condition_variable m_release_condition;
+    std::vector<ShaderCompiler*> m_compilers = {};
+    std::vector<ShaderCompiler*> m_free_compilers = {};
+};
+
+#endif //BONSAI_RENDERER_SHADER_COMPILER_POOL_HPP
@@ -0,0 +1,152 @@
+#include "shader_reflection.hpp"
+
+#include <cstring>
+
+/*
+ * The serialized form is a stream of native endian 32-bit values, strings are stored as a length followed by the
+ * characters padded to 4 bytes:
+ *
+ *      magic, version, shader stage, workgroup size[3], push constant count, binding count, constant count,
+ *      push constants { name, offset, size }, bindings { name, set, binding, type, count }, constants { name, id }
+ */
+
+/// @brief Append a 32-bit value to serialized reflection data.
+static void write_value(std::vector<uint8_t>& data, uint32_t value)
+{
+    uint8_t const* bytes = reinterpret_cast<uint8_t const*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(uint32_t));
+}
+
+/// @brief Append a length prefixed string to serialized reflection data, padded to 4 bytes.
+static void write_value(std::vector<uint8_t>& data, std::string const& value)
+{
+    write_value(data, static_cast<uint32_t>(value.size()));
+    data.insert(data.end(), value.begin(), value.end());
+    data.resize((data.size() + 3) & ~static_cast<size_t>(3), 0);
+}
+
+/// @brief Read a 32-bit value from serialized reflection data.
+/// @return A boolean indicating if the value was in bounds.
+static bool read_value(uint8_t const* data, size_t size, size_t& offset, uint32_t& value)
+{
+    if (size - offset < sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    std::memcpy(&value, data + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    return true;
+}
+
+/// @brief Read a length prefixed string from serialized reflection data.
+/// @return A boolean indicating if the string was in bounds.
+static bool read_value(uint8_t const* data, size_t size, size_t& offset, std::string& value)
+{
+    uint32_t length = 0;
+    if (!read_value(data, size, offset, length) || size - offset < length)
+    {
+        return false;
+    }
+
+    value.assign(reinterpret_cast<char const*>(data + offset), length);
+    offset = (offset + length + 3) & ~static_cast<size_t>(3);
+    offset = offset < size ? offset : size;
+    return true;
+}
+
+void serialize_shader_reflection(ShaderReflectionData const& reflection, std::vector<uint8_t>& data)
+{
+    data.clear();
+    write_value(data, BONSAI_SHADER_REFLECTION_MAGIC);
+    write_value(data, BONSAI_SHADER_REFLECTION_VERSION);
+    write_value(data, reflection.shader_stage);
+    write_value(data, reflection.workgroup_size[0]);
+    write_value(data, reflection.workgroup_size[1]);
+    write_value(data, reflection.workgroup_size[2]);
+    write_value(data, static_cast<uint32_t>(reflection.push_constant_blocks.size()));
+    write_value(data, static_cast<uint32_t>(reflection.descriptor_bindings.size()));
+    write_value(data, static_cast<uint32_t>(reflection.specialization_constants.size()));
+
+    for (auto const& block : reflection.push_constant_blocks)
+    {
+        write_value(data, block.name);
+        write_value(data, block.offset);
+        write_value(data, block.size);
+    }
+
+    for (auto const& binding : reflection.descriptor_bindings)
+    {
+        write_value(data, binding.name);
+        write_value(data, binding.set);
+        write_value(data, binding.binding);
+        write_value(data, binding.descriptor_type);
+        write_value(data, binding.count);
+    }
+
+    for (auto const& constant : reflection.specialization_constants)
+    {
+        write_value(data, constant.name);
+        write_value(data, constant.constant_id);
+    }
+}
+
+bool deserialize_shader_reflection(void const* data, size_t size, ShaderReflectionData& reflection)
+{
+    uint8_t const* bytes = static_cast<uint8_t const*>(data);
+    size_t offset = 0;
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t push_constant_count = 0;
+    uint32_t binding_count = 0;
+    uint32_t constant_count = 0;
+    if (!read_value(bytes, size, offset, magic) || magic != BONSAI_SHADER_REFLECTION_MAGIC
+        || !read_value(bytes, size, offset, version) || version != BONSAI_SHADER_REFLECTION_VERSION
+        || !read_value(bytes, size, offset, reflection.shader_stage)
+        || !read_value(bytes, size, offset, reflection.workgroup_size[0])
+        || !read_value(bytes, size, offset, reflection.workgroup_size[1])
+        || !read_value(bytes, size, offset, reflection.workgroup_size[2])
+        || !read_value(bytes, size, offset, push_constant_count)
+        || !read_value(bytes, size, offset, binding_count)
+        || !read_value(bytes, size, offset, constant_count))
+    {
+        return false;
+    }
+
+    // Counts are bounded by the data size, so corrupt counts cannot cause huge allocations
+    size_t const max_count = size / sizeof(uint32_t);
+    if (push_constant_count > max_count || binding_count > max_count || constant_count > max_count)
+    {
+        return false;
+    }
+
+    reflection.push_constant_blocks.resize(push_constant_count);
+    for (auto& block : reflection.push_constant_blocks)
+    {
+        if (!read_value(bytes, size, offset, block.name) || !read_value(bytes, size, offset, block.offset) || !read_value(bytes, size, offset, block.size))
+        {
+            return false;
+        }
+    }
+
+    reflection.descriptor_bindings.resize(binding_count);
+    for (auto& binding : reflection.descriptor_bindings)
+    {
+        if (!read_value(bytes, size, offset, binding.name) || !read_value(bytes, size, offset, binding.set) || !read_value(bytes, size, offset, binding.binding)
+            || !read_value(bytes, size, offset, binding.descriptor_type) || !read_value(bytes, size, offset, binding.count))
+        {
+            return false;
+        }
+    }
+
+    reflection.specialization_constants.resize(constant_count);
+    for (auto& constant : reflection.specialization_constants)
+    {
+        if (!read_value(bytes, size, offset, constant.name) || !read_value(bytes, size, offset, constant.constant_id))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef BONSAI_RENDERER_SHADER_REFLECTION_HPP
+#define BONSAI_RENDERER_SHADER_REFLECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+static constexpr uint32_t BONSAI_SHADER_REFLECTION_MAGIC = 0x4C464552;  // "REFL"
+static constexpr uint32_t BONSAI_SHADER_REFLECTION_VERSION = 1;
+
+/// @brief Reflected push constant block.
+struct ReflectedPushConstantBlock
+{
+    std::string name;
+    uint32_t offset;
+    uint32_t size;
+};
+
+/// @brief Reflected descriptor binding.
+struct ReflectedDescriptorBinding
+{
+    std::string name;
+    uint32_t set;
+    uint32_t binding;
+    uint32_t descriptor_type;   /// @brief Backend descriptor type, for SPIR-V this matches VkDescriptorType.
+    uint32_t count;
+};
+
+/// @brief Reflected specialization constant.
+struct ReflectedSpecializationConstant
+{
+    std::string name;
+    uint32_t constant_id;
+};
+
+/// @brief Reflection data for a single compiled shader, independent of the reflection library that produced it.
+/// Arrays are sorted (push constants by offset, bindings by set & binding, constants by ID), so reflection is deterministic.
+struct ShaderReflectionData
+{
+    uint32_t shader_stage;      /// @brief Backend shader stage flag, for SPIR-V this matches VkShaderStageFlagBits.
+    uint32_t workgroup_size[3]; /// @brief Workgroup size, only set for compute shaders.
+    std::vector<ReflectedPushConstantBlock> push_constant_blocks;
+    std::vector<ReflectedDescriptorBinding> descriptor_bindings;
+    std::vector<ReflectedSpecializationConstant> specialization_constants;
+};
+
+/// @brief Serialize shader reflection data into a compact binary form.
+/// @param reflection Shader reflection data.
+/// @param data Output serialized data, existing contents are replaced.
+void serialize_shader_reflection(ShaderReflectionData const& reflection, std::vector<uint8_t>& data);
+
+/// @brief Deserialize shader reflection data written by @ref serialize_shader_reflection.
+/// @param data Serialized data.
+/// @param size Serialized data size in bytes.
+/// @param reflection Output shader reflection data.
+/// @return A boolean indicating if the data was valid.
+bool deserialize_shader_reflection(void const* data, size_t size, ShaderReflectionData& reflection);
+
+#endif //BONSAI_RENDERER_SHADER_REFLECTION_HPP
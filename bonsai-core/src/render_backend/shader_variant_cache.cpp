@@ -0,0 +1,158 @@
+#include "shader_variant_cache.hpp"
+
+#include <algorithm>
+#include <cwchar>
+#include <utility>
+#include <vector>
+#include "bonsai/core/logger.hpp"
+#include "bonsai/core/profiler.hpp"
+
+std::string ShaderVariantCache::get_key(ShaderCompileRequest const& request)
+{
+    // Defines are sorted by name, so permutations that only differ in define order share a key
+    std::vector<std::pair<std::string, std::string>> defines{};
+    defines.reserve(request.define_count);
+    for (size_t i = 0; i < request.define_count; i++)
+    {
+        ShaderDefine const& define = request.defines[i];
+        defines.emplace_back(define.name, define.value != nullptr ? define.value : "1");
+    }
+    std::sort(defines.begin(), defines.end());
+
+    std::string key{};
+    key.append(request.target_profile, request.target_profile + std::wcslen(request.target_profile));
+    key.append(1, '\0').append(request.entrypoint).append(1, '\0');
+    key.append(request.compile_into_spirv ? "spirv" : "dxil").append(1, '\0');
+    if (request.file_path != nullptr)
+    {
+        key.append("file:").append(request.file_path);
+    }
+    else
+    {
+        // Inline sources are keyed by their full contents, so equal source strings at different addresses share a key.
+        // The include dir resolves their #include directives, so equal sources with different include dirs differ.
+        key.append("source:").append(static_cast<char const*>(request.source.Ptr), request.source.Size);
+        key.append(1, '\0').append("include:").append(request.base_include_dir != nullptr ? request.base_include_dir : "");
+    }
+
+    for (auto const& [ name, value ] : defines)
+    {
+        key.append(1, '\0').append(name).append(1, '=').append(value);
+    }
+
+    return key;
+}
+
+bool ShaderVariantCache::find(std::string const& key, ShaderCompileResult& result)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_variants.find(key);
+    if (it == m_variants.end())
+    {
+        return false;
+    }
+
+    ShaderVariant const& variant = it->second;
+    result.compiled_shader = variant.compiled_shader;
+    result.success = true;
+    result.has_reflection = variant.has_reflection;
+    result.reflection = variant.reflection;
+    return true;
+}
+
+void ShaderVariantCache::insert(std::string const& key, ShaderCompileResult const& result)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_variants.emplace(key, ShaderVariant{ result.compiled_shader, result.has_reflection, result.reflection });
+}
+
+size_t ShaderVariantCache::compile_many(ShaderCompilerPool& pool, ShaderCompileRequest const* requests, size_t count, ShaderCompileResult* results)
+{
+    BONSAI_ENGINE_PROFILE_SCOPE("ShaderVariantCache::compile_many");
+    size_t success_count = 0;
+    std::vector<std::string> miss_keys{};
+    std::vector<std::pair<size_t, size_t>> miss_indices{}; // Request index & miss slot pairs
+    std::vector<ShaderCompileRequest> miss_requests{};
+    for (size_t i = 0; i < count; i++)
+    {
+        std::string key = get_key(requests[i]);
+        results[i].compiled_shader = nullptr;
+        results[i].has_reflection = false;
+        results[i].success = find(key, results[i]);
+        if (!results[i].success && m_bundle != nullptr)
+        {
+            // Precompiled permutations are wrapped without copying, the bundle stays mapped while the cache holds them
+            ShaderBundleShader bundle_shader{};
+            if (m_bundle->find(key, bundle_shader) && pool.create_pinned_blob(bundle_shader.code, bundle_shader.code_size, &results[i].compiled_shader))
+            {
+                results[i].success = true;
+                results[i].has_reflection = bundle_shader.reflection_size > 0
+                    && deserialize_shader_reflection(bundle_shader.reflection, bundle_shader.reflection_size, results[i].reflection);
+                reflect(results[i]);
+                insert(key, results[i]);
+            }
+        }
+
+        if (results[i].success)
+        {
+            success_count++;
+            continue;
+        }
+
+        // Requests for the same permutation within a batch are compiled once
+        size_t const miss_slot = std::find(miss_keys.begin(), miss_keys.end(), key) - miss_keys.begin();
+        if (miss_slot == miss_keys.size())
+        {
+            miss_keys.push_back(std::move(key));
+            miss_requests.push_back(requests[i]);
+        }
+        miss_indices.emplace_back(i, miss_slot);
+    }
+
+    if (miss_requests.empty())
+    {
+        return success_count;
+    }
+
+    BONSAI_ENGINE_LOG_TRACE("Shader variant cache: {} hits, {} permutations to compile", success_count, miss_requests.size());
+    std::vector<ShaderCompileResult> miss_results(miss_requests.size());
+    pool.compile_many(miss_requests.data(), miss_requests.size(), miss_results.data());
+    for (size_t i = 0; i < miss_requests.size(); i++)
+    {
+        if (miss_results[i].success)
+        {
+            reflect(miss_results[i]);
+            insert(miss_keys[i], miss_results[i]);
+        }
+    }
+
+    for (auto const& [ request_index, miss_slot ] : miss_indices)
+    {
+        results[request_index] = miss_results[miss_slot];
+        success_count += results[request_index].success ? 1 : 0;
+    }
+
+    return success_count;
+}
+
+void ShaderVariantCache::reflect(ShaderCompileResult& result) const
+{
+    if (result.has_reflection || m_reflect_function == nullptr)
+    {
+        return;
+    }
+
+    result.has_reflection = m_reflect_function(result.compiled_shader, result.reflection);
+}
+
+void ShaderVariantCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_variants.clear();
+}
+
+size_t ShaderVariantCache::size()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_variants.size();
+}
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef BONSAI_RENDERER_SHADER_VARIANT_CACHE_HPP
+#define BONSAI_RENDERER_SHADER_VARIANT_CACHE_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "shader_bundle.hpp"
+#include "shader_compiler_pool.hpp"
+
+/// @brief Shader reflection function, reflects compiled shader code for a backend.
+typedef bool (*ShaderReflectFunction)(IDxcBlob* shader_code, ShaderReflectionData& reflection);
+
+/// @brief The shader variant cache stores compiled shader permutations, keyed by source, entrypoint, target & defines.
+/// Each unique permutation is compiled once, shader files are keyed by path & are not reloaded while cached.
+/// If a shader bundle is set, permutations found in the bundle are loaded from it instead of being compiled.
+/// If a reflect function is set, reflection data is stored next to each permutation, so shaders are only reflected once.
+class ShaderVariantCache
+{
+public:
+    ShaderVariantCache() = default;
+    ~ShaderVariantCache() = default;
+
+    ShaderVariantCache(ShaderVariantCache const&) = delete;
+    ShaderVariantCache& operator=(ShaderVariantCache const&) = delete;
+
+    /// @brief Get the permutation key for a compile request, define order does not affect the key.
+    /// @param request Shader compilation request.
+    /// @return The permutation key.
+    static std::string get_key(ShaderCompileRequest const& request);
+
+    /// @brief Find a compiled permutation.
+    /// @param key Permutation key.
+    /// @param result Output compiled shader & reflection data, set only if the permutation is found.
+    /// @return A boolean indicating if the permutation is cached.
+    bool find(std::string const& key, ShaderCompileResult& result);
+
+    /// @brief Store a compiled permutation, an existing entry for the key is kept.
+    /// @param key Permutation key.
+    /// @param result Successful compilation result.
+    void insert(std::string const& key, ShaderCompileResult const& result);
+
+    /// @brief Set the shader bundle used to look up precompiled permutations.
+    /// @param bundle Open shader bundle, must outlive the cache. May be nullptr to disable bundle lookups.
+    void set_bundle(ShaderBundle const* bundle) { m_bundle = bundle; }
+
+    /// @brief Set the function used to reflect compiled permutations.
+    /// @param reflect_function Shader reflect function, may be nullptr to disable reflection.
+    void set_reflect_function(ShaderReflectFunction reflect_function) { m_reflect_function = reflect_function; }
+
+    /// @brief Compile a batch of requests, only permutations missing from the cache & shader bundle are compiled.
+    /// @param pool Shader compiler pool used to compile missing permutations.
+    /// @param requests Shader compilation requests.
+    /// @param count Number of requests.
+    /// @param results Output results, one per request.
+    /// @return The number of successfully compiled or cached shaders.
+    size_t compile_many(ShaderCompilerPool& pool, ShaderCompileRequest const* requests, size_t count, ShaderCompileResult* results);
+
+    /// @brief Remove all cached permutations.
+    void clear();
+
+    /// @brief Get the number of cached permutations.
+    [[nodiscard]]
+    size_t size();
+
+private:
+    /// @brief Reflect a compiled shader if it has no reflection data yet & a reflect function is set.
+    void reflect(ShaderCompileResult& result) const;
+
+private:
+    /// @brief Cached permutation.
+    struct ShaderVariant
+    {
+        CComPtr<IDxcBlob> compiled_shader;
+        bool has_reflection;
+        ShaderReflectionData reflection;
+    };
+
+    ShaderBundle const* m_bundle = nullptr;
+    ShaderReflectFunction m_reflect_function = nullptr;
+    std::mutex m_mutex;
+    std::unordered_map<std::string, ShaderVariant> m_variants = {};
+};
+
+#endif //BONSAI_RENDERER_SHADER_VARIANT_CACHE_HPP
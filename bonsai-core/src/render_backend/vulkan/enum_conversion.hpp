@@ -4,6 +4,7 @@
 
 #include <volk.h>
 #include <bonsai/render_backend/render_backend.hpp>
+#include "image_state_tracker.hpp"
 
 VkFormat get_vulkan_format(RenderFormat format);
 
@@ -37,4 +38,7 @@ VkAttachmentStoreOp get_vulkan_store_op(RenderStoreOp store_op);
 
 VkIndexType get_vulkan_index_type(IndexType index_type);
 
+/// @brief Get the Vulkan layout, stages, and access types for a resource state, buffers ignore the layout.
+ImageSubresourceState get_vulkan_resource_state(RenderResourceState resource_state);
+
 #endif //BONSAI_RENDERER_ENUM_CONVERSION_HPP
\ No newline at end of file
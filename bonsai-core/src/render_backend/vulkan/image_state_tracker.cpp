@@ -0,0 +1,144 @@
+#include "image_state_tracker.hpp"
+
+#include "bonsai/core/assert.hpp"
+
+ImageStateTracker::ImageStateTracker(VkImageAspectFlags aspect_flags, uint32_t mip_levels, uint32_t array_layers)
+    :
+    m_aspect_flags(aspect_flags),
+    m_mip_levels(mip_levels),
+    m_array_layers(array_layers),
+    m_states(static_cast<size_t>(mip_levels) * array_layers, ImageSubresourceState{ VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE })
+{
+    //
+}
+
+uint32_t ImageStateTracker::transition(
+    VkImage image,
+    VkImageSubresourceRange const& range,
+    ImageSubresourceState const& next_state,
+    bool discard,
+    std::vector<VkImageMemoryBarrier2>& barriers
+)
+{
+    uint32_t const mip_count = range.levelCount == VK_REMAINING_MIP_LEVELS ? m_mip_levels - range.baseMipLevel : range.levelCount;
+    uint32_t const layer_count = range.layerCount == VK_REMAINING_ARRAY_LAYERS ? m_array_layers - range.baseArrayLayer : range.layerCount;
+    BONSAI_ASSERT(range.baseMipLevel + mip_count <= m_mip_levels && "Mip range out of bounds for image!");
+    BONSAI_ASSERT(range.baseArrayLayer + layer_count <= m_array_layers && "Layer range out of bounds for image!");
+
+    size_t const first_barrier = barriers.size();
+    for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + mip_count; mip++)
+    {
+        uint32_t const layer_end = range.baseArrayLayer + layer_count;
+        uint32_t layer = range.baseArrayLayer;
+        while (layer < layer_end)
+        {
+            // Find the run of layers in this mip that share the same previous state
+            ImageSubresourceState const previous_state = m_states[get_state_index(mip, layer)];
+            uint32_t run_end = layer + 1;
+            while (run_end < layer_end && m_states[get_state_index(mip, run_end)] == previous_state)
+            {
+                run_end++;
+            }
+
+            ImageSubresourceState resolved_state = next_state;
+            if (discard || needs_barrier(previous_state, next_state))
+            {
+                VkImageLayout const old_layout = discard ? VK_IMAGE_LAYOUT_UNDEFINED : previous_state.layout;
+                VkPipelineStageFlags2 const src_stage_mask = previous_state.stage_mask;
+                VkAccessFlags2 const src_access_mask = previous_state.access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS; // Reads never need to be made available
+
+                // Extend a barrier from the previous mip if it covers the same layers with the same previous state
+                bool merged = false;
+                for (size_t i = first_barrier; i < barriers.size(); i++)
+                {
+                    VkImageMemoryBarrier2& barrier = barriers[i];
+                    if (barrier.oldLayout == old_layout
+                        && barrier.srcStageMask == src_stage_mask
+                        && barrier.srcAccessMask == src_access_mask
+                        && barrier.subresourceRange.baseArrayLayer == layer
+                        && barrier.subresourceRange.layerCount == run_end - layer
+                        && barrier.subresourceRange.baseMipLevel + barrier.subresourceRange.levelCount == mip)
+                    {
+                        barrier.subresourceRange.levelCount++;
+                        merged = true;
+                        break;
+                    }
+                }
+
+                if (!merged)
+                {
+                    VkImageMemoryBarrier2 barrier{};
+                    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+                    barrier.pNext = nullptr;
+                    barrier.srcStageMask = src_stage_mask;
+                    barrier.srcAccessMask = src_access_mask;
+                    barrier.dstStageMask = next_state.stage_mask;
+                    barrier.dstAccessMask = next_state.access_mask;
+                    barrier.oldLayout = old_layout;
+                    barrier.newLayout = next_state.layout;
+                    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.image = image;
+                    barrier.subresourceRange = { m_aspect_flags, mip, 1, layer, run_end - layer };
+                    barriers.push_back(barrier);
+                }
+
+                // Read only accesses in the same layout accumulate, later reads in either stage can skip the barrier
+                if (!discard
+                    && previous_state.layout == next_state.layout
+                    && (previous_state.access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS) == 0
+                    && (next_state.access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS) == 0)
+                {
+                    resolved_state.stage_mask |= previous_state.stage_mask;
+                    resolved_state.access_mask |= previous_state.access_mask;
+                }
+            }
+            else
+            {
+                resolved_state = previous_state;
+            }
+
+            for (uint32_t i = layer; i < run_end; i++)
+            {
+                m_states[get_state_index(mip, i)] = resolved_state;
+            }
+            layer = run_end;
+        }
+    }
+
+    return static_cast<uint32_t>(barriers.size() - first_barrier);
+}
+
+void ImageStateTracker::alias(VkPipelineStageFlags2 stage_mask, VkAccessFlags2 access_mask)
+{
+    for (auto& state : m_states)
+    {
+        state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        state.stage_mask |= stage_mask;
+        state.access_mask |= access_mask;
+    }
+}
+
+bool ImageStateTracker::needs_barrier(ImageSubresourceState const& previous_state, ImageSubresourceState const& next_state)
+{
+    if (previous_state.layout != next_state.layout)
+    {
+        return true;
+    }
+
+    if ((previous_state.access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS) != 0
+        || (next_state.access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS) != 0)
+    {
+        return true;
+    }
+
+    // Read after read, a barrier is only needed to make previous writes visible to new stages or access types
+    return (next_state.stage_mask & ~previous_state.stage_mask) != 0
+        || (next_state.access_mask & ~previous_state.access_mask) != 0;
+}
+
+ImageSubresourceState const& ImageStateTracker::get_state(uint32_t mip_level, uint32_t array_layer) const
+{
+    BONSAI_ASSERT(mip_level < m_mip_levels && array_layer < m_array_layers && "Subresource out of bounds for image!");
+    return m_states[get_state_index(mip_level, array_layer)];
+}
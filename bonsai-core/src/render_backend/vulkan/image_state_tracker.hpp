@@ -0,0 +1,113 @@
+#pragma once
+#ifndef BONSAI_RENDERER_IMAGE_STATE_TRACKER_HPP
+#define BONSAI_RENDERER_IMAGE_STATE_TRACKER_HPP
+
+#define VK_NO_PROTOTYPES
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/// @brief Access flags that write to an image, accesses with any of these flags set require a barrier before the next access.
+static constexpr VkAccessFlags2 BONSAI_VULKAN_WRITE_ACCESS_FLAGS = VK_ACCESS_2_SHADER_WRITE_BIT
+    | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+    | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT
+    | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+    | VK_ACCESS_2_TRANSFER_WRITE_BIT
+    | VK_ACCESS_2_HOST_WRITE_BIT
+    | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+/// @brief Tracked synchronization state for a single image subresource.
+struct ImageSubresourceState
+{
+    VkImageLayout layout;               /// @brief Current image layout.
+    VkPipelineStageFlags2 stage_mask;   /// @brief Pipeline stages that last accessed the subresource.
+    VkAccessFlags2 access_mask;         /// @brief Access types of the last access to the subresource.
+};
+
+/// @brief Equality comparison for image subresource states.
+/// @return A boolean indicating if the states are equal.
+inline bool operator==(ImageSubresourceState const& lhs, ImageSubresourceState const& rhs)
+{
+    return lhs.layout == rhs.layout
+        && lhs.stage_mask == rhs.stage_mask
+        && lhs.access_mask == rhs.access_mask;
+}
+
+/// @brief Inequality comparison for image subresource states.
+/// @return A boolean indicating if the states differ.
+inline bool operator!=(ImageSubresourceState const& lhs, ImageSubresourceState const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/// @brief The image state tracker stores the layout & last access for every mip level and array layer of an image.
+/// Transitions emit the minimal set of image barriers for a subresource range, runs of layers and mips that share
+/// the same previous state are merged into a single barrier.
+class ImageStateTracker
+{
+public:
+    ImageStateTracker() = default;
+
+    /// @brief Create a new image state tracker, all subresources start in the undefined layout.
+    /// @param aspect_flags Image aspect flags used for emitted barriers.
+    /// @param mip_levels Number of mip levels in the image.
+    /// @param array_layers Number of array layers in the image.
+    ImageStateTracker(VkImageAspectFlags aspect_flags, uint32_t mip_levels, uint32_t array_layers);
+
+    /// @brief Transition a subresource range to a new state.
+    /// Read after read accesses in the same layout do not emit barriers if the previous state already covers the access.
+    /// @param image Image handle to store in emitted barriers.
+    /// @param range Subresource range to transition, may use VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS.
+    /// @param next_state State to transition the subresource range to.
+    /// @param discard Discard the previous contents of the range, transitions from the undefined layout.
+    /// @param barriers Output barrier list, emitted barriers are appended to this list.
+    /// @return The number of barriers appended to the barrier list.
+    uint32_t transition(
+        VkImage image,
+        VkImageSubresourceRange const& range,
+        ImageSubresourceState const& next_state,
+        bool discard,
+        std::vector<VkImageMemoryBarrier2>& barriers
+    );
+
+    /// @brief Hand over the image memory from other aliased resources, all subresources become undefined.
+    /// The next transition of each subresource waits on the given accesses as well as its own last access.
+    /// @param stage_mask Pipeline stages of the last accesses to the aliased memory.
+    /// @param access_mask Access types of the last accesses to the aliased memory.
+    void alias(VkPipelineStageFlags2 stage_mask, VkAccessFlags2 access_mask);
+
+    /// @brief Check if a transition between two states requires a barrier.
+    /// @param previous_state Previous subresource state.
+    /// @param next_state Next subresource state.
+    /// @return A boolean indicating if a barrier is required.
+    [[nodiscard]]
+    static bool needs_barrier(ImageSubresourceState const& previous_state, ImageSubresourceState const& next_state);
+
+    /// @brief Get the tracked state of a single subresource.
+    /// @param mip_level Mip level of the subresource.
+    /// @param array_layer Array layer of the subresource.
+    /// @return The tracked subresource state.
+    [[nodiscard]]
+    ImageSubresourceState const& get_state(uint32_t mip_level, uint32_t array_layer) const;
+
+    /// @brief Get the tracked layout of a single subresource.
+    /// @param mip_level Mip level of the subresource.
+    /// @param array_layer Array layer of the subresource.
+    /// @return The tracked image layout.
+    [[nodiscard]]
+    VkImageLayout get_layout(uint32_t mip_level, uint32_t array_layer) const { return get_state(mip_level, array_layer).layout; }
+
+private:
+    /// @brief Get the state index for a subresource, states are stored mip-major.
+    [[nodiscard]]
+    size_t get_state_index(uint32_t mip_level, uint32_t array_layer) const { return mip_level * m_array_layers + array_layer; }
+
+private:
+    VkImageAspectFlags m_aspect_flags = 0;
+    uint32_t m_mip_levels = 0;
+    uint32_t m_array_layers = 0;
+    std::vector<ImageSubresourceState> m_states = {};
+};
+
+#endif //BONSAI_RENDERER_IMAGE_STATE_TRACKER_HPP
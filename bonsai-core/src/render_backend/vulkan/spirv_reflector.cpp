@@ -1,5 +1,7 @@
 #include "spirv_reflector.hpp"
 
+#include <algorithm>
+#include <spirv_reflect.h>
 #include <string>
 #include <unordered_map>
 #include "bonsai/core/assert.hpp"
@@ -7,6 +9,19 @@
 #define SPV_REFLECT_SUCCEEDED(result)   ((result) == SPV_REFLECT_RESULT_SUCCESS)
 #define SPV_REFLECT_FAILED(result)      ((result) != SPV_REFLECT_RESULT_SUCCESS)
 
+/// @brief Reflect a list of shader blobs, asserting that reflection succeeds.
+static std::vector<ShaderReflectionData> reflect_shaders(IDxcBlob** shader_sources, uint32_t source_count)
+{
+    std::vector<ShaderReflectionData> reflections(source_count);
+    for (uint32_t i = 0; i < source_count; i++)
+    {
+        [[maybe_unused]] bool const reflected = SPIRVReflector::reflect(shader_sources[i], reflections[i]);
+        BONSAI_ASSERT(reflected && "Failed to reflect SPIR-V shader!");
+    }
+
+    return reflections;
+}
+
 SPIRVReflector::SPIRVReflector(IDxcBlob* shader_source)
     :
     SPIRVReflector(&shader_source, 1)
@@ -15,28 +30,93 @@ SPIRVReflector::SPIRVReflector(IDxcBlob* shader_source)
 }
 
 SPIRVReflector::SPIRVReflector(IDxcBlob** shader_sources, uint32_t source_count)
+    :
+    m_reflections(reflect_shaders(shader_sources, source_count))
 {
-    m_reflect_modules = parse_reflect_modules(shader_sources, source_count);
-    m_push_constant_ranges = parse_push_constant_ranges(m_reflect_modules);
-    m_descriptor_bindings = parse_descriptor_bindings(m_reflect_modules);
+    m_push_constant_ranges = parse_push_constant_ranges(m_reflections);
+    m_descriptor_bindings = parse_descriptor_bindings(m_reflections);
 }
 
-SPIRVReflector::~SPIRVReflector()
+SPIRVReflector::SPIRVReflector(ShaderReflectionData const* reflections, uint32_t reflection_count)
+    :
+    m_reflections(reflections, reflections + reflection_count)
 {
-    for (auto& module : m_reflect_modules)
+    m_push_constant_ranges = parse_push_constant_ranges(m_reflections);
+    m_descriptor_bindings = parse_descriptor_bindings(m_reflections);
+}
+
+bool SPIRVReflector::reflect(IDxcBlob* shader_source, ShaderReflectionData& reflection)
+{
+    SpvReflectShaderModule spv_module{};
+    if (SPV_REFLECT_FAILED(spvReflectCreateShaderModule(shader_source->GetBufferSize(), shader_source->GetBufferPointer(), &spv_module)))
+    {
+        return false;
+    }
+
+    if (spv_module.entry_point_count != 1) // We expect to reflect for a single entrypoint only
+    {
+        spvReflectDestroyShaderModule(&spv_module);
+        return false;
+    }
+
+    SpvReflectEntryPoint const& spv_entrypoint = spv_module.entry_points[0];
+    reflection.shader_stage = static_cast<uint32_t>(spv_module.shader_stage);
+    reflection.workgroup_size[0] = spv_entrypoint.local_size.x;
+    reflection.workgroup_size[1] = spv_entrypoint.local_size.y;
+    reflection.workgroup_size[2] = spv_entrypoint.local_size.z;
+
+    reflection.push_constant_blocks.clear();
+    for (uint32_t i = 0; i < spv_module.push_constant_block_count; i++)
+    {
+        SpvReflectBlockVariable const& pc_block = spv_module.push_constant_blocks[i];
+        reflection.push_constant_blocks.push_back(ReflectedPushConstantBlock{ pc_block.name, pc_block.offset, pc_block.size });
+    }
+
+    reflection.descriptor_bindings.clear();
+    for (uint32_t i = 0; i < spv_module.descriptor_binding_count; i++)
     {
-        spvReflectDestroyShaderModule(&module.spv_module);
+        SpvReflectDescriptorBinding const& spv_binding = spv_module.descriptor_bindings[i];
+        reflection.descriptor_bindings.push_back(ReflectedDescriptorBinding{
+            spv_binding.name,
+            spv_binding.set,
+            spv_binding.binding,
+            static_cast<uint32_t>(spv_binding.descriptor_type),
+            spv_binding.count,
+        });
     }
+
+    reflection.specialization_constants.clear();
+    for (uint32_t i = 0; i < spv_module.spec_constant_count; i++)
+    {
+        SpvReflectSpecializationConstant const& spec_constant = spv_module.spec_constants[i];
+        reflection.specialization_constants.push_back(ReflectedSpecializationConstant{
+            spec_constant.name != nullptr ? spec_constant.name : "",
+            spec_constant.constant_id,
+        });
+    }
+    spvReflectDestroyShaderModule(&spv_module);
+
+    // spirv-reflect reports resources in declaration order, sorting keeps cached reflection data stable
+    std::sort(reflection.push_constant_blocks.begin(), reflection.push_constant_blocks.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.offset < rhs.offset;
+    });
+    std::sort(reflection.descriptor_bindings.begin(), reflection.descriptor_bindings.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.set != rhs.set ? lhs.set < rhs.set : lhs.binding < rhs.binding;
+    });
+    std::sort(reflection.specialization_constants.begin(), reflection.specialization_constants.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.constant_id < rhs.constant_id;
+    });
+    return true;
 }
 
 void SPIRVReflector::get_workgroup_size(uint32_t& x, uint32_t& y, uint32_t& z) const
 {
-    BONSAI_ASSERT(m_reflect_modules.size() == 1 && "Querying the workgroup size is only applicable when reflecting a single shader!");
-    ReflectModule const& module = m_reflect_modules[0];
-    BONSAI_ASSERT(module.spv_entrypoint.shader_stage == SPV_REFLECT_SHADER_STAGE_COMPUTE_BIT && "Querying the workgroup size is only applicable to compute shaders!");
-    x = module.spv_entrypoint.local_size.x;
-    y = module.spv_entrypoint.local_size.y;
-    z = module.spv_entrypoint.local_size.z;
+    BONSAI_ASSERT(m_reflections.size() == 1 && "Querying the workgroup size is only applicable when reflecting a single shader!");
+    ShaderReflectionData const& reflection = m_reflections[0];
+    BONSAI_ASSERT(reflection.shader_stage == VK_SHADER_STAGE_COMPUTE_BIT && "Querying the workgroup size is only applicable to compute shaders!");
+    x = reflection.workgroup_size[0];
+    y = reflection.workgroup_size[1];
+    z = reflection.workgroup_size[2];
 }
 
 uint32_t SPIRVReflector::get_push_constant_range_count() const
@@ -59,37 +139,37 @@ DescriptorBinding const* SPIRVReflector::get_descriptor_bindings() const
     return m_descriptor_bindings.data();
 }
 
-std::vector<ReflectModule> SPIRVReflector::parse_reflect_modules(IDxcBlob** shader_sources, uint32_t source_count)
+bool SPIRVReflector::find_specialization_constant(VkShaderStageFlagBits stage, char const* name, uint32_t& constant_id) const
 {
-    std::vector<ReflectModule> reflect_modules{};
-    reflect_modules.reserve(source_count);
-    for (uint32_t i = 0; i < source_count; i++)
+    for (auto const& reflection : m_reflections)
     {
-        IDxcBlob* shader_source = shader_sources[i];
-
-        SpvReflectShaderModule spv_module{};
-        spvReflectCreateShaderModule(shader_source->GetBufferSize(), shader_source->GetBufferPointer(), &spv_module);
-        BONSAI_ASSERT(spv_module.entry_point_count == 1); // We expect to reflect for a single entrypoint only
+        if (reflection.shader_stage != static_cast<uint32_t>(stage))
+        {
+            continue;
+        }
 
-        ReflectModule reflect_module{};
-        reflect_module.spv_module = spv_module;
-        reflect_module.spv_entrypoint = reflect_module.spv_module.entry_points[0];
-        reflect_modules.push_back(reflect_module);
+        for (auto const& spec_constant : reflection.specialization_constants)
+        {
+            if (spec_constant.name == name)
+            {
+                constant_id = spec_constant.constant_id;
+                return true;
+            }
+        }
     }
 
-    return reflect_modules;
+    return false;
 }
 
-std::vector<VkPushConstantRange> SPIRVReflector::parse_push_constant_ranges(std::vector<ReflectModule> const& reflect_modules)
+std::vector<VkPushConstantRange> SPIRVReflector::parse_push_constant_ranges(std::vector<ShaderReflectionData> const& reflections)
 {
     uint32_t absolute_module_offset = 0;
     std::unordered_map<std::string, VkPushConstantRange> named_pc_ranges{};
-    for (auto const& module : reflect_modules)
+    for (auto const& reflection : reflections)
     {
-        VkShaderStageFlags const stage_flags = module.spv_module.shader_stage;
-        for (uint32_t i = 0; i < module.spv_module.push_constant_block_count; i++)
+        VkShaderStageFlags const stage_flags = reflection.shader_stage;
+        for (auto const& pc_block : reflection.push_constant_blocks)
         {
-            SpvReflectBlockVariable const& pc_block = module.spv_module.push_constant_blocks[i];
             auto const iter = named_pc_ranges.find(pc_block.name);
             if (iter != named_pc_ranges.end())
             {
@@ -118,24 +198,27 @@ std::vector<VkPushConstantRange> SPIRVReflector::parse_push_constant_ranges(std:
         pc_ranges.push_back(range);
     }
 
+    // Hash map order is unspecified, sort so pipeline layouts are generated deterministically
+    std::sort(pc_ranges.begin(), pc_ranges.end(), [](VkPushConstantRange const& lhs, VkPushConstantRange const& rhs) {
+        return lhs.offset != rhs.offset ? lhs.offset < rhs.offset : lhs.size < rhs.size;
+    });
     return pc_ranges;
 }
 
-std::vector<DescriptorBinding> SPIRVReflector::parse_descriptor_bindings(std::vector<ReflectModule> const& reflect_modules)
+std::vector<DescriptorBinding> SPIRVReflector::parse_descriptor_bindings(std::vector<ShaderReflectionData> const& reflections)
 {
     std::unordered_map<std::string, DescriptorBinding> named_descriptor_bindings{};
-    for (auto const& module : reflect_modules)
+    for (auto const& reflection : reflections)
     {
-        VkPipelineStageFlags const stage_flags = module.spv_module.shader_stage;
-        for (uint32_t i = 0; i < module.spv_module.descriptor_binding_count; i++)
+        VkPipelineStageFlags const stage_flags = reflection.shader_stage;
+        for (auto const& reflected_binding : reflection.descriptor_bindings)
         {
-            SpvReflectDescriptorBinding const& spv_binding = module.spv_module.descriptor_bindings[i];
-            auto const iter = named_descriptor_bindings.find(spv_binding.name);
+            auto const iter = named_descriptor_bindings.find(reflected_binding.name);
 
             VkDescriptorSetLayoutBinding layout_binding{};
-            layout_binding.binding = spv_binding.binding;
-            layout_binding.descriptorType = static_cast<VkDescriptorType>(spv_binding.descriptor_type);
-            layout_binding.descriptorCount = spv_binding.count;
+            layout_binding.binding = reflected_binding.binding;
+            layout_binding.descriptorType = static_cast<VkDescriptorType>(reflected_binding.descriptor_type);
+            layout_binding.descriptorCount = reflected_binding.count;
             layout_binding.stageFlags = stage_flags;
             layout_binding.pImmutableSamplers = nullptr; // FIXME(nemjit001): Immutable samplers for pipeline *should* be generated...
 
@@ -143,19 +226,19 @@ std::vector<DescriptorBinding> SPIRVReflector::parse_descriptor_bindings(std::ve
             {
                 DescriptorBinding& descriptor_binding = iter->second;
                 descriptor_binding.layout_binding.stageFlags |= stage_flags;
-                BONSAI_ASSERT(descriptor_binding.set == spv_binding.set && "Named descriptor set index does not match!");
-                BONSAI_ASSERT(descriptor_binding.binding == spv_binding.binding && "Named descriptor binding index does not match!");
+                BONSAI_ASSERT(descriptor_binding.set == reflected_binding.set && "Named descriptor set index does not match!");
+                BONSAI_ASSERT(descriptor_binding.binding == reflected_binding.binding && "Named descriptor binding index does not match!");
                 BONSAI_ASSERT(descriptor_binding.layout_binding.descriptorType == layout_binding.descriptorType && "Named descriptor type does not match!");
                 BONSAI_ASSERT(descriptor_binding.layout_binding.descriptorCount == layout_binding.descriptorCount && "Named descriptor count does not match!");
             }
             else
             {
                 DescriptorBinding descriptor_binding{};
-                descriptor_binding.binding = spv_binding.binding;
-                descriptor_binding.set = spv_binding.set;
+                descriptor_binding.binding = reflected_binding.binding;
+                descriptor_binding.set = reflected_binding.set;
                 descriptor_binding.layout_binding = layout_binding;
 
-                named_descriptor_bindings[spv_binding.name] = descriptor_binding;
+                named_descriptor_bindings[reflected_binding.name] = descriptor_binding;
             }
         }
     }
@@ -167,5 +250,9 @@ std::vector<DescriptorBinding> SPIRVReflector::parse_descriptor_bindings(std::ve
         descriptor_bindings.push_back(binding);
     }
 
+    // Hash map order is unspecified, sort so pipeline layouts are generated deterministically
+    std::sort(descriptor_bindings.begin(), descriptor_bindings.end(), [](DescriptorBinding const& lhs, DescriptorBinding const& rhs) {
+        return lhs.set != rhs.set ? lhs.set < rhs.set : lhs.binding < rhs.binding;
+    });
     return descriptor_bindings;
 }
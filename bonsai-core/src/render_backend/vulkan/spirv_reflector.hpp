@@ -5,16 +5,9 @@
 #define VK_NO_PROTOTYPES
 #include <cstdint>
 #include <vector>
-#include <spirv_reflect.h>
 #include <vulkan/vulkan.h>
 #include "render_backend/shader_compiler.hpp"
-
-/// @brief A shader reflect module that consists of the SPIR-V module and the associated entrypoint.
-struct ReflectModule
-{
-    SpvReflectShaderModule spv_module;
-    SpvReflectEntryPoint spv_entrypoint;
-};
+#include "render_backend/shader_reflection.hpp"
 
 /// @brief SPIR-V descriptor binding.
 struct DescriptorBinding
@@ -25,6 +18,8 @@ struct DescriptorBinding
 };
 
 /// @brief Lightweight SPIR-V reflector that allows reflecting shader IO data from SPIR-V bytecode blobs.
+/// Shaders are reflected into ShaderReflectionData first, which can be cached & used to create reflectors without
+/// parsing SPIR-V again.
 class SPIRVReflector
 {
 public:
@@ -34,11 +29,21 @@ public:
     /// @brief Create a SPIR-V Reflector for multiple shaders, this will combine push constants and bindings into
     /// a unified shader interface.
     SPIRVReflector(IDxcBlob** shader_sources, uint32_t source_count);
-    ~SPIRVReflector();
+
+    /// @brief Create a SPIR-V Reflector from previously reflected shaders, this will combine push constants and bindings
+    /// into a unified shader interface.
+    SPIRVReflector(ShaderReflectionData const* reflections, uint32_t reflection_count);
+    ~SPIRVReflector() = default;
 
     SPIRVReflector(SPIRVReflector const&) = default;
     SPIRVReflector& operator=(SPIRVReflector const&) = default;
 
+    /// @brief Reflect a single SPIR-V shader.
+    /// @param shader_source SPIR-V shader blob, must contain a single entrypoint.
+    /// @param reflection Output reflection data.
+    /// @return A boolean indicating successful reflection.
+    static bool reflect(IDxcBlob* shader_source, ShaderReflectionData& reflection);
+
     /// @brief Get the shader workgroup size. Only applicable to compute shaders.
     /// @param x Local size in the x dimension.
     /// @param y Local size in the y dimension.
@@ -51,7 +56,7 @@ public:
     uint32_t get_push_constant_range_count() const;
 
     /// @brief Get the shader pipeline push constants.
-    /// @return The unique push constant ranges for the shaders in the reflector.
+    /// @return The unique push constant ranges for the shaders in the reflector, sorted by offset.
     [[nodiscard]]
     VkPushConstantRange const* get_push_constant_ranges() const;
 
@@ -61,31 +66,32 @@ public:
     uint32_t get_descriptor_binding_count() const;
 
     /// @brief Get the descriptor bindings for the shaders in the reflector.
-    /// @return the deduplicated descriptor bindings for the shaders in the reflector.
+    /// @return the deduplicated descriptor bindings for the shaders in the reflector, sorted by set & binding.
     [[nodiscard]]
     DescriptorBinding const* get_descriptor_bindings() const;
 
+    /// @brief Find the constant ID of a named specialization constant.
+    /// @param stage Shader stage to search, only shaders of this stage are searched.
+    /// @param name Specialization constant name as declared in the shader.
+    /// @param constant_id Output specialization constant ID, set only if the constant is found.
+    /// @return A boolean indicating if the shader stage declares the constant.
+    bool find_specialization_constant(VkShaderStageFlagBits stage, char const* name, uint32_t& constant_id) const;
+
 private:
-    /// @brief Parse shader source blobs into a list of reflect modules.
-    /// @param shader_sources SPIR-V source blob array.
-    /// @param source_count Number of shader sources in the source blob array.
-    /// @return A list of reflect modules.
-    static std::vector<ReflectModule> parse_reflect_modules(IDxcBlob** shader_sources, uint32_t source_count);
-
-    /// @brief Parse push constant ranges from a list of shader reflect modules.
-    /// @param reflect_modules The list of shader reflect modules to parse.
+    /// @brief Parse push constant ranges from a list of shader reflections.
+    /// @param reflections The list of shader reflections to parse.
     /// @return A list of used push constant ranges.
-    static std::vector<VkPushConstantRange> parse_push_constant_ranges(std::vector<ReflectModule> const& reflect_modules);
+    static std::vector<VkPushConstantRange> parse_push_constant_ranges(std::vector<ShaderReflectionData> const& reflections);
 
-    /// @brief Parse descriptor bindings from a list of shader reflect modules.
-    /// @param reflect_modules The list of shader reflect modules to parse.
+    /// @brief Parse descriptor bindings from a list of shader reflections.
+    /// @param reflections The list of shader reflections to parse.
     /// @return A list of used descriptor bindings.
-    static std::vector<DescriptorBinding> parse_descriptor_bindings(std::vector<ReflectModule> const& reflect_modules);
+    static std::vector<DescriptorBinding> parse_descriptor_bindings(std::vector<ShaderReflectionData> const& reflections);
 
 private:
-    std::vector<ReflectModule> m_reflect_modules;
+    std::vector<ShaderReflectionData> m_reflections;
     std::vector<VkPushConstantRange> m_push_constant_ranges;
     std::vector<DescriptorBinding> m_descriptor_bindings;
 };
 
-#endif //BONSAI_RENDERER_SPIRV_REFLECTOR_HPP
\ No newline at end of file
+#endif //BONSAI_RENDERER_SPIRV_REFLECTOR_HPP
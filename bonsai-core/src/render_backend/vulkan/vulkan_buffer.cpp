@@ -21,6 +21,11 @@ VulkanBuffer::~VulkanBuffer()
 bool VulkanBuffer::map(void** data, [[maybe_unused]] size_t size, size_t offset)
 {
     BONSAI_ASSERT(data != nullptr && "Pointer to data block was NULL!");
+    if (m_allocation == VK_NULL_HANDLE)
+    {
+        return false; // Aliased buffers are placed in device local heaps
+    }
+
 	void* buffer_data = nullptr;
     if (VK_FAILED(vmaMapMemory(m_allocator, m_allocation, &buffer_data)))
     {
@@ -35,3 +40,41 @@ void VulkanBuffer::unmap()
 {
     vmaUnmapMemory(m_allocator, m_allocation);
 }
+
+bool VulkanBuffer::transition(
+    VkPipelineStageFlags2 stage_mask,
+    VkAccessFlags2 access_mask,
+    VkPipelineStageFlags2& src_stage_mask,
+    VkAccessFlags2& src_access_mask
+)
+{
+    // Buffers have no layout, so the image barrier rules apply with a fixed layout
+    ImageSubresourceState const previous_state{ VK_IMAGE_LAYOUT_UNDEFINED, m_stage_mask, m_access_mask };
+    ImageSubresourceState const next_state{ VK_IMAGE_LAYOUT_UNDEFINED, stage_mask, access_mask };
+    if (!ImageStateTracker::needs_barrier(previous_state, next_state))
+    {
+        return false;
+    }
+
+    src_stage_mask = m_stage_mask;
+    src_access_mask = m_access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS;
+    if ((m_access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS) == 0 && (access_mask & BONSAI_VULKAN_WRITE_ACCESS_FLAGS) == 0)
+    {
+        // Read only accesses accumulate, later reads in either stage can skip the dependency
+        m_stage_mask |= stage_mask;
+        m_access_mask |= access_mask;
+    }
+    else
+    {
+        m_stage_mask = stage_mask;
+        m_access_mask = access_mask;
+    }
+
+    return true;
+}
+
+void VulkanBuffer::alias(VkPipelineStageFlags2 stage_mask, VkAccessFlags2 access_mask)
+{
+    m_stage_mask |= stage_mask;
+    m_access_mask |= access_mask;
+}
@@ -5,6 +5,7 @@
 #include <volk.h>
 #include <vk_mem_alloc.h>
 #include "bonsai/render_backend/render_backend.hpp"
+#include "image_state_tracker.hpp"
 
 /// @brief Buffer description, stores metadata used to create a buffer.
 struct VulkanBufferDesc
@@ -27,6 +28,26 @@ public:
 
     void unmap() override;
 
+    /// @brief Transition the buffer to a new access state.
+    /// Read after read accesses do not require a dependency if the previous state already covers the access.
+    /// @param stage_mask Pipeline stages of the next access.
+    /// @param access_mask Access types of the next access.
+    /// @param src_stage_mask Output source stages for the required memory dependency.
+    /// @param src_access_mask Output source access types for the required memory dependency.
+    /// @return A boolean indicating if a memory dependency is required.
+    bool transition(
+        VkPipelineStageFlags2 stage_mask,
+        VkAccessFlags2 access_mask,
+        VkPipelineStageFlags2& src_stage_mask,
+        VkAccessFlags2& src_access_mask
+    );
+
+    /// @brief Hand over the buffer memory from other aliased resources, the buffer contents become undefined.
+    /// The next transition waits on the given accesses as well as the last buffer access.
+    /// @param stage_mask Pipeline stages of the last accesses to the aliased memory.
+    /// @param access_mask Access types of the last accesses to the aliased memory.
+    void alias(VkPipelineStageFlags2 stage_mask, VkAccessFlags2 access_mask);
+
     /// @brief Get the underlying Vulkan buffer.
     /// @return The underlying Vulkan buffer handle.
     [[nodiscard]]
@@ -37,6 +58,8 @@ private:
     VkBuffer m_buffer = VK_NULL_HANDLE;
     VmaAllocation m_allocation = VK_NULL_HANDLE;
     VulkanBufferDesc m_desc = {};
+    VkPipelineStageFlags2 m_stage_mask = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 m_access_mask = VK_ACCESS_2_NONE;
 };
 
 #endif //BONSAI_RENDERER_VULKAN_BUFFER_HPP
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "vulkan_depth_pyramid_pass.hpp"
+
+#include <cstring>
+#include <iterator>
+#include "bonsai/core/assert.hpp"
+#include "bonsai/core/fatal_exit.hpp"
+#include "bonsai/core/logger.hpp"
+#include "render_backend/builtin_shaders.hpp"
+#include "vk_check.hpp"
+#include "vulkan_render_commands.hpp"
+
+VulkanDepthPyramidPass::VulkanDepthPyramidPass(VkDevice device, VmaAllocator allocator, VulkanShaderPipeline* pipeline)
+    :
+    m_device(device),
+    m_allocator(allocator),
+    m_pipeline(pipeline)
+{
+    BONSAI_ASSERT(m_pipeline != nullptr && "Depth pyramid pipeline was NULL!");
+    BONSAI_ASSERT(m_pipeline->get_descriptor_set_layouts().size() == 1 && "Depth pyramid pipeline must have exactly 1 descriptor set!");
+
+    VkDescriptorPoolSize const pool_sizes[] = {
+        { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, BONSAI_MAX_DEPTH_PYRAMIDS_PER_FRAME },
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, BONSAI_MAX_DEPTH_PYRAMIDS_PER_FRAME * BONSAI_MAX_DEPTH_PYRAMID_MIPS },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, BONSAI_MAX_DEPTH_PYRAMIDS_PER_FRAME },
+    };
+
+    VkDescriptorPoolCreateInfo descriptor_pool_create_info{};
+    descriptor_pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptor_pool_create_info.pNext = nullptr;
+    descriptor_pool_create_info.flags = 0;
+    descriptor_pool_create_info.maxSets = BONSAI_MAX_DEPTH_PYRAMIDS_PER_FRAME;
+    descriptor_pool_create_info.poolSizeCount = static_cast<uint32_t>(std::size(pool_sizes));
+    descriptor_pool_create_info.pPoolSizes = pool_sizes;
+
+    if (VK_FAILED(vkCreateDescriptorPool(m_device, &descriptor_pool_create_info, nullptr, &m_descriptor_pool)))
+    {
+        BONSAI_FATAL_EXIT("Failed to create Vulkan depth pyramid descriptor pool\n");
+    }
+
+    // The shader resets the counter once the last workgroup finishes, so it only needs to be zeroed once here
+    VkBufferCreateInfo counter_buffer_create_info{};
+    counter_buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    counter_buffer_create_info.pNext = nullptr;
+    counter_buffer_create_info.flags = 0;
+    counter_buffer_create_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    counter_buffer_create_info.size = sizeof(uint32_t);
+    counter_buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    counter_buffer_create_info.queueFamilyIndexCount = 0;
+    counter_buffer_create_info.pQueueFamilyIndices = nullptr;
+
+    VmaAllocationCreateInfo counter_allocation_create_info{};
+    counter_allocation_create_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    counter_allocation_create_info.usage = VMA_MEMORY_USAGE_AUTO;
+    counter_allocation_create_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    counter_allocation_create_info.preferredFlags = 0;
+    counter_allocation_create_info.memoryTypeBits = UINT32_MAX;
+    counter_allocation_create_info.pool = VK_NULL_HANDLE;
+    counter_allocation_create_info.pUserData = nullptr;
+    counter_allocation_create_info.priority = 1.0F;
+
+    VmaAllocationInfo counter_allocation_info{};
+    if (VK_FAILED(vmaCreateBuffer(
+        m_allocator,
+        &counter_buffer_create_info,
+        &counter_allocation_create_info,
+        &m_counter_buffer,
+        &m_counter_allocation,
+        &counter_allocation_info
+    )))
+    {
+        BONSAI_FATAL_EXIT("Failed to create Vulkan depth pyramid counter buffer\n");
+    }
+    std::memset(counter_allocation_info.pMappedData, 0, sizeof(uint32_t));
+}
+
+VulkanDepthPyramidPass::~VulkanDepthPyramidPass()
+{
+    vmaDestroyBuffer(m_allocator, m_counter_buffer, m_counter_allocation);
+    vkDestroyDescriptorPool(m_device, m_descriptor_pool, nullptr);
+    delete m_pipeline;
+}
+
+void VulkanDepthPyramidPass::reset()
+{
+    vkResetDescriptorPool(m_device, m_descriptor_pool, 0);
+}
+
+void VulkanDepthPyramidPass::record(VulkanRenderCommands& commands, VulkanTexture* depth_texture, VulkanTexture* depth_pyramid)
+{
+    BONSAI_ASSERT(depth_texture != nullptr && "Depth texture was NULL!");
+    BONSAI_ASSERT(depth_pyramid != nullptr && "Depth pyramid was NULL!");
+    BONSAI_ASSERT(depth_texture->get_image_aspect() == VK_IMAGE_ASPECT_DEPTH_BIT && "Depth pyramid source must be a depth-only texture!");
+    BONSAI_ASSERT(depth_texture->array_layers() == 1 && "Depth pyramid source must be a single layer texture!");
+    BONSAI_ASSERT(depth_pyramid->mip_levels() <= BONSAI_MAX_DEPTH_PYRAMID_MIPS && "Depth pyramid has too many mip levels!");
+
+    RenderExtent3D const source_extent = depth_texture->extent();
+    RenderExtent3D const pyramid_extent = depth_pyramid->extent();
+    uint32_t const workgroups_x = (source_extent.width + BONSAI_DEPTH_PYRAMID_TILE_SIZE - 1) / BONSAI_DEPTH_PYRAMID_TILE_SIZE;
+    uint32_t const workgroups_y = (source_extent.height + BONSAI_DEPTH_PYRAMID_TILE_SIZE - 1) / BONSAI_DEPTH_PYRAMID_TILE_SIZE;
+
+    // Edge texels cover at most one extra row or column of the previous level, which requires a half resolution pyramid
+    BONSAI_ASSERT(source_extent.width <= pyramid_extent.width * 2 + 1 && source_extent.height <= pyramid_extent.height * 2 + 1
+        && pyramid_extent.width * 2 <= source_extent.width + 1 && pyramid_extent.height * 2 <= source_extent.height + 1
+        && "Depth pyramid extent must be half the source extent!");
+
+    // The last workgroup reduces mip 5 as a single 64x64 tile, which limits the source size to 4096x4096
+    BONSAI_ASSERT(workgroups_x <= BONSAI_DEPTH_PYRAMID_TILE_SIZE && workgroups_y <= BONSAI_DEPTH_PYRAMID_TILE_SIZE
+        && "Depth pyramid source texture is too large!");
+
+    VkDescriptorSetLayout const set_layout = m_pipeline->get_descriptor_set_layouts()[0];
+    VkDescriptorSetAllocateInfo set_allocate_info{};
+    set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    set_allocate_info.pNext = nullptr;
+    set_allocate_info.descriptorPool = m_descriptor_pool;
+    set_allocate_info.descriptorSetCount = 1;
+    set_allocate_info.pSetLayouts = &set_layout;
+
+    VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+    if (VK_FAILED(vkAllocateDescriptorSets(m_device, &set_allocate_info, &descriptor_set)))
+    {
+        BONSAI_ENGINE_LOG_ERROR("Failed to allocate depth pyramid descriptor set, max {} pyramids per frame", BONSAI_MAX_DEPTH_PYRAMIDS_PER_FRAME);
+        return;
+    }
+
+    // Unused pyramid slots alias the last mip, stores to them are skipped by the shader
+    VkDescriptorImageInfo depth_image_info{ VK_NULL_HANDLE, depth_texture->get_mip_view(0), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+    VkDescriptorImageInfo pyramid_image_infos[BONSAI_MAX_DEPTH_PYRAMID_MIPS]{};
+    for (uint32_t mip = 0; mip < BONSAI_MAX_DEPTH_PYRAMID_MIPS; mip++)
+    {
+        uint32_t const view_mip = mip < depth_pyramid->mip_levels() ? mip : depth_pyramid->mip_levels() - 1;
+        pyramid_image_infos[mip] = { VK_NULL_HANDLE, depth_pyramid->get_mip_view(view_mip), VK_IMAGE_LAYOUT_GENERAL };
+    }
+    VkDescriptorBufferInfo counter_buffer_info{ m_counter_buffer, 0, sizeof(uint32_t) };
+
+    VkWriteDescriptorSet descriptor_writes[3]{};
+    descriptor_writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_writes[0].dstSet = descriptor_set;
+    descriptor_writes[0].dstBinding = 0;
+    descriptor_writes[0].descriptorCount = 1;
+    descriptor_writes[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    descriptor_writes[0].pImageInfo = &depth_image_info;
+
+    descriptor_writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_writes[1].dstSet = descriptor_set;
+    descriptor_writes[1].dstBinding = 1;
+    descriptor_writes[1].descriptorCount = BONSAI_MAX_DEPTH_PYRAMID_MIPS;
+    descriptor_writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    descriptor_writes[1].pImageInfo = pyramid_image_infos;
+
+    descriptor_writes[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_writes[2].dstSet = descriptor_set;
+    descriptor_writes[2].dstBinding = 2;
+    descriptor_writes[2].descriptorCount = 1;
+    descriptor_writes[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptor_writes[2].pBufferInfo = &counter_buffer_info;
+
+    vkUpdateDescriptorSets(m_device, static_cast<uint32_t>(std::size(descriptor_writes)), descriptor_writes, 0, nullptr);
+
+    // Transition the depth texture for sampling and the pyramid for storage writes, previous pyramid contents are discarded
+    ImageSubresourceState const depth_read_state{
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+    };
+    ImageSubresourceState const pyramid_write_state{
+        VK_IMAGE_LAYOUT_GENERAL,
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+    };
+
+    commands.transition_texture(depth_texture, depth_texture->get_subresource_range(0, 1, 0, 1), depth_read_state, false);
+    commands.transition_texture(depth_pyramid, depth_pyramid->get_subresource_range(), pyramid_write_state, true);
+
+    // Previous dispatches reset the atomic counter, make sure that write is visible before this dispatch starts
+    commands.add_memory_dependency(
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+    );
+
+    DepthPyramidConstants constants{};
+    constants.source_extent[0] = source_extent.width;
+    constants.source_extent[1] = source_extent.height;
+    constants.pyramid_extent[0] = pyramid_extent.width;
+    constants.pyramid_extent[1] = pyramid_extent.height;
+    constants.mip_count = depth_pyramid->mip_levels();
+    constants.workgroup_count = workgroups_x * workgroups_y;
+
+    VkCommandBuffer const command_buffer = commands.get_command_buffer();
+    commands.flush_barriers();
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline->get_pipeline());
+    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline->get_pipeline_layout(), 0, 1, &descriptor_set, 0, nullptr);
+    vkCmdPushConstants(command_buffer, m_pipeline->get_pipeline_layout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(DepthPyramidConstants), &constants);
+    vkCmdDispatch(command_buffer, workgroups_x, workgroups_y, 1);
+}
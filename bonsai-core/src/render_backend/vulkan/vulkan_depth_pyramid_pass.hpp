@@ -0,0 +1,45 @@
+#pragma once
+#ifndef BONSAI_RENDERER_VULKAN_DEPTH_PYRAMID_PASS_HPP
+#define BONSAI_RENDERER_VULKAN_DEPTH_PYRAMID_PASS_HPP
+
+#include <volk.h>
+#include <vk_mem_alloc.h>
+#include "vulkan_shader_pipeline.hpp"
+#include "vulkan_texture.hpp"
+
+class VulkanRenderCommands;
+
+/// @brief Maximum number of depth pyramids that can be generated in a single frame.
+static constexpr uint32_t BONSAI_MAX_DEPTH_PYRAMIDS_PER_FRAME = 16;
+
+/// @brief The depth pyramid pass records the single dispatch hierarchical depth downsampler.
+/// It owns the pipeline, descriptor pool and the global atomic counter used by the shader.
+class VulkanDepthPyramidPass
+{
+public:
+    VulkanDepthPyramidPass() = default;
+    VulkanDepthPyramidPass(VkDevice device, VmaAllocator allocator, VulkanShaderPipeline* pipeline);
+    ~VulkanDepthPyramidPass();
+
+    VulkanDepthPyramidPass(VulkanDepthPyramidPass const&) = delete;
+    VulkanDepthPyramidPass& operator=(VulkanDepthPyramidPass const&) = delete;
+
+    /// @brief Reset the per-frame descriptor allocations, may only be called once the previous frame has finished.
+    void reset();
+
+    /// @brief Record a depth pyramid generation dispatch, including the barriers required for the pass.
+    /// @param commands Render commands to record into.
+    /// @param depth_texture Depth texture to downsample.
+    /// @param depth_pyramid Depth pyramid texture, one mip level per pyramid level.
+    void record(VulkanRenderCommands& commands, VulkanTexture* depth_texture, VulkanTexture* depth_pyramid);
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    VmaAllocator m_allocator = VK_NULL_HANDLE;
+    VulkanShaderPipeline* m_pipeline = nullptr;
+    VkDescriptorPool m_descriptor_pool = VK_NULL_HANDLE;
+    VkBuffer m_counter_buffer = VK_NULL_HANDLE;
+    VmaAllocation m_counter_allocation = VK_NULL_HANDLE;
+};
+
+#endif //BONSAI_RENDERER_VULKAN_DEPTH_PYRAMID_PASS_HPP
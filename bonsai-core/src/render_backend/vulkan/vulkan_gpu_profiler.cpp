@@ -0,0 +1,245 @@
+#include "vulkan_gpu_profiler.hpp"
+
+#include "bonsai/core/assert.hpp"
+#include "bonsai/core/fatal_exit.hpp"
+#include "vk_check.hpp"
+
+/// @brief Sentinel scope index for scopes dropped because the frame scope limit was reached.
+static constexpr uint32_t DROPPED_SCOPE = UINT32_MAX;
+
+/// @brief Number of timestamp queries per frame, each scope writes a begin & end timestamp.
+static constexpr uint32_t QUERIES_PER_FRAME = 2 * BONSAI_VULKAN_PROFILER_MAX_SCOPES;
+
+/// @brief Gathered pipeline statistics, results are written in statistic bit order.
+static constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTICS = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT
+    | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT
+    | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT
+    | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+    | VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+/// @brief Number of values per statistics query result, the gathered statistics followed by the availability value.
+static constexpr uint32_t STATISTICS_RESULT_SIZE = 6;
+
+VulkanGpuProfiler::VulkanGpuProfiler(VkDevice device, float timestamp_period, uint32_t timestamp_valid_bits, bool pipeline_statistics_supported)
+    :
+    m_device(device),
+    m_timestamp_period(static_cast<double>(timestamp_period)),
+    m_pipeline_statistics_supported(pipeline_statistics_supported)
+{
+    if (timestamp_valid_bits == 0)
+    {
+        return; // Queue does not support timestamps, scopes are ignored
+    }
+    m_timestamp_mask = timestamp_valid_bits >= 64 ? UINT64_MAX : (1ULL << timestamp_valid_bits) - 1;
+
+    VkQueryPoolCreateInfo query_pool_create_info{};
+    query_pool_create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    query_pool_create_info.pNext = nullptr;
+    query_pool_create_info.flags = 0;
+    query_pool_create_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    query_pool_create_info.queryCount = QUERIES_PER_FRAME;
+    query_pool_create_info.pipelineStatistics = 0;
+
+    VkQueryPoolCreateInfo statistics_pool_create_info{};
+    statistics_pool_create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    statistics_pool_create_info.pNext = nullptr;
+    statistics_pool_create_info.flags = 0;
+    statistics_pool_create_info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    statistics_pool_create_info.queryCount = BONSAI_VULKAN_PROFILER_MAX_SCOPES;
+    statistics_pool_create_info.pipelineStatistics = PIPELINE_STATISTICS;
+
+    for (auto& frame : m_frames)
+    {
+        if (VK_FAILED(vkCreateQueryPool(m_device, &query_pool_create_info, nullptr, &frame.query_pool)))
+        {
+            BONSAI_FATAL_EXIT("Failed to create Vulkan GPU profiler query pool\n");
+        }
+
+        if (m_pipeline_statistics_supported
+            && VK_FAILED(vkCreateQueryPool(m_device, &statistics_pool_create_info, nullptr, &frame.statistics_pool)))
+        {
+            BONSAI_FATAL_EXIT("Failed to create Vulkan GPU profiler pipeline statistics query pool\n");
+        }
+
+        // Queries must be reset before their first use
+        vkResetQueryPool(m_device, frame.query_pool, 0, QUERIES_PER_FRAME);
+        if (frame.statistics_pool != VK_NULL_HANDLE)
+        {
+            vkResetQueryPool(m_device, frame.statistics_pool, 0, BONSAI_VULKAN_PROFILER_MAX_SCOPES);
+        }
+        frame.scopes.resize(BONSAI_VULKAN_PROFILER_MAX_SCOPES);
+        frame.scope_count = 0;
+    }
+    m_scope_stack.reserve(BONSAI_VULKAN_PROFILER_MAX_SCOPES);
+    m_timestamps.resize(2 * QUERIES_PER_FRAME);
+    m_statistics.resize(STATISTICS_RESULT_SIZE * BONSAI_VULKAN_PROFILER_MAX_SCOPES);
+}
+
+VulkanGpuProfiler::~VulkanGpuProfiler()
+{
+    for (auto const& frame : m_frames)
+    {
+        vkDestroyQueryPool(m_device, frame.statistics_pool, nullptr);
+        vkDestroyQueryPool(m_device, frame.query_pool, nullptr);
+    }
+}
+
+void VulkanGpuProfiler::new_frame(uint64_t frame_index)
+{
+    if (m_timestamp_mask == 0)
+    {
+        return;
+    }
+
+    // The pool was last used BONSAI_VULKAN_PROFILER_FRAME_LATENCY frames ago, so its results are available without waiting
+    Frame& frame = m_frames[frame_index % BONSAI_VULKAN_PROFILER_FRAME_LATENCY];
+    if (frame.scope_count > 0)
+    {
+        resolve(frame);
+        vkResetQueryPool(m_device, frame.query_pool, 0, 2 * frame.scope_count);
+        if (frame.statistics_pool != VK_NULL_HANDLE)
+        {
+            vkResetQueryPool(m_device, frame.statistics_pool, 0, frame.scope_count);
+        }
+    }
+
+    frame.frame_index = frame_index;
+    frame.scope_count = 0;
+    m_current_frame = &frame;
+    m_scope_stack.clear();
+    m_statistics_active = false;
+}
+
+void VulkanGpuProfiler::begin_scope(VkCommandBuffer command_buffer, char const* name, bool pipeline_statistics)
+{
+    if (m_current_frame == nullptr)
+    {
+        return;
+    }
+
+    Frame& frame = *m_current_frame;
+    if (frame.scope_count >= BONSAI_VULKAN_PROFILER_MAX_SCOPES)
+    {
+        m_scope_stack.push_back(DROPPED_SCOPE);
+        return;
+    }
+
+    uint32_t const scope_index = frame.scope_count++;
+    Scope& scope = frame.scopes[scope_index];
+    scope.name = name;
+    scope.parent = m_scope_stack.empty() ? UINT32_MAX : m_scope_stack.back();
+    scope.depth = static_cast<uint32_t>(m_scope_stack.size());
+    scope.has_statistics = pipeline_statistics && m_pipeline_statistics_supported && !m_statistics_active;
+    m_scope_stack.push_back(scope_index);
+
+    vkCmdWriteTimestamp2(command_buffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, frame.query_pool, 2 * scope_index);
+    if (scope.has_statistics)
+    {
+        // Only one pipeline statistics query may be active at a time, nested statistics scopes only gather timings
+        vkCmdBeginQuery(command_buffer, frame.statistics_pool, scope_index, 0);
+        m_statistics_active = true;
+    }
+}
+
+void VulkanGpuProfiler::end_scope(VkCommandBuffer command_buffer)
+{
+    if (m_current_frame == nullptr)
+    {
+        return;
+    }
+
+    BONSAI_ASSERT(!m_scope_stack.empty() && "Ended a GPU profile scope without an open scope!");
+    uint32_t const scope_index = m_scope_stack.back();
+    m_scope_stack.pop_back();
+    if (scope_index == DROPPED_SCOPE)
+    {
+        return;
+    }
+
+    if (m_current_frame->scopes[scope_index].has_statistics)
+    {
+        vkCmdEndQuery(command_buffer, m_current_frame->statistics_pool, scope_index);
+        m_statistics_active = false;
+    }
+
+    vkCmdWriteTimestamp2(command_buffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_current_frame->query_pool, 2 * scope_index + 1);
+}
+
+VkQueryPipelineStatisticFlags VulkanGpuProfiler::get_active_pipeline_statistics() const
+{
+    return m_statistics_active ? PIPELINE_STATISTICS : 0;
+}
+
+void VulkanGpuProfiler::resolve(Frame const& frame)
+{
+    // Results are read as (timestamp, availability) pairs, so unclosed scopes do not invalidate the frame
+    uint32_t const query_count = 2 * frame.scope_count;
+    VkResult const result = vkGetQueryPoolResults(
+        m_device,
+        frame.query_pool,
+        0,
+        query_count,
+        2 * query_count * sizeof(uint64_t),
+        m_timestamps.data(),
+        2 * sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+    );
+    if (result != VK_SUCCESS && result != VK_NOT_READY)
+    {
+        return;
+    }
+
+    // Statistics queries of scopes without statistics are never started, and are reported as unavailable
+    bool statistics_resolved = false;
+    if (frame.statistics_pool != VK_NULL_HANDLE)
+    {
+        VkResult const statistics_result = vkGetQueryPoolResults(
+            m_device,
+            frame.statistics_pool,
+            0,
+            frame.scope_count,
+            STATISTICS_RESULT_SIZE * frame.scope_count * sizeof(uint64_t),
+            m_statistics.data(),
+            STATISTICS_RESULT_SIZE * sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+        );
+        statistics_resolved = statistics_result == VK_SUCCESS || statistics_result == VK_NOT_READY;
+    }
+
+    uint64_t const frame_begin = m_timestamps[0] & m_timestamp_mask;
+    m_resolved_profile.frame_index = frame.frame_index;
+    m_resolved_profile.scopes.resize(frame.scope_count);
+    for (uint32_t i = 0; i < frame.scope_count; i++)
+    {
+        uint64_t const begin = m_timestamps[4 * i + 0] & m_timestamp_mask;
+        bool const begin_available = m_timestamps[4 * i + 1] != 0;
+        uint64_t const end = m_timestamps[4 * i + 2] & m_timestamp_mask;
+        bool const end_available = m_timestamps[4 * i + 3] != 0;
+
+        // Timestamps wrap around at the valid bit count, masking the difference keeps wrapped intervals positive
+        RenderProfileScope& resolved_scope = m_resolved_profile.scopes[i];
+        resolved_scope.name = frame.scopes[i].name;
+        resolved_scope.parent = frame.scopes[i].parent;
+        resolved_scope.depth = frame.scopes[i].depth;
+        resolved_scope.start_ms = begin_available
+            ? static_cast<double>((begin - frame_begin) & m_timestamp_mask) * m_timestamp_period * 1e-6
+            : 0.0;
+        resolved_scope.duration_ms = begin_available && end_available
+            ? static_cast<double>((end - begin) & m_timestamp_mask) * m_timestamp_period * 1e-6
+            : 0.0;
+
+        uint64_t const* statistics = &m_statistics[STATISTICS_RESULT_SIZE * i];
+        resolved_scope.has_pipeline_statistics = statistics_resolved
+            && frame.scopes[i].has_statistics
+            && statistics[STATISTICS_RESULT_SIZE - 1] != 0;
+        resolved_scope.pipeline_statistics = {};
+        if (resolved_scope.has_pipeline_statistics)
+        {
+            resolved_scope.pipeline_statistics.vertex_shader_invocations = statistics[0];
+            resolved_scope.pipeline_statistics.clipping_invocations = statistics[1];
+            resolved_scope.pipeline_statistics.clipping_primitives = statistics[2];
+            resolved_scope.pipeline_statistics.fragment_shader_invocations = statistics[3];
+            resolved_scope.pipeline_statistics.compute_shader_invocations = statistics[4];
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+#ifndef BONSAI_RENDERER_VULKAN_GPU_PROFILER_HPP
+#define BONSAI_RENDERER_VULKAN_GPU_PROFILER_HPP
+
+#include <string>
+#include <vector>
+#include <volk.h>
+#include "bonsai/render_backend/render_backend.hpp"
+
+/// @brief Number of frames between recording & resolving GPU timestamps, results are read without waiting on the GPU.
+static constexpr uint32_t BONSAI_VULKAN_PROFILER_FRAME_LATENCY = 3;
+
+/// @brief Maximum number of profile scopes per frame, scopes beyond this limit are dropped.
+static constexpr uint32_t BONSAI_VULKAN_PROFILER_MAX_SCOPES = 512;
+
+/// @brief The GPU profiler records timestamp queries around profile scopes.
+/// Each frame uses its own query pool from a ring of pools, a pool is resolved & reset when it is reused.
+class VulkanGpuProfiler
+{
+public:
+    VulkanGpuProfiler() = default;
+
+    /// @brief Create a new GPU profiler.
+    /// @param device Vulkan device.
+    /// @param timestamp_period Number of nanoseconds per timestamp tick.
+    /// @param timestamp_valid_bits Number of valid timestamp bits for the profiled queue, zero disables profiling.
+    /// @param pipeline_statistics_supported Set if pipeline statistics & inherited queries are enabled on the device.
+    VulkanGpuProfiler(VkDevice device, float timestamp_period, uint32_t timestamp_valid_bits, bool pipeline_statistics_supported);
+    ~VulkanGpuProfiler();
+
+    VulkanGpuProfiler(VulkanGpuProfiler const&) = delete;
+    VulkanGpuProfiler& operator=(VulkanGpuProfiler const&) = delete;
+
+    /// @brief Start profiling a new frame, resolving the results of the frame that last used the same query pool.
+    /// May only be called once the previous frame has finished.
+    /// @param frame_index Index of the new frame.
+    void new_frame(uint64_t frame_index);
+
+    /// @brief Record the start of a profile scope.
+    /// @param command_buffer Command buffer to record into.
+    /// @param name Scope name.
+    /// @param pipeline_statistics Gather pipeline statistics if supported & no statistics scope is active.
+    void begin_scope(VkCommandBuffer command_buffer, char const* name, bool pipeline_statistics);
+
+    /// @brief Record the end of the innermost open profile scope.
+    /// @param command_buffer Command buffer to record into.
+    void end_scope(VkCommandBuffer command_buffer);
+
+    /// @brief Get the pipeline statistics gathered by the active statistics scope.
+    /// Secondary command buffers executed while a statistics scope is active must inherit these statistics.
+    /// @return The active pipeline statistic flags, zero if no statistics scope is active.
+    [[nodiscard]]
+    VkQueryPipelineStatisticFlags get_active_pipeline_statistics() const;
+
+    /// @brief Get the profile of the most recently resolved frame.
+    /// @return The resolved GPU profile.
+    [[nodiscard]]
+    RenderGpuProfile const& get_resolved_profile() const { return m_resolved_profile; }
+
+private:
+    /// @brief Profile scope recorded in a frame.
+    struct Scope
+    {
+        std::string name;
+        uint32_t parent;
+        uint32_t depth;
+        bool has_statistics;
+    };
+
+    /// @brief Per frame query pools & recorded scopes, scope i uses timestamp queries 2i & 2i + 1 and statistics query i.
+    struct Frame
+    {
+        VkQueryPool query_pool;
+        VkQueryPool statistics_pool;
+        uint64_t frame_index;
+        std::vector<Scope> scopes;
+        uint32_t scope_count;
+    };
+
+    /// @brief Resolve the recorded timestamps of a frame into the resolved profile.
+    /// @param frame Frame to resolve.
+    void resolve(Frame const& frame);
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    double m_timestamp_period = 1.0;
+    uint64_t m_timestamp_mask = 0;
+    bool m_pipeline_statistics_supported = false;
+    bool m_statistics_active = false;
+    Frame m_frames[BONSAI_VULKAN_PROFILER_FRAME_LATENCY] = {};
+    Frame* m_current_frame = nullptr;
+    std::vector<uint32_t> m_scope_stack = {};
+    std::vector<uint64_t> m_timestamps = {};
+    std::vector<uint64_t> m_statistics = {};
+    RenderGpuProfile m_resolved_profile = {};
+};
+
+#endif //BONSAI_RENDERER_VULKAN_GPU_PROFILER_HPP
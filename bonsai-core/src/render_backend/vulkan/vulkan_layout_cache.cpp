@@ -0,0 +1,152 @@
+#include "vulkan_layout_cache.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <volk.h>
+#include "render_backend/vulkan/vk_check.hpp"
+
+/// @brief Append a raw value to a cache key.
+template<typename Type>
+static void append_key_value(std::string& key, Type const& value)
+{
+    key.append(reinterpret_cast<char const*>(&value), sizeof(Type));
+}
+
+VulkanLayoutCache::VulkanLayoutCache(VkDevice device)
+    :
+    m_device(device)
+{
+    //
+}
+
+VulkanLayoutCache::~VulkanLayoutCache()
+{
+    for (auto const& [ key, pipeline_layout ] : m_pipeline_layouts)
+    {
+        vkDestroyPipelineLayout(m_device, pipeline_layout, nullptr);
+    }
+
+    for (auto const& [ key, descriptor_set_layout ] : m_descriptor_set_layouts)
+    {
+        vkDestroyDescriptorSetLayout(m_device, descriptor_set_layout, nullptr);
+    }
+}
+
+VkDescriptorSetLayout VulkanLayoutCache::get_descriptor_set_layout(VkDescriptorSetLayoutBinding const* bindings, uint32_t binding_count)
+{
+    std::string key = get_descriptor_set_layout_key(bindings, binding_count);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_descriptor_set_layouts.find(key);
+    if (it != m_descriptor_set_layouts.end())
+    {
+        return it->second;
+    }
+
+    VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info{};
+    descriptor_set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptor_set_layout_create_info.pNext = nullptr;
+    descriptor_set_layout_create_info.flags = 0;
+    descriptor_set_layout_create_info.bindingCount = binding_count;
+    descriptor_set_layout_create_info.pBindings = bindings;
+
+    VkDescriptorSetLayout descriptor_set_layout = VK_NULL_HANDLE;
+    if (VK_FAILED(vkCreateDescriptorSetLayout(m_device, &descriptor_set_layout_create_info, nullptr, &descriptor_set_layout)))
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    m_descriptor_set_layouts.emplace(std::move(key), descriptor_set_layout);
+    return descriptor_set_layout;
+}
+
+VkPipelineLayout VulkanLayoutCache::get_pipeline_layout(
+    VkDescriptorSetLayout const* set_layouts,
+    uint32_t set_layout_count,
+    VkPushConstantRange const* push_constant_ranges,
+    uint32_t push_constant_range_count
+)
+{
+    std::string key = get_pipeline_layout_key(set_layouts, set_layout_count, push_constant_ranges, push_constant_range_count);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_pipeline_layouts.find(key);
+    if (it != m_pipeline_layouts.end())
+    {
+        return it->second;
+    }
+
+    VkPipelineLayoutCreateInfo pipeline_layout_create_info{};
+    pipeline_layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_layout_create_info.pNext = nullptr;
+    pipeline_layout_create_info.flags = 0;
+    pipeline_layout_create_info.setLayoutCount = set_layout_count;
+    pipeline_layout_create_info.pSetLayouts = set_layouts;
+    pipeline_layout_create_info.pushConstantRangeCount = push_constant_range_count;
+    pipeline_layout_create_info.pPushConstantRanges = push_constant_ranges;
+
+    VkPipelineLayout pipeline_layout = VK_NULL_HANDLE;
+    if (VK_FAILED(vkCreatePipelineLayout(m_device, &pipeline_layout_create_info, nullptr, &pipeline_layout)))
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    m_pipeline_layouts.emplace(std::move(key), pipeline_layout);
+    return pipeline_layout;
+}
+
+size_t VulkanLayoutCache::get_descriptor_set_layout_count()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_descriptor_set_layouts.size();
+}
+
+size_t VulkanLayoutCache::get_pipeline_layout_count()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pipeline_layouts.size();
+}
+
+std::string VulkanLayoutCache::get_descriptor_set_layout_key(VkDescriptorSetLayoutBinding const* bindings, uint32_t binding_count)
+{
+    std::vector<VkDescriptorSetLayoutBinding> sorted_bindings(bindings, bindings + binding_count);
+    std::sort(sorted_bindings.begin(), sorted_bindings.end(), [](VkDescriptorSetLayoutBinding const& lhs, VkDescriptorSetLayoutBinding const& rhs) {
+        return lhs.binding < rhs.binding;
+    });
+
+    std::string key{};
+    key.reserve(sizeof(uint32_t) * 4 * sorted_bindings.size());
+    for (auto const& binding : sorted_bindings)
+    {
+        append_key_value(key, binding.binding);
+        append_key_value(key, binding.descriptorType);
+        append_key_value(key, binding.descriptorCount);
+        append_key_value(key, binding.stageFlags);
+        append_key_value(key, binding.pImmutableSamplers); // Immutable sampler arrays are compared by address
+    }
+
+    return key;
+}
+
+std::string VulkanLayoutCache::get_pipeline_layout_key(
+    VkDescriptorSetLayout const* set_layouts,
+    uint32_t set_layout_count,
+    VkPushConstantRange const* push_constant_ranges,
+    uint32_t push_constant_range_count
+)
+{
+    // Set layouts are deduplicated by the cache, so equal set layouts share a handle & the handle identifies the layout
+    std::string key{};
+    append_key_value(key, set_layout_count);
+    for (uint32_t i = 0; i < set_layout_count; i++)
+    {
+        append_key_value(key, set_layouts[i]);
+    }
+
+    for (uint32_t i = 0; i < push_constant_range_count; i++)
+    {
+        append_key_value(key, push_constant_ranges[i].stageFlags);
+        append_key_value(key, push_constant_ranges[i].offset);
+        append_key_value(key, push_constant_ranges[i].size);
+    }
+
+    return key;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef BONSAI_RENDERER_VULKAN_LAYOUT_CACHE_HPP
+#define BONSAI_RENDERER_VULKAN_LAYOUT_CACHE_HPP
+
+#define VK_NO_PROTOTYPES
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vulkan/vulkan.h>
+
+/// @brief The layout cache deduplicates descriptor set layouts & pipeline layouts, keyed on their binding description.
+/// Pipelines with the same shader interface share layouts, so descriptor sets can be reused across those pipelines.
+/// Layouts are owned by the cache & destroyed with it, pipelines only reference them.
+class VulkanLayoutCache
+{
+public:
+    VulkanLayoutCache() = default;
+    explicit VulkanLayoutCache(VkDevice device);
+    ~VulkanLayoutCache();
+
+    VulkanLayoutCache(VulkanLayoutCache const&) = delete;
+    VulkanLayoutCache& operator=(VulkanLayoutCache const&) = delete;
+
+    /// @brief Get or create a descriptor set layout.
+    /// @param bindings Descriptor set layout bindings, binding order does not affect the returned layout.
+    /// @param binding_count Number of layout bindings.
+    /// @return A descriptor set layout, or VK_NULL_HANDLE on failure.
+    VkDescriptorSetLayout get_descriptor_set_layout(VkDescriptorSetLayoutBinding const* bindings, uint32_t binding_count);
+
+    /// @brief Get or create a pipeline layout.
+    /// @param set_layouts Descriptor set layouts, should be created by this cache so equal layouts share a handle.
+    /// @param set_layout_count Number of descriptor set layouts.
+    /// @param push_constant_ranges Push constant ranges.
+    /// @param push_constant_range_count Number of push constant ranges.
+    /// @return A pipeline layout, or VK_NULL_HANDLE on failure.
+    VkPipelineLayout get_pipeline_layout(
+        VkDescriptorSetLayout const* set_layouts,
+        uint32_t set_layout_count,
+        VkPushConstantRange const* push_constant_ranges,
+        uint32_t push_constant_range_count
+    );
+
+    /// @brief Get the number of cached descriptor set layouts.
+    [[nodiscard]]
+    size_t get_descriptor_set_layout_count();
+
+    /// @brief Get the number of cached pipeline layouts.
+    [[nodiscard]]
+    size_t get_pipeline_layout_count();
+
+    /// @brief Get the cache key for a descriptor set layout, bindings are sorted by binding index.
+    static std::string get_descriptor_set_layout_key(VkDescriptorSetLayoutBinding const* bindings, uint32_t binding_count);
+
+    /// @brief Get the cache key for a pipeline layout.
+    static std::string get_pipeline_layout_key(
+        VkDescriptorSetLayout const* set_layouts,
+        uint32_t set_layout_count,
+        VkPushConstantRange const* push_constant_ranges,
+        uint32_t push_constant_range_count
+    );
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    std::mutex m_mutex;
+    std::unordered_map<std::string, VkDescriptorSetLayout> m_descriptor_set_layouts = {};
+    std::unordered_map<std::string, VkPipelineLayout> m_pipeline_layouts = {};
+};
+
+#endif //BONSAI_RENDERER_VULKAN_LAYOUT_CACHE_HPP
@@ -0,0 +1,15 @@
+#include "vulkan_memory_heap.hpp"
+
+VulkanMemoryHeap::VulkanMemoryHeap(VmaAllocator allocator, VmaAllocation allocation, size_t size)
+    :
+    m_allocator(allocator),
+    m_allocation(allocation),
+    m_size(size)
+{
+    //
+}
+
+VulkanMemoryHeap::~VulkanMemoryHeap()
+{
+    vmaFreeMemory(m_allocator, m_allocation);
+}
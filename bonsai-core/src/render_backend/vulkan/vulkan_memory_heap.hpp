@@ -0,0 +1,31 @@
+#pragma once
+#ifndef BONSAI_RENDERER_VULKAN_MEMORY_HEAP_HPP
+#define BONSAI_RENDERER_VULKAN_MEMORY_HEAP_HPP
+
+#include <volk.h>
+#include <vk_mem_alloc.h>
+#include "bonsai/render_backend/render_backend.hpp"
+
+class VulkanMemoryHeap : public RenderMemoryHeap
+{
+public:
+    VulkanMemoryHeap(VmaAllocator allocator, VmaAllocation allocation, size_t size);
+    ~VulkanMemoryHeap() override;
+
+    VulkanMemoryHeap(VulkanMemoryHeap const&) = delete;
+    VulkanMemoryHeap& operator=(VulkanMemoryHeap const&) = delete;
+
+    size_t size() const override { return m_size; }
+
+    /// @brief Get the underlying VMA allocation, resources are placed in this allocation using VMA aliasing.
+    /// @return The VMA allocation handle.
+    [[nodiscard]]
+    VmaAllocation get_allocation() const { return m_allocation; }
+
+private:
+    VmaAllocator m_allocator = VK_NULL_HANDLE;
+    VmaAllocation m_allocation = VK_NULL_HANDLE;
+    size_t m_size = 0;
+};
+
+#endif //BONSAI_RENDERER_VULKAN_MEMORY_HEAP_HPP
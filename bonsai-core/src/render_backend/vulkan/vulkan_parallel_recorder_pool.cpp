@@ -0,0 +1,75 @@
+#include "vulkan_parallel_recorder_pool.hpp"
+
+#include <algorithm>
+#include <thread>
+#include "bonsai/core/assert.hpp"
+#include "bonsai/core/fatal_exit.hpp"
+#include "vk_check.hpp"
+
+VulkanParallelRecorderPool::VulkanParallelRecorderPool(VkDevice device, uint32_t queue_family)
+    :
+    m_device(device)
+{
+    uint32_t const recorder_count = std::clamp(std::thread::hardware_concurrency(), 1U, BONSAI_VULKAN_MAX_PARALLEL_RECORDERS);
+
+    VkCommandPoolCreateInfo command_pool_create_info{};
+    command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    command_pool_create_info.pNext = nullptr;
+    command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    command_pool_create_info.queueFamilyIndex = queue_family;
+
+    m_recorders.reserve(recorder_count);
+    for (uint32_t i = 0; i < recorder_count; i++)
+    {
+        Recorder recorder{};
+        if (VK_FAILED(vkCreateCommandPool(m_device, &command_pool_create_info, nullptr, &recorder.command_pool)))
+        {
+            BONSAI_FATAL_EXIT("Failed to create Vulkan parallel recorder command pool\n");
+        }
+        m_recorders.push_back(recorder);
+    }
+}
+
+VulkanParallelRecorderPool::~VulkanParallelRecorderPool()
+{
+    for (auto const& recorder : m_recorders)
+    {
+        vkDestroyCommandPool(m_device, recorder.command_pool, nullptr); // Frees the allocated command buffers
+    }
+}
+
+void VulkanParallelRecorderPool::reset()
+{
+    for (auto& recorder : m_recorders)
+    {
+        vkResetCommandPool(m_device, recorder.command_pool, 0);
+        recorder.next_command_buffer = 0;
+    }
+}
+
+VkCommandBuffer VulkanParallelRecorderPool::acquire(uint32_t recorder_index)
+{
+    BONSAI_ASSERT(recorder_index < m_recorders.size() && "Parallel recorder index out of range!");
+    Recorder& recorder = m_recorders[recorder_index];
+    if (recorder.next_command_buffer < recorder.command_buffers.size())
+    {
+        return recorder.command_buffers[recorder.next_command_buffer++];
+    }
+
+    VkCommandBufferAllocateInfo command_buffer_allocate_info{};
+    command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    command_buffer_allocate_info.pNext = nullptr;
+    command_buffer_allocate_info.commandPool = recorder.command_pool;
+    command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    command_buffer_allocate_info.commandBufferCount = 1;
+
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    if (VK_FAILED(vkAllocateCommandBuffers(m_device, &command_buffer_allocate_info, &command_buffer)))
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    recorder.command_buffers.push_back(command_buffer);
+    recorder.next_command_buffer++;
+    return command_buffer;
+}
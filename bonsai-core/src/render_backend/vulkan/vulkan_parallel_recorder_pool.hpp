@@ -0,0 +1,51 @@
+#pragma once
+#ifndef BONSAI_RENDERER_VULKAN_PARALLEL_RECORDER_POOL_HPP
+#define BONSAI_RENDERER_VULKAN_PARALLEL_RECORDER_POOL_HPP
+
+#include <vector>
+#include <volk.h>
+
+/// @brief Upper bound for the number of parallel recorders, the actual count is limited by the hardware thread count.
+static constexpr uint32_t BONSAI_VULKAN_MAX_PARALLEL_RECORDERS = 32;
+
+/// @brief The parallel recorder pool owns a command pool per recorder, so each recorder can be used from its own thread.
+/// Secondary command buffers are allocated once & reused every frame after the pools are reset.
+class VulkanParallelRecorderPool
+{
+public:
+    VulkanParallelRecorderPool() = default;
+    VulkanParallelRecorderPool(VkDevice device, uint32_t queue_family);
+    ~VulkanParallelRecorderPool();
+
+    VulkanParallelRecorderPool(VulkanParallelRecorderPool const&) = delete;
+    VulkanParallelRecorderPool& operator=(VulkanParallelRecorderPool const&) = delete;
+
+    /// @brief Reset all recorder command pools, may only be called once the previous frame has finished.
+    void reset();
+
+    /// @brief Acquire a secondary command buffer for a recorder, must be called from the thread owning the recording frame.
+    /// @param recorder_index Recorder to acquire the command buffer for.
+    /// @return A secondary command buffer, or VK_NULL_HANDLE on failure.
+    [[nodiscard]]
+    VkCommandBuffer acquire(uint32_t recorder_index);
+
+    /// @brief Get the number of available recorders.
+    /// @return The recorder count.
+    [[nodiscard]]
+    uint32_t get_recorder_count() const { return static_cast<uint32_t>(m_recorders.size()); }
+
+private:
+    /// @brief Command pool & secondary command buffers for a single recorder.
+    struct Recorder
+    {
+        VkCommandPool command_pool;
+        std::vector<VkCommandBuffer> command_buffers;
+        size_t next_command_buffer;
+    };
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    std::vector<Recorder> m_recorders = {};
+};
+
+#endif //BONSAI_RENDERER_VULKAN_PARALLEL_RECORDER_POOL_HPP
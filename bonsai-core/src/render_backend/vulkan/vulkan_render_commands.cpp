@@ -1,92 +1,193 @@
 #include "vulkan_render_commands.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <backends/imgui_impl_vulkan.h>
 #include "bonsai/core/assert.hpp"
+#include "bonsai/core/checked_cast.hpp"
 #include "enum_conversion.hpp"
 #include "vk_check.hpp"
 #include "vulkan_buffer.hpp"
 #include "vulkan_shader_pipeline.hpp"
 #include "vulkan_texture.hpp"
 
-static VkImageMemoryBarrier2 get_image_memory_barrier(
-    VulkanTexture* texture,
-    VkPipelineStageFlags2 srcStageMask,
-    VkAccessFlags2 srcAccessMask,
-    VkPipelineStageFlags2 dstStageMask,
-    VkAccessFlags2 dstAccessMask,
-    VkImageLayout new_layout,
-    VkImageSubresourceRange subresource_range
+/// @brief Resolve attachments are written in the color attachment output stage, also for depth & stencil resolves.
+static constexpr VkPipelineStageFlags2 RESOLVE_STAGE_MASK = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+static constexpr VkAccessFlags2 RESOLVE_ACCESS_MASK = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+
+/// @brief Transition the rendered subresources of an attachment & its optional resolve target, and fill its rendering info.
+/// @param commands Render commands to queue the transitions on.
+/// @param attachment Attachment to transition.
+/// @param attachment_state Attachment state for the render target.
+/// @return The rendering attachment info for the attachment.
+static VkRenderingAttachmentInfo transition_attachment(
+    VulkanRenderCommands& commands,
+    RenderAttachmentInfo const& attachment,
+    ImageSubresourceState const& attachment_state
 )
 {
-    VkImageMemoryBarrier2 image_barrier{};
-    image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-    image_barrier.pNext = nullptr;
-    image_barrier.srcStageMask = srcStageMask;
-    image_barrier.srcAccessMask = srcAccessMask;
-    image_barrier.dstStageMask = dstStageMask;
-    image_barrier.dstAccessMask = dstAccessMask;
-    image_barrier.oldLayout = texture->set_next_layout(new_layout);
-    image_barrier.newLayout = texture->get_current_layout();
-    image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    image_barrier.image = texture->get_image();
-    image_barrier.subresourceRange = subresource_range;
+    VulkanTexture* vk_render_target = checked_cast<VulkanTexture*>(attachment.render_target);
+    VulkanTexture* vk_resolve_target = checked_cast<VulkanTexture*>(attachment.resolve_target);
+    BONSAI_ASSERT(vk_render_target != nullptr && "Render target was NULL!");
+
+    // Attachments render into mip 0, the attachment view covers all layers of that mip
+    commands.transition_texture(
+        vk_render_target,
+        vk_render_target->get_subresource_range(0, 1, 0, vk_render_target->array_layers()),
+        attachment_state,
+        false
+    );
 
-    return image_barrier;
+    if (vk_resolve_target)
+    {
+        ImageSubresourceState const resolve_state{ attachment_state.layout, RESOLVE_STAGE_MASK, RESOLVE_ACCESS_MASK };
+        commands.transition_texture(
+            vk_resolve_target,
+            vk_resolve_target->get_subresource_range(0, 1, 0, vk_resolve_target->array_layers()),
+            resolve_state,
+            false
+        );
+    }
+
+    VkRenderingAttachmentInfo rendering_attachment_info{};
+    rendering_attachment_info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+    rendering_attachment_info.pNext = nullptr;
+    rendering_attachment_info.imageView = vk_render_target->get_mip_view(0);
+    rendering_attachment_info.imageLayout = vk_render_target->get_layout(0, 0);
+    rendering_attachment_info.resolveMode = vk_resolve_target ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE;
+    rendering_attachment_info.resolveImageView = vk_resolve_target ? vk_resolve_target->get_mip_view(0) : VK_NULL_HANDLE;
+    rendering_attachment_info.resolveImageLayout = vk_resolve_target ? vk_resolve_target->get_layout(0, 0) : VK_IMAGE_LAYOUT_UNDEFINED;
+    rendering_attachment_info.loadOp = get_vulkan_load_op(attachment.load_op);
+    rendering_attachment_info.storeOp = get_vulkan_store_op(attachment.store_op);
+    rendering_attachment_info.clearValue = {};
+
+    return rendering_attachment_info;
 }
 
-VulkanRenderCommands::VulkanRenderCommands(VkCommandBuffer command_buffer)
+VulkanRenderCommands::VulkanRenderCommands(
+    VkCommandBuffer command_buffer,
+    VulkanDepthPyramidPass* depth_pyramid_pass,
+    VulkanParallelRecorderPool* parallel_recorder_pool,
+    VulkanGpuProfiler* gpu_profiler,
+    uint32_t max_viewport_count
+)
     :
-    m_command_buffer(command_buffer)
+    m_command_buffer(command_buffer),
+    m_depth_pyramid_pass(depth_pyramid_pass),
+    m_gpu_profiler(gpu_profiler),
+    m_max_viewport_count(max_viewport_count),
+    m_parallel_recorder_pool(parallel_recorder_pool)
 {
-    //
+    m_pending_memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    m_pending_memory_barrier.pNext = nullptr;
 }
 
 bool VulkanRenderCommands::begin()
 {
+    // Secondary recorders continue the parallel render pass of their primary commands
+    VkCommandBufferInheritanceRenderingInfo inheritance_rendering_info{};
+    inheritance_rendering_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    inheritance_rendering_info.pNext = nullptr;
+    inheritance_rendering_info.flags = 0;
+    inheritance_rendering_info.viewMask = m_inherited_view_mask;
+    inheritance_rendering_info.colorAttachmentCount = static_cast<uint32_t>(m_inherited_color_formats.size());
+    inheritance_rendering_info.pColorAttachmentFormats = m_inherited_color_formats.data();
+    inheritance_rendering_info.depthAttachmentFormat = m_inherited_depth_format;
+    inheritance_rendering_info.stencilAttachmentFormat = m_inherited_stencil_format;
+    inheritance_rendering_info.rasterizationSamples = m_inherited_sample_count;
+
+    VkCommandBufferInheritanceInfo inheritance_info{};
+    inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance_info.pNext = &inheritance_rendering_info;
+    inheritance_info.renderPass = VK_NULL_HANDLE;
+    inheritance_info.subpass = 0;
+    inheritance_info.framebuffer = VK_NULL_HANDLE;
+    inheritance_info.occlusionQueryEnable = VK_FALSE;
+    inheritance_info.queryFlags = 0;
+    inheritance_info.pipelineStatistics = m_inherited_pipeline_statistics;
+
     VkCommandBufferBeginInfo begin_info{};
     begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     begin_info.pNext = nullptr;
     begin_info.flags = 0;
     begin_info.pInheritanceInfo = nullptr;
+    if (m_is_secondary)
+    {
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        begin_info.pInheritanceInfo = &inheritance_info;
+    }
 
+    m_statistics = {};
+    m_parallel_recorder_count = 0;
+    m_in_render_pass = false;
+    invalidate_bound_state();
+    m_pending_image_barriers.clear();
+    m_pending_memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    m_pending_memory_barrier.srcAccessMask = VK_ACCESS_2_NONE;
+    m_pending_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+    m_pending_memory_barrier.dstAccessMask = VK_ACCESS_2_NONE;
     return VK_SUCCEEDED(vkBeginCommandBuffer(m_command_buffer, &begin_info));
 }
 
 bool VulkanRenderCommands::end()
 {
+    flush_barriers();
     return VK_SUCCEEDED(vkEndCommandBuffer(m_command_buffer));
 }
 
 void VulkanRenderCommands::mark_for_present(RenderTexture* texture)
 {
-    VulkanTexture* vulkan_texture = dynamic_cast<VulkanTexture*>(texture);
-    VkImageMemoryBarrier2 present_image_barrier{};
-    present_image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-    present_image_barrier.pNext = nullptr;
-    present_image_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
-    present_image_barrier.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
-    present_image_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
-    present_image_barrier.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
-    present_image_barrier.oldLayout = vulkan_texture->set_next_layout(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
-    present_image_barrier.newLayout = vulkan_texture->get_current_layout();
-    present_image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    present_image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    present_image_barrier.image = vulkan_texture->get_image();
-    present_image_barrier.subresourceRange = {
-        vulkan_texture->get_image_aspect(),
-        0, 1,
-        0, 1,
-    };
+    // The present state waits in the color output stage, which chains with the swap acquire semaphore wait stage
+    transition_texture(texture, RenderResourceStatePresent, false);
+}
+
+void VulkanRenderCommands::transition_texture(RenderTexture* texture, RenderResourceState state, bool discard)
+{
+    BONSAI_ASSERT(state != RenderResourceStateUndefined && "Textures cannot be transitioned to the undefined state!");
+    VulkanTexture* vk_texture = checked_cast<VulkanTexture*>(texture);
+    transition_texture(vk_texture, vk_texture->get_subresource_range(), get_vulkan_resource_state(state), discard);
+}
 
-    VkDependencyInfo present_dependency{};
-    present_dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-    present_dependency.pNext = nullptr;
-    present_dependency.imageMemoryBarrierCount = 1;
-    present_dependency.pImageMemoryBarriers = &present_image_barrier;
+void VulkanRenderCommands::transition_buffer(RenderBuffer* buffer, RenderResourceState state)
+{
+    BONSAI_ASSERT(buffer != nullptr && "Transitioned buffer was NULL!");
+    BONSAI_ASSERT(!m_is_secondary && "Transitions can not be recorded by parallel recorders!");
+    BONSAI_ASSERT(!m_in_render_pass && "Transitions can not be recorded inside a render pass!");
+    VulkanBuffer* vk_buffer = checked_cast<VulkanBuffer*>(buffer);
+    ImageSubresourceState const next_state = get_vulkan_resource_state(state);
+
+    VkPipelineStageFlags2 src_stage_mask = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 src_access_mask = VK_ACCESS_2_NONE;
+    if (!vk_buffer->transition(next_state.stage_mask, next_state.access_mask, src_stage_mask, src_access_mask))
+    {
+        m_statistics.skipped_transitions++;
+        return;
+    }
 
-    vkCmdPipelineBarrier2(m_command_buffer, &present_dependency);
+    add_memory_dependency(src_stage_mask, src_access_mask, next_state.stage_mask, next_state.access_mask);
+}
+
+void VulkanRenderCommands::alias_texture(RenderTexture* texture, RenderResourceState const* previous_states, size_t previous_state_count)
+{
+    VkPipelineStageFlags2 stage_mask = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 access_mask = VK_ACCESS_2_NONE;
+    get_aliased_access(previous_states, previous_state_count, stage_mask, access_mask);
+    BONSAI_ASSERT(!m_in_render_pass && "Aliased memory can not be handed over inside a render pass!");
+
+    // Pending barriers of the previous resources must complete before the aliasing barrier
+    flush_barriers();
+    checked_cast<VulkanTexture*>(texture)->alias(stage_mask, access_mask);
+}
+
+void VulkanRenderCommands::alias_buffer(RenderBuffer* buffer, RenderResourceState const* previous_states, size_t previous_state_count)
+{
+    VkPipelineStageFlags2 stage_mask = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 access_mask = VK_ACCESS_2_NONE;
+    get_aliased_access(previous_states, previous_state_count, stage_mask, access_mask);
+    BONSAI_ASSERT(!m_in_render_pass && "Aliased memory can not be handed over inside a render pass!");
+
+    flush_barriers();
+    checked_cast<VulkanBuffer*>(buffer)->alias(stage_mask, access_mask);
 }
 
 void VulkanRenderCommands::begin_render_pass(
@@ -94,269 +195,359 @@ void VulkanRenderCommands::begin_render_pass(
     RenderAttachmentInfo* color_targets,
     size_t color_target_count,
     RenderAttachmentInfo* depth_target,
-    RenderAttachmentInfo* stencil_target
+    RenderAttachmentInfo* stencil_target,
+    uint32_t layer_count,
+    uint32_t view_mask
 )
 {
-    // Set & transition color targets
-    std::vector<VkImageMemoryBarrier2> pass_image_barriers{};
-    std::vector<VkRenderingAttachmentInfo> color_attachments{};
-    pass_image_barriers.reserve(2 * (color_target_count + 2)); // Also used to transition depth + stencil targets and optionally resolve targets
-    color_attachments.reserve(color_target_count);
+    begin_rendering(render_area, color_targets, color_target_count, depth_target, stencil_target, layer_count, view_mask, 0);
+}
+
+void VulkanRenderCommands::begin_parallel_render_pass(
+    RenderRect2D render_area,
+    RenderAttachmentInfo* color_targets,
+    size_t color_target_count,
+    RenderAttachmentInfo* depth_target,
+    RenderAttachmentInfo* stencil_target,
+    uint32_t layer_count,
+    uint32_t view_mask,
+    uint32_t recorder_count
+)
+{
+    BONSAI_ASSERT(recorder_count > 0 && recorder_count <= get_max_parallel_recorders() && "Parallel recorder count out of range!");
+
+    // Store the attachment formats inherited by the secondary recorders
+    VulkanTexture const* first_target = nullptr;
+    m_inherited_color_formats.clear();
     for (size_t i = 0; i < color_target_count; i++)
     {
-        VulkanTexture* vk_render_target = dynamic_cast<VulkanTexture*>(color_targets->render_target);
-        VulkanTexture* vk_resolve_target = dynamic_cast<VulkanTexture*>(color_targets->resolve_target);
-        BONSAI_ASSERT(vk_render_target != nullptr && "Color target was NULL!");
-        pass_image_barriers.push_back(get_image_memory_barrier(
-            vk_render_target,
-            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-            VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-            VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-            {
-                vk_render_target->get_image_aspect(),
-                0, 1,
-                0, 1,
-            }
-        ));
+        m_inherited_color_formats.push_back(get_vulkan_format(color_targets[i].render_target->format()));
+        first_target = first_target ? first_target : checked_cast<VulkanTexture*>(color_targets[i].render_target);
+    }
 
-        if (vk_resolve_target)
-        {
-            pass_image_barriers.push_back(get_image_memory_barrier(
-                vk_resolve_target,
-                VK_PIPELINE_STAGE_2_RESOLVE_BIT,
-                VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                VK_PIPELINE_STAGE_2_RESOLVE_BIT,
-                VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                {
-                    vk_resolve_target->get_image_aspect(),
-                    0, 1,
-                    0, 1,
-                }
-            ));
-        }
+    m_inherited_depth_format = VK_FORMAT_UNDEFINED;
+    if (depth_target != nullptr)
+    {
+        m_inherited_depth_format = get_vulkan_format(depth_target->render_target->format());
+        first_target = first_target ? first_target : checked_cast<VulkanTexture*>(depth_target->render_target);
+    }
+
+    m_inherited_stencil_format = VK_FORMAT_UNDEFINED;
+    if (stencil_target != nullptr)
+    {
+        m_inherited_stencil_format = get_vulkan_format(stencil_target->render_target->format());
+        first_target = first_target ? first_target : checked_cast<VulkanTexture*>(stencil_target->render_target);
+    }
+    m_inherited_sample_count = first_target ? first_target->get_sample_count() : VK_SAMPLE_COUNT_1_BIT;
+    m_inherited_view_mask = view_mask;
+    m_inherited_pipeline_statistics = m_gpu_profiler != nullptr ? m_gpu_profiler->get_active_pipeline_statistics() : 0;
+
+    begin_rendering(
+        render_area,
+        color_targets,
+        color_target_count,
+        depth_target,
+        stencil_target,
+        layer_count,
+        view_mask,
+        VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT
+    );
+
+    // Recorders each acquire a command buffer from their own pool, so they can record from different threads
+    if (m_parallel_recorders.size() < recorder_count)
+    {
+        m_parallel_recorders.resize(recorder_count);
+    }
 
-        VkRenderingAttachmentInfo rendering_attachment_info{};
-        rendering_attachment_info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
-        rendering_attachment_info.pNext = nullptr;
-        rendering_attachment_info.imageView = vk_render_target->get_image_view();
-        rendering_attachment_info.imageLayout = vk_render_target->get_current_layout();
-        rendering_attachment_info.resolveMode = vk_resolve_target ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE;
-        rendering_attachment_info.resolveImageView = vk_resolve_target ? vk_resolve_target->get_image_view() : VK_NULL_HANDLE;
-        rendering_attachment_info.resolveImageLayout = vk_resolve_target ? vk_resolve_target->get_current_layout() : VK_IMAGE_LAYOUT_UNDEFINED;
-        rendering_attachment_info.loadOp = get_vulkan_load_op(color_targets[i].load_op);
-        rendering_attachment_info.storeOp = get_vulkan_store_op(color_targets[i].store_op);
+    for (uint32_t i = 0; i < recorder_count; i++)
+    {
+        VkCommandBuffer const command_buffer = m_parallel_recorder_pool->acquire(i);
+        BONSAI_ASSERT(command_buffer != VK_NULL_HANDLE && "Failed to acquire parallel recorder command buffer!");
+        m_parallel_recorders[i].init_secondary(command_buffer, *this);
+    }
+    m_parallel_recorder_count = recorder_count;
+}
+
+RenderCommands* VulkanRenderCommands::get_parallel_recorder(uint32_t recorder_index)
+{
+    BONSAI_ASSERT(recorder_index < m_parallel_recorder_count && "Parallel recorder index out of range for active render pass!");
+    return &m_parallel_recorders[recorder_index];
+}
+
+uint32_t VulkanRenderCommands::get_max_parallel_recorders() const
+{
+    if (m_is_secondary || m_parallel_recorder_pool == nullptr)
+    {
+        return 0;
+    }
+
+    return m_parallel_recorder_pool->get_recorder_count();
+}
+
+uint32_t VulkanRenderCommands::get_max_viewport_count() const
+{
+    return m_max_viewport_count;
+}
+
+void VulkanRenderCommands::begin_rendering(
+    RenderRect2D render_area,
+    RenderAttachmentInfo* color_targets,
+    size_t color_target_count,
+    RenderAttachmentInfo* depth_target,
+    RenderAttachmentInfo* stencil_target,
+    uint32_t layer_count,
+    uint32_t view_mask,
+    VkRenderingFlags rendering_flags
+)
+{
+    BONSAI_ASSERT(!m_is_secondary && "Render passes can not be started by parallel recorders!");
+    BONSAI_ASSERT((view_mask != 0 || layer_count > 0) && "Render passes must render to at least one layer!");
+
+    // Set & transition color targets
+    BONSAI_ASSERT(color_target_count <= BONSAI_MAX_COLOR_ATTACHMENT_COUNT && "Color target count exceeds the maximum color attachment count!");
+    VkRenderingAttachmentInfo color_attachments[BONSAI_MAX_COLOR_ATTACHMENT_COUNT]{};
+    for (size_t i = 0; i < color_target_count; i++)
+    {
+        VkRenderingAttachmentInfo rendering_attachment_info = transition_attachment(*this, color_targets[i], get_vulkan_resource_state(RenderResourceStateColorTarget));
         rendering_attachment_info.clearValue = VkClearValue{{{
             color_targets[i].clear_value.color.float32[0],
             color_targets[i].clear_value.color.float32[1],
             color_targets[i].clear_value.color.float32[2],
             color_targets[i].clear_value.color.float32[3],
         }}};
-        color_attachments.push_back(rendering_attachment_info);
+        color_attachments[i] = rendering_attachment_info;
     }
 
     // Set and transition depth target if it exists
     VkRenderingAttachmentInfo depth_attachment{};
     if (depth_target != nullptr)
     {
-        VulkanTexture* vk_render_target = dynamic_cast<VulkanTexture*>(depth_target->render_target);
-        VulkanTexture* vk_resolve_target = dynamic_cast<VulkanTexture*>(depth_target->resolve_target);
-        BONSAI_ASSERT(vk_render_target != nullptr && "Depth target was NULL!");
-        pass_image_barriers.push_back(get_image_memory_barrier(
-            vk_render_target,
-            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
-            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
-            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-            {
-                vk_render_target->get_image_aspect(),
-                0, 1,
-                0, 1,
-            }
-        ));
-
-        if (vk_resolve_target)
-        {
-            pass_image_barriers.push_back(get_image_memory_barrier(
-                vk_resolve_target,
-                VK_PIPELINE_STAGE_2_RESOLVE_BIT,
-                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                VK_PIPELINE_STAGE_2_RESOLVE_BIT,
-                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                {
-                    vk_resolve_target->get_image_aspect(),
-                    0, 1,
-                    0, 1,
-                }
-            ));
-        }
-
-        depth_attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
-        depth_attachment.pNext = nullptr;
-        depth_attachment.imageView = vk_render_target->get_image_view();
-        depth_attachment.imageLayout = vk_render_target->get_current_layout();
-        depth_attachment.resolveMode = vk_resolve_target ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE;
-        depth_attachment.resolveImageView = vk_resolve_target ? vk_resolve_target->get_image_view() : VK_NULL_HANDLE;
-        depth_attachment.resolveImageLayout = vk_resolve_target ? vk_resolve_target->get_current_layout() : VK_IMAGE_LAYOUT_UNDEFINED;
-        depth_attachment.loadOp = get_vulkan_load_op(depth_target->load_op);
-        depth_attachment.storeOp = get_vulkan_store_op(depth_target->store_op);
+        depth_attachment = transition_attachment(*this, *depth_target, get_vulkan_resource_state(RenderResourceStateDepthStencilTarget));
         depth_attachment.clearValue.depthStencil = {
             depth_target->clear_value.depth_stencil.depth,
             depth_target->clear_value.depth_stencil.stencil,
         };
     }
 
-    // Set and transition stencil target if it exists
+    // Set and transition stencil target if it exists, a combined depth stencil target is only transitioned once
     VkRenderingAttachmentInfo stencil_attachment{};
     if (stencil_target != nullptr)
     {
-        VulkanTexture* vk_render_target = dynamic_cast<VulkanTexture*>(stencil_target->render_target);
-        VulkanTexture* vk_resolve_target = dynamic_cast<VulkanTexture*>(stencil_target->resolve_target);
-        BONSAI_ASSERT(vk_render_target != nullptr && "Stencil target was NULL!");
-        pass_image_barriers.push_back(get_image_memory_barrier(
-            vk_render_target,
-            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
-            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-            VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT,
-            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-            {
-                vk_render_target->get_image_aspect(),
-                0, 1,
-                0, 1,
-            }
-        ));
-
-        if (vk_resolve_target)
+        if (depth_target != nullptr && depth_target->render_target == stencil_target->render_target)
         {
-            pass_image_barriers.push_back(get_image_memory_barrier(
-                vk_resolve_target,
-                VK_PIPELINE_STAGE_2_RESOLVE_BIT,
-                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                VK_PIPELINE_STAGE_2_RESOLVE_BIT,
-                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                {
-                    vk_resolve_target->get_image_aspect(),
-                    0, 1,
-                    0, 1,
-                }
-            ));
+            stencil_attachment = depth_attachment;
+            stencil_attachment.loadOp = get_vulkan_load_op(stencil_target->load_op);
+            stencil_attachment.storeOp = get_vulkan_store_op(stencil_target->store_op);
+        }
+        else
+        {
+            stencil_attachment = transition_attachment(*this, *stencil_target, get_vulkan_resource_state(RenderResourceStateDepthStencilTarget));
         }
-
-        stencil_attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
-        stencil_attachment.pNext = nullptr;
-        stencil_attachment.imageView = vk_render_target->get_image_view();
-        stencil_attachment.imageLayout = vk_render_target->get_current_layout();
-        stencil_attachment.resolveMode = vk_resolve_target ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE;
-        stencil_attachment.resolveImageView = vk_resolve_target ? vk_resolve_target->get_image_view() : VK_NULL_HANDLE;
-        stencil_attachment.resolveImageLayout = vk_resolve_target ? vk_resolve_target->get_current_layout() : VK_IMAGE_LAYOUT_UNDEFINED;
-        stencil_attachment.loadOp = get_vulkan_load_op(stencil_target->load_op);
-        stencil_attachment.storeOp = get_vulkan_store_op(stencil_target->store_op);
         stencil_attachment.clearValue.depthStencil = {
-            depth_target->clear_value.depth_stencil.depth,
-            depth_target->clear_value.depth_stencil.stencil,
+            stencil_target->clear_value.depth_stencil.depth,
+            stencil_target->clear_value.depth_stencil.stencil,
         };
     }
 
     VkRenderingInfo rendering_info{};
     rendering_info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
     rendering_info.pNext = nullptr;
-    rendering_info.flags = 0;
+    rendering_info.flags = rendering_flags;
     rendering_info.renderArea = {
         {render_area.offset.x, render_area.offset.y },
         { render_area.extent.width, render_area.extent.height }
     };
-    rendering_info.layerCount = 1;
-    rendering_info.viewMask = 0;
-    rendering_info.colorAttachmentCount = static_cast<uint32_t>(color_attachments.size());
-    rendering_info.pColorAttachments = color_attachments.data();
+    rendering_info.layerCount = view_mask != 0 ? 1 : layer_count; // Multiview passes ignore the layer count
+    rendering_info.viewMask = view_mask;
+    rendering_info.colorAttachmentCount = static_cast<uint32_t>(color_target_count);
+    rendering_info.pColorAttachments = color_attachments;
     rendering_info.pDepthAttachment = depth_target ? &depth_attachment : nullptr;
     rendering_info.pStencilAttachment = stencil_target ? &stencil_attachment : nullptr;
 
-    VkDependencyInfo pass_dependency_info{};
-    pass_dependency_info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-    pass_dependency_info.pNext = nullptr;
-    pass_dependency_info.imageMemoryBarrierCount = static_cast<uint32_t>(pass_image_barriers.size());
-    pass_dependency_info.pImageMemoryBarriers = pass_image_barriers.data();
-
-    vkCmdPipelineBarrier2(m_command_buffer, &pass_dependency_info);
+    flush_barriers();
     vkCmdBeginRendering(m_command_buffer, &rendering_info);
+    m_in_render_pass = true;
 }
 
 void VulkanRenderCommands::end_render_pass()
 {
+    if (m_parallel_recorder_count > 0)
+    {
+        m_parallel_command_buffers.clear();
+        for (uint32_t i = 0; i < m_parallel_recorder_count; i++)
+        {
+            m_parallel_command_buffers.push_back(m_parallel_recorders[i].get_command_buffer());
+        }
+
+        vkCmdExecuteCommands(m_command_buffer, m_parallel_recorder_count, m_parallel_command_buffers.data());
+        for (uint32_t i = 0; i < m_parallel_recorder_count; i++)
+        {
+            m_statistics.skipped_state_changes += m_parallel_recorders[i].m_statistics.skipped_state_changes;
+        }
+
+        // Command buffer state is undefined after executing secondary command buffers
+        m_parallel_recorder_count = 0;
+        invalidate_bound_state();
+    }
+
     vkCmdEndRendering(m_command_buffer);
+    m_in_render_pass = false;
 }
 
 void VulkanRenderCommands::set_pipeline(ShaderPipeline* pipeline)
 {
-    VulkanShaderPipeline const* vk_pipeline = dynamic_cast<VulkanShaderPipeline*>(pipeline);
+    VulkanShaderPipeline const* vk_pipeline = checked_cast<VulkanShaderPipeline*>(pipeline);
+    if (m_bound_state.pipeline == vk_pipeline->get_pipeline())
+    {
+        m_statistics.skipped_state_changes++;
+        return;
+    }
+
+    // All pipelines declare viewport, scissor & topology as dynamic, so binding a pipeline keeps the shadowed dynamic state valid
+    m_bound_state.pipeline = vk_pipeline->get_pipeline();
     vkCmdBindPipeline(m_command_buffer, vk_pipeline->get_bind_point(), vk_pipeline->get_pipeline());
 }
 
 void VulkanRenderCommands::set_primitive_topology(PrimitiveTopologyType primitive_topology)
 {
-    vkCmdSetPrimitiveTopology(m_command_buffer, get_vulkan_topology(primitive_topology));
+    VkPrimitiveTopology const vk_topology = get_vulkan_topology(primitive_topology);
+    if (m_bound_state.has_topology && m_bound_state.topology == vk_topology)
+    {
+        m_statistics.skipped_state_changes++;
+        return;
+    }
+
+    m_bound_state.has_topology = true;
+    m_bound_state.topology = vk_topology;
+    vkCmdSetPrimitiveTopology(m_command_buffer, vk_topology);
 }
 
 void VulkanRenderCommands::set_viewports(size_t count, RenderViewport* viewports)
 {
-    BONSAI_ASSERT(count == 1 && "Viewport count must be 1");
-    VkViewport const vk_viewport{
-        viewports[0].x,
-        viewports[0].y,
-        viewports[0].width,
-        viewports[0].height,
-        viewports[0].min_depth,
-        viewports[0].max_depth,
-    };
+    BONSAI_ASSERT(count > 0 && count <= m_max_viewport_count && "Viewport count must be in range [1, get_max_viewport_count()]!");
+    VkViewport vk_viewports[BONSAI_MAX_VIEWPORT_COUNT]{};
+    bool is_bound = m_bound_state.viewport_count == count;
+    for (size_t i = 0; i < count; i++)
+    {
+        vk_viewports[i] = VkViewport{
+            viewports[i].x,
+            viewports[i].y,
+            viewports[i].width,
+            viewports[i].height,
+            viewports[i].min_depth,
+            viewports[i].max_depth,
+        };
+
+        VkViewport const& bound_viewport = m_bound_state.viewports[i];
+        is_bound = is_bound
+            && bound_viewport.x == vk_viewports[i].x
+            && bound_viewport.y == vk_viewports[i].y
+            && bound_viewport.width == vk_viewports[i].width
+            && bound_viewport.height == vk_viewports[i].height
+            && bound_viewport.minDepth == vk_viewports[i].minDepth
+            && bound_viewport.maxDepth == vk_viewports[i].maxDepth;
+    }
+
+    if (is_bound)
+    {
+        m_statistics.skipped_state_changes++;
+        return;
+    }
 
-    vkCmdSetViewport(m_command_buffer, 0, 1, &vk_viewport);
+    m_bound_state.viewport_count = static_cast<uint32_t>(count);
+    std::copy(vk_viewports, vk_viewports + count, m_bound_state.viewports);
+    vkCmdSetViewportWithCount(m_command_buffer, static_cast<uint32_t>(count), vk_viewports);
 }
 
 void VulkanRenderCommands::set_scissor_rects(size_t count, RenderRect2D* scissor_rects)
 {
-    BONSAI_ASSERT(count == 1 && "Scissor rect count must be 1");
-    VkRect2D const vk_scissor_rect{
-        { scissor_rects[0].offset.x, scissor_rects[0].offset.y },
-        { scissor_rects[0].extent.width, scissor_rects[0].extent.height },
-    };
+    BONSAI_ASSERT(count > 0 && count <= m_max_viewport_count && "Scissor rect count must be in range [1, get_max_viewport_count()]!");
+    VkRect2D vk_scissor_rects[BONSAI_MAX_VIEWPORT_COUNT]{};
+    bool is_bound = m_bound_state.scissor_count == count;
+    for (size_t i = 0; i < count; i++)
+    {
+        vk_scissor_rects[i] = VkRect2D{
+            { scissor_rects[i].offset.x, scissor_rects[i].offset.y },
+            { scissor_rects[i].extent.width, scissor_rects[i].extent.height },
+        };
+
+        VkRect2D const& bound_scissor_rect = m_bound_state.scissors[i];
+        is_bound = is_bound
+            && bound_scissor_rect.offset.x == vk_scissor_rects[i].offset.x
+            && bound_scissor_rect.offset.y == vk_scissor_rects[i].offset.y
+            && bound_scissor_rect.extent.width == vk_scissor_rects[i].extent.width
+            && bound_scissor_rect.extent.height == vk_scissor_rects[i].extent.height;
+    }
 
-    vkCmdSetScissor(m_command_buffer, 0, 1, &vk_scissor_rect);
+    if (is_bound)
+    {
+        m_statistics.skipped_state_changes++;
+        return;
+    }
+
+    m_bound_state.scissor_count = static_cast<uint32_t>(count);
+    std::copy(vk_scissor_rects, vk_scissor_rects + count, m_bound_state.scissors);
+    vkCmdSetScissorWithCount(m_command_buffer, static_cast<uint32_t>(count), vk_scissor_rects);
 }
 
 void VulkanRenderCommands::bind_vertex_buffers(uint32_t base_binding, size_t count, RenderBuffer** buffers, size_t* offsets)
 {
-    std::vector<VkBuffer> vertex_buffers;
-    vertex_buffers.resize(count);
+    BONSAI_ASSERT(base_binding + count <= BONSAI_MAX_VERTEX_BUFFER_BINDINGS && "Vertex buffer bindings exceed the maximum vertex buffer binding count!");
+    VkBuffer vertex_buffers[BONSAI_MAX_VERTEX_BUFFER_BINDINGS]{};
+    bool is_bound = true;
     for (size_t i = 0; i < count; i++)
     {
-        VulkanBuffer const* vk_buffer = dynamic_cast<VulkanBuffer*>(buffers[i]);
+        VulkanBuffer const* vk_buffer = checked_cast<VulkanBuffer*>(buffers[i]);
         vertex_buffers[i] = vk_buffer->get_buffer();
+        is_bound = is_bound
+            && (m_bound_state.vertex_binding_mask & (1U << (base_binding + i))) != 0
+            && m_bound_state.vertex_buffers[base_binding + i] == vertex_buffers[i]
+            && m_bound_state.vertex_offsets[base_binding + i] == offsets[i];
+    }
+
+    if (is_bound)
+    {
+        m_statistics.skipped_state_changes++;
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_bound_state.vertex_binding_mask |= 1U << (base_binding + i);
+        m_bound_state.vertex_buffers[base_binding + i] = vertex_buffers[i];
+        m_bound_state.vertex_offsets[base_binding + i] = offsets[i];
     }
 
     vkCmdBindVertexBuffers(
         m_command_buffer,
         base_binding,
         static_cast<uint32_t>(count),
-        vertex_buffers.data(),
+        vertex_buffers,
         offsets
     );
 }
 
 void VulkanRenderCommands::bind_index_buffer(RenderBuffer* buffer, size_t offset, IndexType index_type)
 {
-    VulkanBuffer const* vk_buffer = dynamic_cast<VulkanBuffer*>(buffer);
-    vkCmdBindIndexBuffer(m_command_buffer, vk_buffer->get_buffer(), offset, get_vulkan_index_type(index_type));
+    VulkanBuffer const* vk_buffer = checked_cast<VulkanBuffer*>(buffer);
+    VkIndexType const vk_index_type = get_vulkan_index_type(index_type);
+    if (m_bound_state.index_buffer == vk_buffer->get_buffer()
+        && m_bound_state.index_offset == offset
+        && m_bound_state.index_type == vk_index_type)
+    {
+        m_statistics.skipped_state_changes++;
+        return;
+    }
+
+    m_bound_state.index_buffer = vk_buffer->get_buffer();
+    m_bound_state.index_offset = offset;
+    m_bound_state.index_type = vk_index_type;
+    vkCmdBindIndexBuffer(m_command_buffer, vk_buffer->get_buffer(), offset, vk_index_type);
 }
 
 void VulkanRenderCommands::draw_instanced(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
 {
+    // Barriers can not be queued inside render passes, they were all flushed when the pass began
     vkCmdDraw(
         m_command_buffer,
         vertex_count,
@@ -380,10 +571,213 @@ void VulkanRenderCommands::draw_indexed_instanced(uint32_t index_count, uint32_t
 
 void VulkanRenderCommands::dispatch(uint32_t x, uint32_t y, uint32_t z)
 {
+    BONSAI_ASSERT(!m_is_secondary && "Dispatches can not be recorded by parallel recorders!");
+    flush_barriers();
     vkCmdDispatch(m_command_buffer, x, y, z);
 }
 
+void VulkanRenderCommands::generate_depth_pyramid(RenderTexture* depth_texture, RenderTexture* depth_pyramid)
+{
+    BONSAI_ASSERT(m_depth_pyramid_pass != nullptr && "Depth pyramid pass was NULL!");
+    m_depth_pyramid_pass->record(
+        *this,
+        checked_cast<VulkanTexture*>(depth_texture),
+        checked_cast<VulkanTexture*>(depth_pyramid)
+    );
+
+    // The depth pyramid pass binds its own compute pipeline
+    invalidate_bound_state();
+}
+
+void VulkanRenderCommands::begin_profile_scope(char const* name, bool pipeline_statistics)
+{
+    BONSAI_ASSERT(!m_is_secondary && "Profile scopes can not be recorded by parallel recorders!");
+    if (m_gpu_profiler != nullptr)
+    {
+        m_gpu_profiler->begin_scope(m_command_buffer, name, pipeline_statistics);
+    }
+}
+
+void VulkanRenderCommands::end_profile_scope()
+{
+    BONSAI_ASSERT(!m_is_secondary && "Profile scopes can not be recorded by parallel recorders!");
+    if (m_gpu_profiler != nullptr)
+    {
+        m_gpu_profiler->end_scope(m_command_buffer);
+    }
+}
+
 void VulkanRenderCommands::imgui_render_draw_data(ImDrawData* draw_data)
 {
     ImGui_ImplVulkan_RenderDrawData(draw_data, m_command_buffer);
+
+    // ImGui binds its own pipeline, dynamic state & buffers
+    invalidate_bound_state();
+}
+
+void VulkanRenderCommands::transition_texture(
+    VulkanTexture* texture,
+    VkImageSubresourceRange const& range,
+    ImageSubresourceState const& next_state,
+    bool discard
+)
+{
+    BONSAI_ASSERT(texture != nullptr && "Transitioned texture was NULL!");
+    BONSAI_ASSERT(!m_is_secondary && "Transitions can not be recorded by parallel recorders!");
+    BONSAI_ASSERT(!m_in_render_pass && "Transitions can not be recorded inside a render pass!");
+    m_transition_barriers.clear();
+    if (texture->transition(range, next_state, discard, m_transition_barriers) == 0)
+    {
+        m_statistics.skipped_transitions++;
+        return;
+    }
+
+    for (auto const& barrier : m_transition_barriers)
+    {
+        int64_t const overlap_idx = find_pending_overlap(barrier);
+        if (overlap_idx >= 0)
+        {
+            // No commands are recorded between pending barriers, so transitions of the same range fold into one
+            VkImageMemoryBarrier2& pending_barrier = m_pending_image_barriers[overlap_idx];
+            VkImageSubresourceRange const& pending_range = pending_barrier.subresourceRange;
+            if (pending_range.aspectMask == barrier.subresourceRange.aspectMask
+                && pending_range.baseMipLevel == barrier.subresourceRange.baseMipLevel
+                && pending_range.levelCount == barrier.subresourceRange.levelCount
+                && pending_range.baseArrayLayer == barrier.subresourceRange.baseArrayLayer
+                && pending_range.layerCount == barrier.subresourceRange.layerCount)
+            {
+                pending_barrier.oldLayout = barrier.oldLayout == VK_IMAGE_LAYOUT_UNDEFINED ? VK_IMAGE_LAYOUT_UNDEFINED : pending_barrier.oldLayout;
+                pending_barrier.newLayout = barrier.newLayout;
+                pending_barrier.dstStageMask = barrier.dstStageMask;
+                pending_barrier.dstAccessMask = barrier.dstAccessMask;
+                continue;
+            }
+
+            // Partially overlapping barriers in the same batch are unordered, record the pending barriers first
+            flush_barriers();
+        }
+
+        m_pending_image_barriers.push_back(barrier);
+    }
+}
+
+void VulkanRenderCommands::add_memory_dependency(
+    VkPipelineStageFlags2 src_stage_mask,
+    VkAccessFlags2 src_access_mask,
+    VkPipelineStageFlags2 dst_stage_mask,
+    VkAccessFlags2 dst_access_mask
+)
+{
+    BONSAI_ASSERT(!m_in_render_pass && "Memory dependencies can not be recorded inside a render pass!");
+    m_pending_memory_barrier.srcStageMask |= src_stage_mask;
+    m_pending_memory_barrier.srcAccessMask |= src_access_mask;
+    m_pending_memory_barrier.dstStageMask |= dst_stage_mask;
+    m_pending_memory_barrier.dstAccessMask |= dst_access_mask;
+}
+
+void VulkanRenderCommands::flush_barriers()
+{
+    // Barriers that keep the same layout don't need the image, they are merged into the global memory barrier
+    size_t image_barrier_count = 0;
+    for (auto const& barrier : m_pending_image_barriers)
+    {
+        if (barrier.oldLayout == barrier.newLayout)
+        {
+            add_memory_dependency(barrier.srcStageMask, barrier.srcAccessMask, barrier.dstStageMask, barrier.dstAccessMask);
+            continue;
+        }
+
+        m_pending_image_barriers[image_barrier_count++] = barrier;
+    }
+    m_pending_image_barriers.resize(image_barrier_count);
+
+    bool const has_memory_barrier = (m_pending_memory_barrier.srcStageMask | m_pending_memory_barrier.dstStageMask) != VK_PIPELINE_STAGE_2_NONE;
+    if (!has_memory_barrier && m_pending_image_barriers.empty())
+    {
+        return;
+    }
+
+    VkDependencyInfo dependency_info{};
+    dependency_info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependency_info.pNext = nullptr;
+    dependency_info.dependencyFlags = 0;
+    dependency_info.memoryBarrierCount = has_memory_barrier ? 1 : 0;
+    dependency_info.pMemoryBarriers = &m_pending_memory_barrier;
+    dependency_info.bufferMemoryBarrierCount = 0;
+    dependency_info.pBufferMemoryBarriers = nullptr;
+    dependency_info.imageMemoryBarrierCount = static_cast<uint32_t>(m_pending_image_barriers.size());
+    dependency_info.pImageMemoryBarriers = m_pending_image_barriers.data();
+    vkCmdPipelineBarrier2(m_command_buffer, &dependency_info);
+
+    m_statistics.pipeline_barriers++;
+    m_statistics.image_barriers += static_cast<uint32_t>(m_pending_image_barriers.size());
+    m_statistics.memory_barriers += has_memory_barrier ? 1 : 0;
+
+    m_pending_image_barriers.clear();
+    m_pending_memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    m_pending_memory_barrier.srcAccessMask = VK_ACCESS_2_NONE;
+    m_pending_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+    m_pending_memory_barrier.dstAccessMask = VK_ACCESS_2_NONE;
+}
+
+void VulkanRenderCommands::invalidate_bound_state()
+{
+    // Clear all validity flags & use an invalid index type, so the next binds are always recorded
+    m_bound_state = {};
+    m_bound_state.index_type = VK_INDEX_TYPE_MAX_ENUM;
+}
+
+void VulkanRenderCommands::init_secondary(VkCommandBuffer command_buffer, VulkanRenderCommands const& parent)
+{
+    m_command_buffer = command_buffer;
+    m_depth_pyramid_pass = nullptr;
+    m_gpu_profiler = nullptr;
+    m_max_viewport_count = parent.m_max_viewport_count;
+    m_parallel_recorder_pool = nullptr;
+    m_is_secondary = true;
+    m_inherited_color_formats = parent.m_inherited_color_formats;
+    m_inherited_depth_format = parent.m_inherited_depth_format;
+    m_inherited_stencil_format = parent.m_inherited_stencil_format;
+    m_inherited_sample_count = parent.m_inherited_sample_count;
+    m_inherited_view_mask = parent.m_inherited_view_mask;
+    m_inherited_pipeline_statistics = parent.m_inherited_pipeline_statistics;
+    m_pending_memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    m_pending_memory_barrier.pNext = nullptr;
+}
+
+void VulkanRenderCommands::get_aliased_access(
+    RenderResourceState const* previous_states,
+    size_t previous_state_count,
+    VkPipelineStageFlags2& stage_mask,
+    VkAccessFlags2& access_mask
+)
+{
+    BONSAI_ASSERT((previous_state_count == 0 || previous_states != nullptr) && "Previous resource states were NULL!");
+    for (size_t i = 0; i < previous_state_count; i++)
+    {
+        ImageSubresourceState const state = get_vulkan_resource_state(previous_states[i]);
+        stage_mask |= state.stage_mask;
+        access_mask |= state.access_mask;
+    }
+}
+
+int64_t VulkanRenderCommands::find_pending_overlap(VkImageMemoryBarrier2 const& barrier) const
+{
+    VkImageSubresourceRange const& range = barrier.subresourceRange;
+    for (size_t i = 0; i < m_pending_image_barriers.size(); i++)
+    {
+        VkImageMemoryBarrier2 const& pending_barrier = m_pending_image_barriers[i];
+        VkImageSubresourceRange const& pending_range = pending_barrier.subresourceRange;
+        if (pending_barrier.image == barrier.image
+            && (pending_range.aspectMask & range.aspectMask) != 0
+            && pending_range.baseMipLevel < range.baseMipLevel + range.levelCount
+            && range.baseMipLevel < pending_range.baseMipLevel + pending_range.levelCount
+            && pending_range.baseArrayLayer < range.baseArrayLayer + range.layerCount
+            && range.baseArrayLayer < pending_range.baseArrayLayer + pending_range.layerCount)
+        {
+            return static_cast<int64_t>(i);
+        }
+    }
+
+    return -1;
 }
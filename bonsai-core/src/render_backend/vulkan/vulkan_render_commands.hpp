@@ -2,14 +2,27 @@
 #ifndef BONSAI_RENDERER_VULKAN_RENDER_COMMANDS_HPP
 #define BONSAI_RENDERER_VULKAN_RENDER_COMMANDS_HPP
 
+#include <vector>
 #include <volk.h>
 #include "bonsai/render_backend/render_backend.hpp"
+#include "image_state_tracker.hpp"
+#include "vulkan_depth_pyramid_pass.hpp"
+#include "vulkan_gpu_profiler.hpp"
+#include "vulkan_parallel_recorder_pool.hpp"
+#include "vulkan_buffer.hpp"
+#include "vulkan_texture.hpp"
 
 class VulkanRenderCommands : public RenderCommands
 {
 public:
     VulkanRenderCommands() = default;
-    explicit VulkanRenderCommands(VkCommandBuffer command_buffer);
+    VulkanRenderCommands(
+        VkCommandBuffer command_buffer,
+        VulkanDepthPyramidPass* depth_pyramid_pass,
+        VulkanParallelRecorderPool* parallel_recorder_pool,
+        VulkanGpuProfiler* gpu_profiler,
+        uint32_t max_viewport_count
+    );
     ~VulkanRenderCommands() override = default;
 
     bool begin() override;
@@ -18,14 +31,41 @@ public:
 
     void mark_for_present(RenderTexture* texture) override;
 
+    void transition_texture(RenderTexture* texture, RenderResourceState state, bool discard) override;
+
+    void transition_buffer(RenderBuffer* buffer, RenderResourceState state) override;
+
+    void alias_texture(RenderTexture* texture, RenderResourceState const* previous_states, size_t previous_state_count) override;
+
+    void alias_buffer(RenderBuffer* buffer, RenderResourceState const* previous_states, size_t previous_state_count) override;
+
     void begin_render_pass(
         RenderRect2D render_area,
         RenderAttachmentInfo* color_targets,
         size_t color_target_count,
         RenderAttachmentInfo* depth_target,
-        RenderAttachmentInfo* stencil_target
+        RenderAttachmentInfo* stencil_target,
+        uint32_t layer_count,
+        uint32_t view_mask
+    ) override;
+
+    void begin_parallel_render_pass(
+        RenderRect2D render_area,
+        RenderAttachmentInfo* color_targets,
+        size_t color_target_count,
+        RenderAttachmentInfo* depth_target,
+        RenderAttachmentInfo* stencil_target,
+        uint32_t layer_count,
+        uint32_t view_mask,
+        uint32_t recorder_count
     ) override;
 
+    RenderCommands* get_parallel_recorder(uint32_t recorder_index) override;
+
+    uint32_t get_max_parallel_recorders() const override;
+
+    uint32_t get_max_viewport_count() const override;
+
     void end_render_pass() override;
 
     void set_pipeline(ShaderPipeline* pipeline) override;
@@ -46,10 +86,127 @@ public:
 
     void dispatch(uint32_t x, uint32_t y, uint32_t z) override;
 
+    void generate_depth_pyramid(RenderTexture* depth_texture, RenderTexture* depth_pyramid) override;
+
+    void begin_profile_scope(char const* name, bool pipeline_statistics) override;
+
+    void end_profile_scope() override;
+
     void imgui_render_draw_data(ImDrawData* draw_data) override;
 
+    RenderCommandStatistics get_statistics() const override { return m_statistics; }
+
+    /// @brief Queue a texture transition, the required barriers are recorded on the next barrier flush.
+    /// @param texture Texture to transition.
+    /// @param range Subresource range to transition.
+    /// @param next_state State to transition the range to.
+    /// @param discard Discard the previous contents of the range.
+    void transition_texture(VulkanTexture* texture, VkImageSubresourceRange const& range, ImageSubresourceState const& next_state, bool discard);
+
+    /// @brief Queue a global memory dependency, merged into a single memory barrier on the next barrier flush.
+    /// @param src_stage_mask Source pipeline stages.
+    /// @param src_access_mask Source access types.
+    /// @param dst_stage_mask Destination pipeline stages.
+    /// @param dst_access_mask Destination access types.
+    void add_memory_dependency(
+        VkPipelineStageFlags2 src_stage_mask,
+        VkAccessFlags2 src_access_mask,
+        VkPipelineStageFlags2 dst_stage_mask,
+        VkAccessFlags2 dst_access_mask
+    );
+
+    /// @brief Record all queued barriers in a single pipeline barrier command.
+    /// Called before dispatches, rendering begin and command recording end. Barriers can not be queued inside render
+    /// passes, so draws never need to flush.
+    void flush_barriers();
+
+    [[nodiscard]]
+    VkCommandBuffer get_command_buffer() const { return m_command_buffer; }
+
+private:
+    /// @brief Fill the rendering info for a render pass & transition its attachments, then start rendering.
+    /// See @ref RenderCommands::begin_render_pass for the attachment & view parameters.
+    /// @param rendering_flags Vulkan rendering flags for the render pass.
+    void begin_rendering(
+        RenderRect2D render_area,
+        RenderAttachmentInfo* color_targets,
+        size_t color_target_count,
+        RenderAttachmentInfo* depth_target,
+        RenderAttachmentInfo* stencil_target,
+        uint32_t layer_count,
+        uint32_t view_mask,
+        VkRenderingFlags rendering_flags
+    );
+
+    /// @brief Set up this object as a secondary recorder inheriting a parallel render pass.
+    /// @param command_buffer Secondary command buffer to record into.
+    /// @param parent Primary render commands that started the parallel render pass.
+    void init_secondary(VkCommandBuffer command_buffer, VulkanRenderCommands const& parent);
+
+    /// @brief Merge the stages & access types of the previous resource states of aliased memory.
+    /// @param previous_states Previous resource states.
+    /// @param previous_state_count Number of previous resource states.
+    /// @param stage_mask Output merged pipeline stages.
+    /// @param access_mask Output merged access types.
+    static void get_aliased_access(
+        RenderResourceState const* previous_states,
+        size_t previous_state_count,
+        VkPipelineStageFlags2& stage_mask,
+        VkAccessFlags2& access_mask
+    );
+
+    /// @brief Forget the shadowed command buffer state, the next binds are always recorded.
+    /// Called when recording begins and after commands that bind state outside of this recorder.
+    void invalidate_bound_state();
+
+    /// @brief Check if a barrier overlaps a pending image barrier for the same image.
+    /// @param barrier Barrier to check.
+    /// @return The index of the overlapping pending barrier, or -1 if there is no overlap.
+    [[nodiscard]]
+    int64_t find_pending_overlap(VkImageMemoryBarrier2 const& barrier) const;
+
 private:
+    /// @brief Shadow copy of the state bound in the command buffer, used to drop redundant binds.
+    struct BoundState
+    {
+        VkPipeline pipeline;
+        bool has_topology;
+        VkPrimitiveTopology topology;
+        uint32_t viewport_count;
+        VkViewport viewports[BONSAI_MAX_VIEWPORT_COUNT];
+        uint32_t scissor_count;
+        VkRect2D scissors[BONSAI_MAX_VIEWPORT_COUNT];
+        uint32_t vertex_binding_mask;
+        VkBuffer vertex_buffers[BONSAI_MAX_VERTEX_BUFFER_BINDINGS];
+        VkDeviceSize vertex_offsets[BONSAI_MAX_VERTEX_BUFFER_BINDINGS];
+        VkBuffer index_buffer;
+        VkDeviceSize index_offset;
+        VkIndexType index_type;
+    };
+
     VkCommandBuffer m_command_buffer = VK_NULL_HANDLE;
+    VulkanDepthPyramidPass* m_depth_pyramid_pass = nullptr;
+    VulkanGpuProfiler* m_gpu_profiler = nullptr;
+    uint32_t m_max_viewport_count = 1;
+    RenderCommandStatistics m_statistics = {};
+    std::vector<VkImageMemoryBarrier2> m_pending_image_barriers = {};
+    std::vector<VkImageMemoryBarrier2> m_transition_barriers = {};
+    VkMemoryBarrier2 m_pending_memory_barrier = {};
+    BoundState m_bound_state = {};
+    bool m_in_render_pass = false;
+
+    // Parallel render pass state, secondary recorders store the inherited attachment formats
+    VulkanParallelRecorderPool* m_parallel_recorder_pool = nullptr;
+    std::vector<VulkanRenderCommands> m_parallel_recorders = {};
+    std::vector<VkCommandBuffer> m_parallel_command_buffers = {};
+    uint32_t m_parallel_recorder_count = 0;
+    bool m_is_secondary = false;
+    std::vector<VkFormat> m_inherited_color_formats = {};
+    VkFormat m_inherited_depth_format = VK_FORMAT_UNDEFINED;
+    VkFormat m_inherited_stencil_format = VK_FORMAT_UNDEFINED;
+    VkSampleCountFlagBits m_inherited_sample_count = VK_SAMPLE_COUNT_1_BIT;
+    uint32_t m_inherited_view_mask = 0;
+    VkQueryPipelineStatisticFlags m_inherited_pipeline_statistics = 0;
 };
 
 #endif //BONSAI_RENDERER_VULKAN_RENDER_COMMANDS_HPP
\ No newline at end of file
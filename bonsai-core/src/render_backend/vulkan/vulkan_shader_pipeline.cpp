@@ -21,11 +21,6 @@ VulkanShaderPipeline::VulkanShaderPipeline(
 VulkanShaderPipeline::~VulkanShaderPipeline()
 {
     vkDestroyPipeline(m_device, m_pipeline, nullptr);
-    vkDestroyPipelineLayout(m_device, m_layout, nullptr);
-    for (auto const& layout : m_descriptor_set_layouts)
-    {
-        vkDestroyDescriptorSetLayout(m_device, layout, nullptr);
-    }
 }
 
 VkPipelineBindPoint VulkanShaderPipeline::get_bind_point() const
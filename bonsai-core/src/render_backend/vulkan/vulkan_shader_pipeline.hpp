@@ -6,6 +6,8 @@
 #include <volk.h>
 #include "bonsai/render_backend/render_backend.hpp"
 
+/// @brief Vulkan shader pipeline, owns the pipeline handle only.
+/// Descriptor set layouts & the pipeline layout are owned by the layout cache, so pipelines with equal layouts share them.
 class VulkanShaderPipeline : public ShaderPipeline
 {
 public:
@@ -22,6 +24,9 @@ public:
     VulkanShaderPipeline(VulkanShaderPipeline const&) = delete;
     VulkanShaderPipeline &operator=(VulkanShaderPipeline const&) = delete;
 
+    [[nodiscard]]
+    std::vector<VkDescriptorSetLayout> const& get_descriptor_set_layouts() const { return m_descriptor_set_layouts; }
+
     [[nodiscard]]
     VkPipelineLayout get_pipeline_layout() const { return m_layout; }
 
@@ -1,41 +1,97 @@
 #include "vulkan_texture.hpp"
 
+#include "bonsai/core/assert.hpp"
+
 VulkanTexture::VulkanTexture(VkImage image, VkImageView image_view, VulkanTextureDesc desc)
     :
     m_image(image),
     m_image_view(image_view),
-    m_desc(desc)
+    m_desc(desc),
+    m_state_tracker(desc.vk_aspect_flags, desc.mip_levels, desc.array_layers)
 {
     //
 }
 
-VulkanTexture::VulkanTexture(VkDevice device, VmaAllocator allocator, VkImage image, VkImageView image_view, VmaAllocation allocation, VulkanTextureDesc desc)
+VulkanTexture::VulkanTexture(
+    VkDevice device,
+    VmaAllocator allocator,
+    VkImage image,
+    VkImageView image_view,
+    std::vector<VkImageView> const& mip_views,
+    VmaAllocation allocation,
+    VulkanTextureDesc desc
+)
     :
     m_device(device),
     m_allocator(allocator),
     m_image(image),
     m_image_view(image_view),
+    m_mip_views(mip_views),
     m_allocation(allocation),
-    m_desc(desc)
+    m_desc(desc),
+    m_state_tracker(desc.vk_aspect_flags, desc.mip_levels, desc.array_layers)
 {
     //
 }
 
 VulkanTexture::~VulkanTexture()
 {
-    // When allocator and allocation are unset the resource is externally managed
-    if (m_allocator != VK_NULL_HANDLE && m_allocation != VK_NULL_HANDLE)
+    // When the allocator is unset the resource is externally managed, aliased textures have no allocation of their own
+    if (m_allocator != VK_NULL_HANDLE)
     {
+        for (auto const& mip_view : m_mip_views)
+        {
+            vkDestroyImageView(m_device, mip_view, nullptr);
+        }
         vkDestroyImageView(m_device, m_image_view, nullptr);
         vmaDestroyImage(m_allocator, m_image, m_allocation);
     }
 }
 
-VkImageLayout VulkanTexture::set_next_layout(VkImageLayout next_layout)
+uint32_t VulkanTexture::transition(
+    VkImageSubresourceRange const& range,
+    ImageSubresourceState const& next_state,
+    bool discard,
+    std::vector<VkImageMemoryBarrier2>& barriers
+)
+{
+    return m_state_tracker.transition(m_image, range, next_state, discard, barriers);
+}
+
+VkImageView VulkanTexture::get_mip_view(uint32_t mip_level) const
+{
+    BONSAI_ASSERT(mip_level < m_desc.mip_levels && "Mip level out of range for texture!");
+    if (m_mip_views.empty())
+    {
+        return m_image_view; // Single mip textures don't need separate views
+    }
+
+    return m_mip_views[mip_level];
+}
+
+VkImageSubresourceRange VulkanTexture::get_subresource_range() const
+{
+    return VkImageSubresourceRange{
+        m_desc.vk_aspect_flags,
+        0, m_desc.mip_levels,
+        0, m_desc.array_layers,
+    };
+}
+
+VkImageSubresourceRange VulkanTexture::get_subresource_range(
+    uint32_t base_mip_level,
+    uint32_t mip_level_count,
+    uint32_t base_array_layer,
+    uint32_t array_layer_count
+) const
 {
-    VkImageLayout const previous = m_layout;
-    m_layout = next_layout;
-    return previous;
+    BONSAI_ASSERT(base_mip_level + mip_level_count <= m_desc.mip_levels && "Mip range out of bounds for texture!");
+    BONSAI_ASSERT(base_array_layer + array_layer_count <= m_desc.array_layers && "Layer range out of bounds for texture!");
+    return VkImageSubresourceRange{
+        m_desc.vk_aspect_flags,
+        base_mip_level, mip_level_count,
+        base_array_layer, array_layer_count,
+    };
 }
 
 VkImageAspectFlags VulkanTexture::get_image_aspect() const
@@ -2,23 +2,36 @@
 #ifndef BONSAI_RENDERER_VULKAN_TEXTURE_HPP
 #define BONSAI_RENDERER_VULKAN_TEXTURE_HPP
 
+#include <vector>
 #include <volk.h>
 #include <vk_mem_alloc.h>
 #include "bonsai/render_backend/render_backend.hpp"
+#include "image_state_tracker.hpp"
 
 /// @brief Texture description, stores metadata used to create a texture.
 struct VulkanTextureDesc
 {
     RenderFormat format;
     RenderExtent3D extent;
+    uint32_t mip_levels;
+    uint32_t array_layers;
     VkImageAspectFlags vk_aspect_flags;
+    VkSampleCountFlagBits vk_sample_count;
 };
 
 class VulkanTexture : public RenderTexture
 {
 public:
     VulkanTexture(VkImage image, VkImageView image_view, VulkanTextureDesc desc);
-    VulkanTexture(VkDevice device, VmaAllocator allocator, VkImage image, VkImageView image_view, VmaAllocation allocation, VulkanTextureDesc desc);
+    VulkanTexture(
+        VkDevice device,
+        VmaAllocator allocator,
+        VkImage image,
+        VkImageView image_view,
+        std::vector<VkImageView> const& mip_views,
+        VmaAllocation allocation,
+        VulkanTextureDesc desc
+    );
     ~VulkanTexture() override;
 
     VulkanTexture(VulkanTexture const&) = delete;
@@ -28,16 +41,34 @@ public:
 
     RenderExtent3D extent() const override { return m_desc.extent; }
 
-    /// @brief Set the next tracked vulkan image layout.
-    /// @param next_layout Next layout.
-    /// @return The previous image layout.
-    [[nodiscard]]
-    VkImageLayout set_next_layout(VkImageLayout next_layout);
+    uint32_t mip_levels() const override { return m_desc.mip_levels; }
+
+    uint32_t array_layers() const override { return m_desc.array_layers; }
+
+    /// @brief Transition a subresource range of this texture to a new state.
+    /// @param range Subresource range to transition.
+    /// @param next_state State to transition the range to.
+    /// @param discard Discard the previous contents of the range.
+    /// @param barriers Output barrier list, emitted barriers are appended to this list.
+    /// @return The number of barriers appended to the barrier list.
+    uint32_t transition(
+        VkImageSubresourceRange const& range,
+        ImageSubresourceState const& next_state,
+        bool discard,
+        std::vector<VkImageMemoryBarrier2>& barriers
+    );
 
-    /// @brief Get the current tracked vulkan image layout.
+    /// @brief Hand over the texture memory from other aliased resources, all subresources become undefined.
+    /// @param stage_mask Pipeline stages of the last accesses to the aliased memory.
+    /// @param access_mask Access types of the last accesses to the aliased memory.
+    void alias(VkPipelineStageFlags2 stage_mask, VkAccessFlags2 access_mask) { m_state_tracker.alias(stage_mask, access_mask); }
+
+    /// @brief Get the tracked vulkan image layout of a single subresource.
+    /// @param mip_level Mip level of the subresource.
+    /// @param array_layer Array layer of the subresource.
     /// @return The current image layout.
     [[nodiscard]]
-    VkImageLayout get_current_layout() const { return m_layout; }
+    VkImageLayout get_layout(uint32_t mip_level, uint32_t array_layer) const { return m_state_tracker.get_layout(mip_level, array_layer); }
 
     /// @brief Get the underlying Vulkan image.
     /// @return The Vulkan image handle.
@@ -49,6 +80,36 @@ public:
     [[nodiscard]]
     VkImageView get_image_view() const { return m_image_view; }
 
+    /// @brief Get an image view that only covers a single mip level, including all array layers.
+    /// @param mip_level Mip level to get the view for.
+    /// @return The Vulkan image view handle for the mip level.
+    [[nodiscard]]
+    VkImageView get_mip_view(uint32_t mip_level) const;
+
+    /// @brief Get the subresource range covering all mip levels and array layers of this texture.
+    /// @return The full Vulkan image subresource range.
+    [[nodiscard]]
+    VkImageSubresourceRange get_subresource_range() const;
+
+    /// @brief Get a subresource range covering a set of mip levels and array layers of this texture.
+    /// @param base_mip_level First mip level in the range.
+    /// @param mip_level_count Number of mip levels in the range.
+    /// @param base_array_layer First array layer in the range.
+    /// @param array_layer_count Number of array layers in the range.
+    /// @return The Vulkan image subresource range.
+    [[nodiscard]]
+    VkImageSubresourceRange get_subresource_range(
+        uint32_t base_mip_level,
+        uint32_t mip_level_count,
+        uint32_t base_array_layer,
+        uint32_t array_layer_count
+    ) const;
+
+    /// @brief Get the Vulkan sample count.
+    /// @return The Vulkan sample count of the image.
+    [[nodiscard]]
+    VkSampleCountFlagBits get_sample_count() const { return m_desc.vk_sample_count; }
+
     /// @brief Get the Vulkan image aspect flags.
     /// @return The Vulkan image aspect flags for the stored format.
     [[nodiscard]]
@@ -59,9 +120,10 @@ private:
     VmaAllocator m_allocator = VK_NULL_HANDLE;
     VkImage m_image = VK_NULL_HANDLE;
     VkImageView m_image_view = VK_NULL_HANDLE;
+    std::vector<VkImageView> m_mip_views = {};
     VmaAllocation m_allocation = VK_NULL_HANDLE;
     VulkanTextureDesc m_desc = {};
-    VkImageLayout m_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    ImageStateTracker m_state_tracker = {};
 };
 
 #endif //BONSAI_RENDERER_VULKAN_TEXTURE_HPP
\ No newline at end of file
@@ -3,19 +3,27 @@
 #define VOLK_IMPLEMENTATION
 
 #include <algorithm>
+#include <cstdlib>
 #include <backends/imgui_impl_vulkan.h>
 #include <vk_mem_alloc.h>
 #include <volk.h>
 #include "bonsai/core/assert.hpp"
+#include "bonsai/core/event_stream.hpp"
 #include "bonsai/core/fatal_exit.hpp"
 #include "bonsai/core/logger.hpp"
+#include "bonsai/core/profiler.hpp"
+#include "render_backend/builtin_shaders.hpp"
 #include "render_backend/vulkan/enum_conversion.hpp"
 #include "render_backend/vulkan/vk_check.hpp"
 #include "render_backend/vulkan/vulkan_buffer.hpp"
+#include "render_backend/vulkan/vulkan_memory_heap.hpp"
 #include "render_backend/vulkan/vulkan_shader_pipeline.hpp"
 #include "render_backend/vulkan/vulkan_texture.hpp"
 #include "bonsai_config.hpp"
 
+/// @brief Environment variable selecting a precompiled shader bundle, e.g. BONSAI_SHADER_BUNDLE=shaders.bundle.
+static char const* SHADER_BUNDLE_ENV_VAR = "BONSAI_SHADER_BUNDLE";
+
 [[maybe_unused]]
 static VKAPI_ATTR VkBool32 VKAPI_CALL vulkan_debug_callback(
     VkDebugUtilsMessageSeverityFlagBitsEXT message_severity,
@@ -147,7 +155,9 @@ std::vector<uint32_t> VulkanQueueFamilies::get_unique() const
     return queue_families;
 }
 
-VulkanRenderBackend::VulkanRenderBackend(PlatformSurface* platform_surface, ImGuiContext* imgui_context)
+VulkanRenderBackend::VulkanRenderBackend(PlatformSurface* platform_surface, ImGuiContext* imgui_context, JobSystem* job_system)
+    :
+    m_shader_compiler_pool(0, job_system)
 {
     IMGUI_CHECKVERSION();
     ImGui::SetCurrentContext(imgui_context);
@@ -334,7 +344,51 @@ VulkanRenderBackend::VulkanRenderBackend(PlatformSurface* platform_surface, ImGu
     {
         BONSAI_FATAL_EXIT("Failed to allocate Vulkan frame command buffer(s)\n");
     }
-    m_frame_commands = VulkanRenderCommands(m_frame_cmd_buffer);
+
+    // Pipelines with matching shader interfaces share their layouts, so the cache must exist before any pipeline is created
+    m_layout_cache = new VulkanLayoutCache(m_device);
+
+    // Reflection data is cached next to compiled shaders, so pipelines sharing shaders only reflect them once
+    m_shader_variant_cache.set_reflect_function(SPIRVReflector::reflect);
+
+    // Shaders found in the bundle are loaded from it, missing permutations are still compiled at runtime
+    char const* shader_bundle_path = std::getenv(SHADER_BUNDLE_ENV_VAR);
+    if (shader_bundle_path != nullptr && shader_bundle_path[0] != '\0' && m_shader_bundle.open(shader_bundle_path))
+    {
+        m_shader_variant_cache.set_bundle(&m_shader_bundle);
+    }
+
+    ComputePipelineDescriptor depth_pyramid_pipeline_descriptor{};
+    depth_pyramid_pipeline_descriptor.compute_shader.source_kind = ShaderSourceKindInline;
+    depth_pyramid_pipeline_descriptor.compute_shader.entrypoint = BONSAI_DEPTH_PYRAMID_SHADER_ENTRYPOINT;
+    depth_pyramid_pipeline_descriptor.compute_shader.shader_source = BONSAI_DEPTH_PYRAMID_SHADER;
+
+    VulkanShaderPipeline* depth_pyramid_pipeline = dynamic_cast<VulkanShaderPipeline*>(create_compute_pipeline(depth_pyramid_pipeline_descriptor));
+    if (depth_pyramid_pipeline == nullptr)
+    {
+        BONSAI_FATAL_EXIT("Failed to create Vulkan depth pyramid pipeline\n");
+    }
+    m_depth_pyramid_pass = new VulkanDepthPyramidPass(m_device, m_allocator, depth_pyramid_pipeline);
+    m_parallel_recorder_pool = new VulkanParallelRecorderPool(m_device, m_queue_families.graphics_family);
+    m_gpu_profiler = new VulkanGpuProfiler(
+        m_device,
+        m_device_properties.properties2.properties.limits.timestampPeriod,
+        queue_families[m_queue_families.graphics_family].timestampValidBits,
+        enabled_features.features2.features.pipelineStatisticsQuery == VK_TRUE
+            && enabled_features.features2.features.inheritedQueries == VK_TRUE
+    );
+
+    // Without multiViewport support draws are limited to a single viewport & scissor rect
+    uint32_t const max_viewport_count = enabled_features.features2.features.multiViewport == VK_TRUE
+        ? std::min(m_device_properties.properties2.properties.limits.maxViewports, BONSAI_MAX_VIEWPORT_COUNT)
+        : 1;
+    m_frame_commands = VulkanRenderCommands(
+        m_frame_cmd_buffer,
+        m_depth_pyramid_pass,
+        m_parallel_recorder_pool,
+        m_gpu_profiler,
+        max_viewport_count
+    );
 
     VkPipelineRenderingCreateInfo imgui_pipeline_rendering_info{};
     imgui_pipeline_rendering_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
@@ -373,6 +427,10 @@ VulkanRenderBackend::~VulkanRenderBackend()
     VulkanRenderBackend::wait_idle();
     ImGui_ImplVulkan_Shutdown();
 
+    delete m_gpu_profiler;
+    delete m_parallel_recorder_pool;
+    delete m_depth_pyramid_pass;
+    delete m_layout_cache;
     vkDestroyCommandPool(m_device, m_graphics_cmd_pool, nullptr);
 
     vkDestroySemaphore(m_device, m_swap_available, nullptr);
@@ -411,6 +469,7 @@ void VulkanRenderBackend::reconfigure_swap_chain(uint32_t width, uint32_t height
         m_swapchain_capabilities,
         m_swapchain_config
     );
+    BONSAI_ENGINE_EVENT(EventTypeSwapchainRecreated, m_swapchain_config.image_extent.width, m_swapchain_config.image_extent.height);
 }
 
 RenderExtent2D VulkanRenderBackend::get_swap_extent() const
@@ -432,8 +491,14 @@ bool VulkanRenderBackend::is_swap_srgb() const
         || m_swapchain_capabilities.render_format == RenderFormatRGBA8_SRGB;
 }
 
+void VulkanRenderBackend::imgui_new_frame()
+{
+    ImGui_ImplVulkan_NewFrame();
+}
+
 RenderBackendFrameResult VulkanRenderBackend::new_frame()
 {
+    BONSAI_ENGINE_PROFILE_SCOPE("RenderBackend::new_frame");
     vkWaitForFences(m_device, 1, &m_frame_ready, VK_TRUE, UINT64_MAX);
     VkResult const acquire_result = vkAcquireNextImageKHR(m_device, m_swapchain_config.swapchain, UINT64_MAX, m_swap_available, VK_NULL_HANDLE, &m_active_swap_idx);
     if (VK_FAILED(acquire_result)
@@ -447,12 +512,15 @@ RenderBackendFrameResult VulkanRenderBackend::new_frame()
     }
 
     vkResetFences(m_device, 1, &m_frame_ready); // We're committed now to finishing this frame
-    ImGui_ImplVulkan_NewFrame();
+    m_depth_pyramid_pass->reset();
+    m_parallel_recorder_pool->reset();
+    m_gpu_profiler->new_frame(m_frame_idx);
     return RenderBackendFrameResult::Ok;
 }
 
 RenderBackendFrameResult VulkanRenderBackend::end_frame()
 {
+    BONSAI_ENGINE_PROFILE_SCOPE("RenderBackend::end_frame");
     VkPipelineStageFlags const wait_stages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
     VkSubmitInfo frame_submit_info = {};
     frame_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -495,6 +563,11 @@ RenderBackendFrameResult VulkanRenderBackend::end_frame()
     return RenderBackendFrameResult::Ok;
 }
 
+RenderGpuProfile const& VulkanRenderBackend::get_gpu_profile() const
+{
+    return m_gpu_profiler->get_resolved_profile();
+}
+
 RenderCommands* VulkanRenderBackend::get_frame_commands()
 {
     return &m_frame_commands;
@@ -511,23 +584,6 @@ RenderBuffer* VulkanRenderBackend::create_buffer(
     bool can_map
 )
 {
-    // Set buffer usage flags
-    VkBufferUsageFlags usage_flags = VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-    if (buffer_usage & RenderBufferUsageTransferSrc)
-        usage_flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    if (buffer_usage & RenderBufferUsageTransferDst)
-        usage_flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-    if (buffer_usage & RenderBufferUsageUniformBuffer)
-        usage_flags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-    if (buffer_usage & RenderBufferUsageStorageBuffer)
-        usage_flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-    if (buffer_usage & RenderBufferUsageIndexBuffer)
-        usage_flags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-    if (buffer_usage & RenderBufferUsageVertexBuffer)
-        usage_flags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-    if (buffer_usage & RenderBufferUsageIndirectBuffer)
-        usage_flags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
-
     // Set memory property flags
     VkMemoryPropertyFlags memory_property_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
     VmaAllocationCreateFlags allocation_create_flags = 0;
@@ -538,15 +594,7 @@ RenderBuffer* VulkanRenderBackend::create_buffer(
         allocation_create_flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
     }
 
-    VkBufferCreateInfo buffer_create_info{};
-    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    buffer_create_info.pNext = nullptr;
-    buffer_create_info.flags = 0;
-    buffer_create_info.usage = usage_flags;
-    buffer_create_info.size = static_cast<uint32_t>(size);
-    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    buffer_create_info.queueFamilyIndexCount = 0;
-    buffer_create_info.pQueueFamilyIndices = nullptr;
+    VkBufferCreateInfo const buffer_create_info = get_buffer_create_info(size, buffer_usage);
 
     VmaAllocationCreateInfo allocation_create_info{};
     allocation_create_info.flags = allocation_create_flags;
@@ -560,10 +608,12 @@ RenderBuffer* VulkanRenderBackend::create_buffer(
 
     VkBuffer buffer = VK_NULL_HANDLE;
     VmaAllocation allocation = VK_NULL_HANDLE;
-    if (VK_FAILED(vmaCreateBuffer(m_allocator, &buffer_create_info, &allocation_create_info, &buffer, &allocation, nullptr)))
+    VmaAllocationInfo allocation_info{};
+    if (VK_FAILED(vmaCreateBuffer(m_allocator, &buffer_create_info, &allocation_create_info, &buffer, &allocation, &allocation_info)))
     {
         return nullptr;
     }
+    BONSAI_ENGINE_EVENT(EventTypeAllocation, 0, allocation_info.size);
 
     VulkanBufferDesc buffer_desc{};
     buffer_desc.size = size;
@@ -583,52 +633,17 @@ RenderTexture* VulkanRenderBackend::create_texture(
     RenderTextureTilingMode tiling_mode
 )
 {
-    // Set image usage flags
-    VkImageUsageFlags usage_flags = 0;
-    if (texture_usage & RenderTextureUsageTransferSrc)
-        usage_flags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-    if (texture_usage & RenderTextureUsageTransferDst)
-        usage_flags |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-    if (texture_usage & RenderTextureUsageSampled)
-        usage_flags |= VK_IMAGE_USAGE_SAMPLED_BIT;
-    if (texture_usage & RenderTextureUsageStorage)
-        usage_flags |= VK_IMAGE_USAGE_STORAGE_BIT;
-    if (texture_usage & RenderTextureUsageRenderTarget)
-        usage_flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-    if (texture_usage & RenderTextureUsageDepthStencilTarget)
-        usage_flags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-
-    // Set flags, depth, and array layers based on image type
-    VkImageCreateFlags image_flags = 0;
-    uint32_t depth = 1;
-    uint32_t array_layers = depth_or_layers;
-    if (texture_type == RenderTextureType3D)
-    {
-        depth = depth_or_layers;
-        array_layers = 1;
-    }
-    else if (texture_type == RenderTextureType2D && array_layers == 6)
-    {
-        image_flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
-    }
-
-    VkFormat const image_format = get_vulkan_format(format);
-    VkImageCreateInfo image_create_info{};
-    image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    image_create_info.pNext = nullptr;
-    image_create_info.flags = image_flags;
-    image_create_info.imageType = get_vulkan_image_type(texture_type);
-    image_create_info.format = image_format;
-    image_create_info.extent = VkExtent3D{ width, height, depth };
-    image_create_info.mipLevels = mip_levels;
-    image_create_info.arrayLayers = array_layers;
-    image_create_info.samples = static_cast<VkSampleCountFlagBits>(sample_count);
-    image_create_info.tiling = get_vulkan_image_tiling(tiling_mode);
-    image_create_info.usage = usage_flags;
-    image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    image_create_info.queueFamilyIndexCount = 0;
-    image_create_info.pQueueFamilyIndices = nullptr;
-    image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkImageCreateInfo const image_create_info = get_image_create_info(
+        texture_type,
+        format,
+        width,
+        height,
+        depth_or_layers,
+        mip_levels,
+        sample_count,
+        texture_usage,
+        tiling_mode
+    );
 
     VmaAllocationCreateInfo allocation_create_info{};
     allocation_create_info.flags = 0;
@@ -642,112 +657,240 @@ RenderTexture* VulkanRenderBackend::create_texture(
 
     VkImage image = VK_NULL_HANDLE;
     VmaAllocation allocation = VK_NULL_HANDLE;
-    if (VK_FAILED(vmaCreateImage(m_allocator, &image_create_info, &allocation_create_info, &image, &allocation, nullptr)))
+    VmaAllocationInfo allocation_info{};
+    if (VK_FAILED(vmaCreateImage(m_allocator, &image_create_info, &allocation_create_info, &image, &allocation, &allocation_info)))
     {
         return nullptr;
     }
+    BONSAI_ENGINE_EVENT(EventTypeAllocation, 1, allocation_info.size);
 
-    // Set image view type based  on input params
-    VkImageViewType view_type = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
-    if (texture_type == RenderTextureType1D && depth_or_layers == 1)
-        view_type = VK_IMAGE_VIEW_TYPE_1D;
-    else if (texture_type == RenderTextureType1D && depth_or_layers > 1)
-        view_type = VK_IMAGE_VIEW_TYPE_1D_ARRAY;
-    else if (texture_type == RenderTextureType2D && depth_or_layers == 1)
-        view_type = VK_IMAGE_VIEW_TYPE_2D;
-    else if (texture_type == RenderTextureType2D && depth_or_layers == 6) // Specific case for cubemaps
-        view_type = VK_IMAGE_VIEW_TYPE_CUBE;
-    else if (texture_type == RenderTextureType2D && depth_or_layers > 1)
-        view_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-    else if (texture_type == RenderTextureType3D)
-        view_type = VK_IMAGE_VIEW_TYPE_3D;
+    return create_texture_object(image, allocation, image_create_info, texture_type, format);
+}
 
-    VkImageAspectFlags image_aspect = get_vulkan_aspect_flags(format);
-    VkImageViewCreateInfo view_create_info{};
-    view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    view_create_info.pNext = nullptr;
-    view_create_info.flags = 0;
-    view_create_info.image = image;
-    view_create_info.viewType = view_type;
-    view_create_info.format = image_format;
-    view_create_info.components = VkComponentMapping{
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
-        VK_COMPONENT_SWIZZLE_IDENTITY,
+RenderMemoryRequirements VulkanRenderBackend::get_buffer_memory_requirements(size_t size, RenderBufferUsageFlags buffer_usage) const
+{
+    VkBufferCreateInfo const buffer_create_info = get_buffer_create_info(size, buffer_usage);
+
+    VkDeviceBufferMemoryRequirements memory_requirements_info{};
+    memory_requirements_info.sType = VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS;
+    memory_requirements_info.pNext = nullptr;
+    memory_requirements_info.pCreateInfo = &buffer_create_info;
+
+    VkMemoryRequirements2 memory_requirements{};
+    memory_requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    memory_requirements.pNext = nullptr;
+    vkGetDeviceBufferMemoryRequirements(m_device, &memory_requirements_info, &memory_requirements);
+
+    return RenderMemoryRequirements{
+        memory_requirements.memoryRequirements.size,
+        memory_requirements.memoryRequirements.alignment,
+        memory_requirements.memoryRequirements.memoryTypeBits,
     };
-    view_create_info.subresourceRange = VkImageSubresourceRange{
-        image_aspect,
-        0, mip_levels,
-        0, array_layers,
+}
+
+RenderMemoryRequirements VulkanRenderBackend::get_texture_memory_requirements(
+    RenderTextureType texture_type,
+    RenderFormat format,
+    uint32_t width,
+    uint32_t height,
+    uint32_t depth_or_layers,
+    uint32_t mip_levels,
+    SampleCount sample_count,
+    RenderTextureUsageFlags texture_usage,
+    RenderTextureTilingMode tiling_mode
+) const
+{
+    VkImageCreateInfo const image_create_info = get_image_create_info(
+        texture_type,
+        format,
+        width,
+        height,
+        depth_or_layers,
+        mip_levels,
+        sample_count,
+        texture_usage,
+        tiling_mode
+    );
+
+    VkDeviceImageMemoryRequirements memory_requirements_info{};
+    memory_requirements_info.sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+    memory_requirements_info.pNext = nullptr;
+    memory_requirements_info.pCreateInfo = &image_create_info;
+    memory_requirements_info.planeAspect = static_cast<VkImageAspectFlagBits>(0);
+
+    VkMemoryRequirements2 memory_requirements{};
+    memory_requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    memory_requirements.pNext = nullptr;
+    vkGetDeviceImageMemoryRequirements(m_device, &memory_requirements_info, &memory_requirements);
+
+    return RenderMemoryRequirements{
+        memory_requirements.memoryRequirements.size,
+        memory_requirements.memoryRequirements.alignment,
+        memory_requirements.memoryRequirements.memoryTypeBits,
     };
+}
 
-    VkImageView image_view = VK_NULL_HANDLE;
-    if (VK_FAILED(vkCreateImageView(m_device, &view_create_info, nullptr, &image_view)))
+RenderMemoryHeap* VulkanRenderBackend::create_memory_heap(RenderMemoryRequirements const& requirements)
+{
+    VkMemoryRequirements memory_requirements{};
+    memory_requirements.size = requirements.size;
+    memory_requirements.alignment = requirements.alignment;
+    memory_requirements.memoryTypeBits = requirements.memory_type_bits;
+
+    VmaAllocationCreateInfo allocation_create_info{};
+    allocation_create_info.flags = 0;
+    allocation_create_info.usage = VMA_MEMORY_USAGE_UNKNOWN;
+    allocation_create_info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    allocation_create_info.preferredFlags = 0;
+    allocation_create_info.memoryTypeBits = requirements.memory_type_bits;
+    allocation_create_info.pool = VK_NULL_HANDLE;
+    allocation_create_info.pUserData = nullptr;
+    allocation_create_info.priority = 1.0F;
+
+    VmaAllocation allocation = VK_NULL_HANDLE;
+    if (VK_FAILED(vmaAllocateMemory(m_allocator, &memory_requirements, &allocation_create_info, &allocation, nullptr)))
     {
-        vmaDestroyImage(m_allocator, image, allocation);
         return nullptr;
     }
 
-    VulkanTextureDesc texture_desc{};
-    texture_desc.format = format;
-    texture_desc.extent = { width, height, depth };
+    return new VulkanMemoryHeap(m_allocator, allocation, requirements.size);
+}
+
+RenderBuffer* VulkanRenderBackend::create_aliased_buffer(
+    RenderMemoryHeap* heap,
+    size_t offset,
+    size_t size,
+    RenderBufferUsageFlags buffer_usage
+)
+{
+    VulkanMemoryHeap const* vk_heap = dynamic_cast<VulkanMemoryHeap*>(heap);
+    BONSAI_ASSERT(vk_heap != nullptr && "Memory heap was NULL!");
+    BONSAI_ASSERT(offset + size <= vk_heap->size() && "Aliased buffer does not fit in memory heap!");
+
+    VkBufferCreateInfo const buffer_create_info = get_buffer_create_info(size, buffer_usage);
+    VkBuffer buffer = VK_NULL_HANDLE;
+    if (VK_FAILED(vmaCreateAliasingBuffer2(m_allocator, vk_heap->get_allocation(), offset, &buffer_create_info, &buffer)))
+    {
+        return nullptr;
+    }
 
-    return new VulkanTexture(m_device, m_allocator, image, image_view, allocation, texture_desc);
+    VulkanBufferDesc buffer_desc{};
+    buffer_desc.size = size;
+
+    // Aliased buffers don't own their allocation, the heap frees the memory
+    return new VulkanBuffer(m_allocator, buffer, VK_NULL_HANDLE, buffer_desc);
+}
+
+RenderTexture* VulkanRenderBackend::create_aliased_texture(
+    RenderMemoryHeap* heap,
+    size_t offset,
+    RenderTextureType texture_type,
+    RenderFormat format,
+    uint32_t width,
+    uint32_t height,
+    uint32_t depth_or_layers,
+    uint32_t mip_levels,
+    SampleCount sample_count,
+    RenderTextureUsageFlags texture_usage,
+    RenderTextureTilingMode tiling_mode
+)
+{
+    VulkanMemoryHeap const* vk_heap = dynamic_cast<VulkanMemoryHeap*>(heap);
+    BONSAI_ASSERT(vk_heap != nullptr && "Memory heap was NULL!");
+
+    VkImageCreateInfo const image_create_info = get_image_create_info(
+        texture_type,
+        format,
+        width,
+        height,
+        depth_or_layers,
+        mip_levels,
+        sample_count,
+        texture_usage,
+        tiling_mode
+    );
+
+    VkImage image = VK_NULL_HANDLE;
+    if (VK_FAILED(vmaCreateAliasingImage2(m_allocator, vk_heap->get_allocation(), offset, &image_create_info, &image)))
+    {
+        return nullptr;
+    }
+
+    // Aliased textures don't own their allocation, the heap frees the memory
+    return create_texture_object(image, VK_NULL_HANDLE, image_create_info, texture_type, format);
 }
 
 ShaderPipeline* VulkanRenderBackend::create_graphics_pipeline(GraphicsPipelineDescriptor pipeline_descriptor)
 {
+    BONSAI_ENGINE_PROFILE_SCOPE("RenderBackend::create_graphics_pipeline");
+    [[maybe_unused]] uint64_t const creation_start_ns = EventStream::get()->now();
     /*
      * This function is quite long, but since Vulkan pipeline setup takes quite a bit of state management
      * it's acceptable.
      */
     BONSAI_ASSERT(pipeline_descriptor.color_attachment_count <= BONSAI_MAX_COLOR_ATTACHMENT_COUNT && "The number of pipeline color attachments must be less than the max number of color attachments");
 
-    // Compiled used shader sources & store in compiled shaders array
-    std::vector<IDxcBlob*> compiled_shaders{};
-    std::unordered_map<VkShaderStageFlagBits, std::pair<ShaderSource, CComPtr<IDxcBlob>>> shaders{};
-    if (pipeline_descriptor.vertex_shader != nullptr)
+    // Compile used shader permutations in parallel & store in compiled shaders array, cached permutations are reused
+    ShaderSource const* stage_sources[] = { pipeline_descriptor.vertex_shader, pipeline_descriptor.fragment_shader };
+    VkShaderStageFlagBits const stage_flags[] = { VK_SHADER_STAGE_VERTEX_BIT, VK_SHADER_STAGE_FRAGMENT_BIT };
+    LPCWSTR const stage_profiles[] = { BONSAI_TARGET_PROFILE_VS, BONSAI_TARGET_PROFILE_PS };
+    std::vector<size_t> compile_stages{};
+    std::vector<ShaderCompileRequest> compile_requests{};
+    for (size_t i = 0; i < std::size(stage_sources); i++)
     {
-        CComPtr<IDxcBlob> vertex_shader{};
-        if (!compile_shader_source(*pipeline_descriptor.vertex_shader, BONSAI_TARGET_PROFILE_VS, &vertex_shader))
+        if (stage_sources[i] != nullptr)
         {
-            return nullptr;
+            compile_stages.push_back(i);
+            compile_requests.push_back(get_compile_request(*stage_sources[i], stage_profiles[i]));
         }
-        shaders[VK_SHADER_STAGE_VERTEX_BIT] = { *pipeline_descriptor.vertex_shader, vertex_shader };
-        compiled_shaders.push_back(vertex_shader);
     }
 
-    if (pipeline_descriptor.fragment_shader != nullptr)
+    std::vector<ShaderCompileResult> compile_results(compile_requests.size());
+    if (m_shader_variant_cache.compile_many(m_shader_compiler_pool, compile_requests.data(), compile_requests.size(), compile_results.data()) != compile_requests.size())
     {
-        CComPtr<IDxcBlob> fragment_shader{};
-        if (!compile_shader_source(*pipeline_descriptor.fragment_shader, BONSAI_TARGET_PROFILE_PS, &fragment_shader))
+        return nullptr;
+    }
+
+    std::vector<ShaderReflectionData> shader_reflections{};
+    std::unordered_map<VkShaderStageFlagBits, std::pair<ShaderSource, CComPtr<IDxcBlob>>> shaders{};
+    for (size_t i = 0; i < compile_stages.size(); i++)
+    {
+        size_t const stage = compile_stages[i];
+        shaders[stage_flags[stage]] = { *stage_sources[stage], compile_results[i].compiled_shader };
+        if (!compile_results[i].has_reflection)
         {
             return nullptr;
         }
-        shaders[VK_SHADER_STAGE_FRAGMENT_BIT] = { *pipeline_descriptor.fragment_shader, fragment_shader };
-        compiled_shaders.push_back(fragment_shader);
+        shader_reflections.push_back(compile_results[i].reflection);
     }
 
-    // Reflect shader info & bindings
-    SPIRVReflector reflector(compiled_shaders.data(), compiled_shaders.size());
+    // Merge cached shader reflection data into the pipeline interface
+    SPIRVReflector reflector(shader_reflections.data(), static_cast<uint32_t>(shader_reflections.size()));
     std::vector<VkDescriptorSetLayout> descriptor_set_layouts{};
     VkPipelineLayout pipeline_layout = generate_pipeline_layout(reflector, descriptor_set_layouts);
     if (pipeline_layout == VK_NULL_HANDLE)
     {
-        for (auto const& layout : descriptor_set_layouts)
-        {
-            vkDestroyDescriptorSetLayout(m_device, layout, nullptr);
-        }
         return nullptr;
     }
 
-    // Generate shader modules & shader stages
+    // Generate shader modules & shader stages, specialization data must stay alive until the pipeline is created
     std::vector<VkShaderModule> shader_modules{};
     std::vector<VkPipelineShaderStageCreateInfo> shader_stages{};
+    std::vector<VulkanSpecializationData> specialization_data(shaders.size());
+    std::vector<bool> constants_applied(pipeline_descriptor.specialization_constant_count, false);
     for (auto const& [stage, shader_data ] : shaders)
     {
         auto const& [ shader_source, shader_code ] = shader_data;
+        VulkanSpecializationData& stage_specialization_data = specialization_data[shader_stages.size()];
+        bool const specialized = get_specialization_data(
+            reflector,
+            stage,
+            pipeline_descriptor.specialization_constants,
+            pipeline_descriptor.specialization_constant_count,
+            constants_applied,
+            stage_specialization_data
+        );
+
         VkShaderModuleCreateInfo shader_module_create_info{};
         shader_module_create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
         shader_module_create_info.pNext = nullptr;
@@ -768,12 +911,20 @@ ShaderPipeline* VulkanRenderBackend::create_graphics_pipeline(GraphicsPipelineDe
         shader_stage_create_info.stage = stage;
         shader_stage_create_info.module = shader_module;
         shader_stage_create_info.pName = shader_source.entrypoint;
-        shader_stage_create_info.pSpecializationInfo = nullptr;
+        shader_stage_create_info.pSpecializationInfo = specialized ? &stage_specialization_data.info : nullptr;
 
         shader_modules.push_back(shader_module);
         shader_stages.push_back(shader_stage_create_info);
     }
 
+    for (uint32_t i = 0; i < pipeline_descriptor.specialization_constant_count; i++)
+    {
+        if (!constants_applied[i])
+        {
+            BONSAI_ENGINE_LOG_WARN("Specialization constant {} is not declared by any pipeline shader", pipeline_descriptor.specialization_constants[i].name);
+        }
+    }
+
     // Set up vertex input state
     // NOTE(nemjit001): This assumes contiguous input bindings
     std::vector<VkVertexInputBindingDescription> vertex_input_bindings{};
@@ -828,17 +979,15 @@ ShaderPipeline* VulkanRenderBackend::create_graphics_pipeline(GraphicsPipelineDe
     tessellation_state.flags = 0;
     tessellation_state.patchControlPoints = 0; // TODO(nemjit001): Reflect this from shaders
 
-    // Viewport and scissor will be set as dynamic state during command recording
-    VkViewport const viewport{ 0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 1.0F };
-    VkRect2D const scissor{ { 0, 0 }, { 1, 1 } };
+    // Viewports and scissors will be set as dynamic state with count during command recording
     VkPipelineViewportStateCreateInfo viewport_state{};
     viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewport_state.pNext = nullptr;
     viewport_state.flags = 0;
-    viewport_state.viewportCount = 1;
-    viewport_state.pViewports = &viewport;
-    viewport_state.scissorCount = 1;
-    viewport_state.pScissors = &scissor;
+    viewport_state.viewportCount = 0;
+    viewport_state.pViewports = nullptr;
+    viewport_state.scissorCount = 0;
+    viewport_state.pScissors = nullptr;
 
     VkPipelineRasterizationStateCreateInfo rasterization_state{};
     rasterization_state.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
@@ -924,8 +1073,8 @@ ShaderPipeline* VulkanRenderBackend::create_graphics_pipeline(GraphicsPipelineDe
 
     VkDynamicState dynamic_states[] = {
         // Dynamic states that are required to reach parity with DX12 pipeline state settings during command recording.
-        VK_DYNAMIC_STATE_VIEWPORT,
-        VK_DYNAMIC_STATE_SCISSOR,
+        VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT,
+        VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT,
         VK_DYNAMIC_STATE_BLEND_CONSTANTS,
         VK_DYNAMIC_STATE_DEPTH_BOUNDS,
         VK_DYNAMIC_STATE_STENCIL_REFERENCE,
@@ -947,7 +1096,7 @@ ShaderPipeline* VulkanRenderBackend::create_graphics_pipeline(GraphicsPipelineDe
     VkPipelineRenderingCreateInfo rendering_create_info{};
     rendering_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
     rendering_create_info.pNext = nullptr;
-    rendering_create_info.viewMask = 0;
+    rendering_create_info.viewMask = pipeline_descriptor.view_mask;
     rendering_create_info.colorAttachmentCount = pipeline_descriptor.color_attachment_count;
     rendering_create_info.pColorAttachmentFormats = color_attachment_formats;
     rendering_create_info.depthAttachmentFormat = get_vulkan_format(pipeline_descriptor.depth_stencil_attachment_format);
@@ -981,11 +1130,6 @@ ShaderPipeline* VulkanRenderBackend::create_graphics_pipeline(GraphicsPipelineDe
         {
             vkDestroyShaderModule(m_device, module, nullptr);
         }
-        vkDestroyPipelineLayout(m_device, pipeline_layout, nullptr);
-        for (auto const& layout : descriptor_set_layouts)
-        {
-            vkDestroyDescriptorSetLayout(m_device, layout, nullptr);
-        }
         return nullptr;
     }
 
@@ -993,31 +1137,49 @@ ShaderPipeline* VulkanRenderBackend::create_graphics_pipeline(GraphicsPipelineDe
     {
         vkDestroyShaderModule(m_device, module, nullptr);
     }
-    return new VulkanShaderPipeline(ShaderPipeline::Graphics, ShaderPipeline::WorkgroupSize{}, m_device, {}, pipeline_layout, pipeline);
+    BONSAI_ENGINE_EVENT(EventTypePipelineCreated, 0, EventStream::get()->now() - creation_start_ns);
+    return new VulkanShaderPipeline(ShaderPipeline::Graphics, ShaderPipeline::WorkgroupSize{}, m_device, descriptor_set_layouts, pipeline_layout, pipeline);
 }
 
 ShaderPipeline* VulkanRenderBackend::create_compute_pipeline(ComputePipelineDescriptor pipeline_descriptor)
 {
+    BONSAI_ENGINE_PROFILE_SCOPE("RenderBackend::create_compute_pipeline");
+    [[maybe_unused]] uint64_t const creation_start_ns = EventStream::get()->now();
     // Compile shader
-    CComPtr<IDxcBlob> shader_code{};
-    if (!compile_shader_source(pipeline_descriptor.compute_shader, BONSAI_TARGET_PROFILE_CS, &shader_code))
+    ShaderCompileResult compile_result{};
+    if (!compile_shader_source(pipeline_descriptor.compute_shader, BONSAI_TARGET_PROFILE_CS, compile_result) || !compile_result.has_reflection)
     {
         return nullptr;
     }
 
-    // Reflect shader info & bindings
-    SPIRVReflector reflector(shader_code);
+    // Use cached shader reflection data for the pipeline interface
+    IDxcBlob* shader_code = compile_result.compiled_shader;
+    SPIRVReflector reflector(&compile_result.reflection, 1);
     ShaderPipeline::WorkgroupSize workgroup_size{};
     reflector.get_workgroup_size(workgroup_size.x, workgroup_size.y, workgroup_size.z);
 
+    VulkanSpecializationData specialization_data{};
+    std::vector<bool> constants_applied(pipeline_descriptor.specialization_constant_count, false);
+    bool const specialized = get_specialization_data(
+        reflector,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        pipeline_descriptor.specialization_constants,
+        pipeline_descriptor.specialization_constant_count,
+        constants_applied,
+        specialization_data
+    );
+    for (uint32_t i = 0; i < pipeline_descriptor.specialization_constant_count; i++)
+    {
+        if (!constants_applied[i])
+        {
+            BONSAI_ENGINE_LOG_WARN("Specialization constant {} is not declared by the compute shader", pipeline_descriptor.specialization_constants[i].name);
+        }
+    }
+
     std::vector<VkDescriptorSetLayout> descriptor_set_layouts{};
     VkPipelineLayout pipeline_layout = generate_pipeline_layout(reflector, descriptor_set_layouts);
     if (pipeline_layout == VK_NULL_HANDLE)
     {
-        for (auto const& layout : descriptor_set_layouts)
-        {
-            vkDestroyDescriptorSetLayout(m_device, layout, nullptr);
-        }
         return nullptr;
     }
 
@@ -1031,11 +1193,6 @@ ShaderPipeline* VulkanRenderBackend::create_compute_pipeline(ComputePipelineDesc
     VkShaderModule shader_module = VK_NULL_HANDLE;
     if (VK_FAILED(vkCreateShaderModule(m_device, &shader_module_create_info, nullptr, &shader_module)))
     {
-        vkDestroyPipelineLayout(m_device, pipeline_layout, nullptr);
-        for (auto const& layout : descriptor_set_layouts)
-        {
-            vkDestroyDescriptorSetLayout(m_device, layout, nullptr);
-        }
         return nullptr;
     }
 
@@ -1049,7 +1206,7 @@ ShaderPipeline* VulkanRenderBackend::create_compute_pipeline(ComputePipelineDesc
     pipeline_create_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
     pipeline_create_info.stage.module = shader_module;
     pipeline_create_info.stage.pName = pipeline_descriptor.compute_shader.entrypoint;
-    pipeline_create_info.stage.pSpecializationInfo = nullptr;
+    pipeline_create_info.stage.pSpecializationInfo = specialized ? &specialization_data.info : nullptr;
     pipeline_create_info.layout = pipeline_layout;
     pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE;
     pipeline_create_info.basePipelineIndex = 0;
@@ -1058,18 +1215,203 @@ ShaderPipeline* VulkanRenderBackend::create_compute_pipeline(ComputePipelineDesc
     if (VK_FAILED(vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &pipeline)))
     {
         vkDestroyShaderModule(m_device, shader_module, nullptr);
-        vkDestroyPipelineLayout(m_device, pipeline_layout, nullptr);
-        for (auto const& layout : descriptor_set_layouts)
-        {
-            vkDestroyDescriptorSetLayout(m_device, layout, nullptr);
-        }
         return nullptr;
     }
 
     vkDestroyShaderModule(m_device, shader_module, nullptr);
+    BONSAI_ENGINE_EVENT(EventTypePipelineCreated, 1, EventStream::get()->now() - creation_start_ns);
     return new VulkanShaderPipeline(ShaderPipeline::Compute, workgroup_size, m_device, descriptor_set_layouts, pipeline_layout, pipeline);
 }
 
+VkBufferCreateInfo VulkanRenderBackend::get_buffer_create_info(size_t size, RenderBufferUsageFlags buffer_usage)
+{
+    // Set buffer usage flags
+    VkBufferUsageFlags usage_flags = VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    if (buffer_usage & RenderBufferUsageTransferSrc)
+        usage_flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    if (buffer_usage & RenderBufferUsageTransferDst)
+        usage_flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    if (buffer_usage & RenderBufferUsageUniformBuffer)
+        usage_flags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    if (buffer_usage & RenderBufferUsageStorageBuffer)
+        usage_flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (buffer_usage & RenderBufferUsageIndexBuffer)
+        usage_flags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    if (buffer_usage & RenderBufferUsageVertexBuffer)
+        usage_flags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if (buffer_usage & RenderBufferUsageIndirectBuffer)
+        usage_flags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+    VkBufferCreateInfo buffer_create_info{};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.pNext = nullptr;
+    buffer_create_info.flags = 0;
+    buffer_create_info.usage = usage_flags;
+    buffer_create_info.size = static_cast<uint32_t>(size);
+    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    buffer_create_info.queueFamilyIndexCount = 0;
+    buffer_create_info.pQueueFamilyIndices = nullptr;
+
+    return buffer_create_info;
+}
+
+VkImageCreateInfo VulkanRenderBackend::get_image_create_info(
+    RenderTextureType texture_type,
+    RenderFormat format,
+    uint32_t width,
+    uint32_t height,
+    uint32_t depth_or_layers,
+    uint32_t mip_levels,
+    SampleCount sample_count,
+    RenderTextureUsageFlags texture_usage,
+    RenderTextureTilingMode tiling_mode
+)
+{
+    // Set image usage flags
+    VkImageUsageFlags usage_flags = 0;
+    if (texture_usage & RenderTextureUsageTransferSrc)
+        usage_flags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    if (texture_usage & RenderTextureUsageTransferDst)
+        usage_flags |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (texture_usage & RenderTextureUsageSampled)
+        usage_flags |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    if (texture_usage & RenderTextureUsageStorage)
+        usage_flags |= VK_IMAGE_USAGE_STORAGE_BIT;
+    if (texture_usage & RenderTextureUsageRenderTarget)
+        usage_flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    if (texture_usage & RenderTextureUsageDepthStencilTarget)
+        usage_flags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+
+    // Set flags, depth, and array layers based on image type
+    VkImageCreateFlags image_flags = 0;
+    uint32_t depth = 1;
+    uint32_t array_layers = depth_or_layers;
+    if (texture_type == RenderTextureType3D)
+    {
+        depth = depth_or_layers;
+        array_layers = 1;
+    }
+    else if (texture_type == RenderTextureType2D && array_layers == 6)
+    {
+        image_flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+    }
+
+    VkImageCreateInfo image_create_info{};
+    image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_create_info.pNext = nullptr;
+    image_create_info.flags = image_flags;
+    image_create_info.imageType = get_vulkan_image_type(texture_type);
+    image_create_info.format = get_vulkan_format(format);
+    image_create_info.extent = VkExtent3D{ width, height, depth };
+    image_create_info.mipLevels = mip_levels;
+    image_create_info.arrayLayers = array_layers;
+    image_create_info.samples = static_cast<VkSampleCountFlagBits>(sample_count);
+    image_create_info.tiling = get_vulkan_image_tiling(tiling_mode);
+    image_create_info.usage = usage_flags;
+    image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image_create_info.queueFamilyIndexCount = 0;
+    image_create_info.pQueueFamilyIndices = nullptr;
+    image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    return image_create_info;
+}
+
+RenderTexture* VulkanRenderBackend::create_texture_object(
+    VkImage image,
+    VmaAllocation allocation,
+    VkImageCreateInfo const& image_create_info,
+    RenderTextureType texture_type,
+    RenderFormat format
+)
+{
+    uint32_t const mip_levels = image_create_info.mipLevels;
+    uint32_t const array_layers = image_create_info.arrayLayers;
+
+    // Set image view type based  on input params
+    VkImageViewType view_type = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
+    if (texture_type == RenderTextureType1D && array_layers == 1)
+        view_type = VK_IMAGE_VIEW_TYPE_1D;
+    else if (texture_type == RenderTextureType1D && array_layers > 1)
+        view_type = VK_IMAGE_VIEW_TYPE_1D_ARRAY;
+    else if (texture_type == RenderTextureType2D && array_layers == 1)
+        view_type = VK_IMAGE_VIEW_TYPE_2D;
+    else if (texture_type == RenderTextureType2D && array_layers == 6) // Specific case for cubemaps
+        view_type = VK_IMAGE_VIEW_TYPE_CUBE;
+    else if (texture_type == RenderTextureType2D && array_layers > 1)
+        view_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+    else if (texture_type == RenderTextureType3D)
+        view_type = VK_IMAGE_VIEW_TYPE_3D;
+
+    VkImageAspectFlags image_aspect = get_vulkan_aspect_flags(format);
+    VkImageViewCreateInfo view_create_info{};
+    view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_create_info.pNext = nullptr;
+    view_create_info.flags = 0;
+    view_create_info.image = image;
+    view_create_info.viewType = view_type;
+    view_create_info.format = image_create_info.format;
+    view_create_info.components = VkComponentMapping{
+        VK_COMPONENT_SWIZZLE_IDENTITY,
+        VK_COMPONENT_SWIZZLE_IDENTITY,
+        VK_COMPONENT_SWIZZLE_IDENTITY,
+        VK_COMPONENT_SWIZZLE_IDENTITY,
+    };
+    view_create_info.subresourceRange = VkImageSubresourceRange{
+        image_aspect,
+        0, mip_levels,
+        0, array_layers,
+    };
+
+    // Allocations are optional, aliased images only destroy the image handle
+    VkImageView image_view = VK_NULL_HANDLE;
+    if (VK_FAILED(vkCreateImageView(m_device, &view_create_info, nullptr, &image_view)))
+    {
+        vmaDestroyImage(m_allocator, image, allocation);
+        return nullptr;
+    }
+
+    // Mipmapped textures get a view per mip level, these are used as render targets & storage image bindings
+    std::vector<VkImageView> mip_views{};
+    if (mip_levels > 1)
+    {
+        VkImageViewCreateInfo mip_view_create_info = view_create_info;
+        if (view_type == VK_IMAGE_VIEW_TYPE_CUBE)
+        {
+            mip_view_create_info.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY; // Cube views can't be bound as storage images
+        }
+
+        mip_views.reserve(mip_levels);
+        for (uint32_t mip = 0; mip < mip_levels; mip++)
+        {
+            mip_view_create_info.subresourceRange.baseMipLevel = mip;
+            mip_view_create_info.subresourceRange.levelCount = 1;
+
+            VkImageView mip_view = VK_NULL_HANDLE;
+            if (VK_FAILED(vkCreateImageView(m_device, &mip_view_create_info, nullptr, &mip_view)))
+            {
+                for (auto const& view : mip_views)
+                {
+                    vkDestroyImageView(m_device, view, nullptr);
+                }
+                vkDestroyImageView(m_device, image_view, nullptr);
+                vmaDestroyImage(m_allocator, image, allocation);
+                return nullptr;
+            }
+            mip_views.push_back(mip_view);
+        }
+    }
+
+    VulkanTextureDesc texture_desc{};
+    texture_desc.format = format;
+    texture_desc.extent = { image_create_info.extent.width, image_create_info.extent.height, image_create_info.extent.depth };
+    texture_desc.mip_levels = mip_levels;
+    texture_desc.array_layers = array_layers;
+    texture_desc.vk_aspect_flags = image_aspect;
+    texture_desc.vk_sample_count = image_create_info.samples;
+
+    return new VulkanTexture(m_device, m_allocator, image, image_view, mip_views, allocation, texture_desc);
+}
+
 bool VulkanRenderBackend::has_device_extensions(
     VkPhysicalDevice device,
     std::vector<char const*> const& extension_names
@@ -1139,6 +1481,7 @@ VkPhysicalDevice VulkanRenderBackend::find_physical_device(
 
         vkGetPhysicalDeviceFeatures2(device, &enabled_device_features.features2);
         if (enabled_device_features.features2.features.samplerAnisotropy != VK_TRUE
+            || enabled_device_features.vulkan11_features.multiview != VK_TRUE
             || enabled_device_features.vulkan12_features.descriptorIndexing != VK_TRUE
             || enabled_device_features.vulkan12_features.descriptorBindingPartiallyBound != VK_TRUE
             || enabled_device_features.vulkan12_features.descriptorBindingSampledImageUpdateAfterBind != VK_TRUE
@@ -1147,12 +1490,15 @@ VkPhysicalDevice VulkanRenderBackend::find_physical_device(
             || enabled_device_features.vulkan12_features.descriptorBindingStorageBufferUpdateAfterBind != VK_TRUE
             || enabled_device_features.vulkan12_features.descriptorBindingVariableDescriptorCount != VK_TRUE
             || enabled_device_features.vulkan12_features.bufferDeviceAddress != VK_TRUE
+            || enabled_device_features.vulkan12_features.hostQueryReset != VK_TRUE
             || enabled_device_features.vulkan13_features.dynamicRendering != VK_TRUE
             || enabled_device_features.vulkan13_features.synchronization2 != VK_TRUE)
         {
             continue;
         }
 
+        // Optional features such as multiViewport, pipelineStatisticsQuery & inheritedQueries stay enabled when supported
+
         if (!has_device_extensions(device, enabled_device_extensions))
         {
             continue;
@@ -1371,7 +1717,10 @@ bool VulkanRenderBackend::configure_swapchain(
         VulkanTextureDesc texture_desc{};
         texture_desc.format = swap_capabilities.render_format;
         texture_desc.extent = { image_extent.width, image_extent.height, 1 };
+        texture_desc.mip_levels = 1;
+        texture_desc.array_layers = 1;
         texture_desc.vk_aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT; // This is always a color format
+        texture_desc.vk_sample_count = VK_SAMPLE_COUNT_1_BIT;
 
         swapchain_config.swap_render_textures[i] = new VulkanTexture(
             swapchain_config.swap_images[i],
@@ -1383,39 +1732,70 @@ bool VulkanRenderBackend::configure_swapchain(
     return true;
 }
 
-bool VulkanRenderBackend::compile_shader_source(ShaderSource const& source, LPCWSTR target_profile, IDxcBlob** compiled_shader) const
+ShaderCompileRequest VulkanRenderBackend::get_compile_request(ShaderSource const& source, LPCWSTR target_profile)
 {
+    ShaderCompileRequest request{};
+    request.name = source.entrypoint; // Use the entrypoint as shader name
+    request.entrypoint = source.entrypoint;
+    request.target_profile = target_profile;
+    request.base_include_dir = nullptr;
+    request.file_path = nullptr;
+    request.compile_into_spirv = true;
+    request.defines = source.defines;
+    request.define_count = source.define_count;
     if (source.source_kind == ShaderSourceKindInline)
     {
-        DxcBuffer shader_source{};
-        shader_source.Ptr = source.shader_source;
-        shader_source.Size = std::strlen(source.shader_source);
-        shader_source.Encoding = 0; // unknown encoding, just guess...
-
-        char const* entrypoint = source.entrypoint;
-        if (m_shader_compiler.compile_source(
-            entrypoint /* use the entrypoint as shader name */,
-            entrypoint, target_profile,
-            shader_source, nullptr,
-            true, compiled_shader))
-        {
-            return true;
-        }
+        request.source.Ptr = source.shader_source;
+        request.source.Size = std::strlen(source.shader_source);
+        request.source.Encoding = 0; // unknown encoding, just guess...
     }
     else if (source.source_kind == ShaderSourceKindFile)
     {
-        char const* shader_file = source.shader_source;
-        char const* entrypoint = source.entrypoint;
-        if (m_shader_compiler.compile_file(
-            shader_file,
-            entrypoint, target_profile,
-            true, compiled_shader))
+        request.file_path = source.shader_source;
+    }
+
+    return request;
+}
+
+bool VulkanRenderBackend::compile_shader_source(ShaderSource const& source, LPCWSTR target_profile, ShaderCompileResult& result)
+{
+    ShaderCompileRequest const request = get_compile_request(source, target_profile);
+    return m_shader_variant_cache.compile_many(m_shader_compiler_pool, &request, 1, &result) == 1;
+}
+
+bool VulkanRenderBackend::get_specialization_data(
+    SPIRVReflector const& reflector,
+    VkShaderStageFlagBits stage,
+    SpecializationConstant const* constants,
+    uint32_t constant_count,
+    std::vector<bool>& constants_applied,
+    VulkanSpecializationData& specialization_data
+)
+{
+    specialization_data.map_entries.clear();
+    specialization_data.data.clear();
+    for (uint32_t i = 0; i < constant_count; i++)
+    {
+        uint32_t constant_id = 0;
+        if (!reflector.find_specialization_constant(stage, constants[i].name, constant_id))
         {
-            return true;
+            continue;
         }
+
+        VkSpecializationMapEntry map_entry{};
+        map_entry.constantID = constant_id;
+        map_entry.offset = static_cast<uint32_t>(specialization_data.data.size() * sizeof(uint32_t));
+        map_entry.size = sizeof(uint32_t);
+        specialization_data.map_entries.push_back(map_entry);
+        specialization_data.data.push_back(constants[i].value);
+        constants_applied[i] = true;
     }
 
-    return false;
+    specialization_data.info.mapEntryCount = static_cast<uint32_t>(specialization_data.map_entries.size());
+    specialization_data.info.pMapEntries = specialization_data.map_entries.data();
+    specialization_data.info.dataSize = specialization_data.data.size() * sizeof(uint32_t);
+    specialization_data.info.pData = specialization_data.data.data();
+    return !specialization_data.map_entries.empty();
 }
 
 VkPipelineLayout VulkanRenderBackend::generate_pipeline_layout(SPIRVReflector const& reflector, std::vector<VkDescriptorSetLayout>& descriptor_set_layouts)
@@ -1440,36 +1820,21 @@ VkPipelineLayout VulkanRenderBackend::generate_pipeline_layout(SPIRVReflector co
     descriptor_set_layouts.reserve(descriptor_set_layout_bindings.size());
     for (auto const& layout_bindings : descriptor_set_layout_bindings)
     {
-        VkDescriptorSetLayoutCreateInfo descriptor_set_layout_create_info{};
-        descriptor_set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        descriptor_set_layout_create_info.pNext = nullptr;
-        descriptor_set_layout_create_info.flags = 0;
-        descriptor_set_layout_create_info.bindingCount = layout_bindings.size();
-        descriptor_set_layout_create_info.pBindings = layout_bindings.data();
-
-        VkDescriptorSetLayout descriptor_set_layout = VK_NULL_HANDLE;
-        if (VK_FAILED(vkCreateDescriptorSetLayout(m_device, &descriptor_set_layout_create_info, nullptr, &descriptor_set_layout)))
+        VkDescriptorSetLayout descriptor_set_layout = m_layout_cache->get_descriptor_set_layout(layout_bindings.data(), static_cast<uint32_t>(layout_bindings.size()));
+        if (descriptor_set_layout == VK_NULL_HANDLE)
         {
             return VK_NULL_HANDLE;
         }
         descriptor_set_layouts.push_back(descriptor_set_layout);
     }
 
-    // Create generated pipeline layout for shader
-    VkPipelineLayoutCreateInfo pipeline_layout_create_info{};
-    pipeline_layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipeline_layout_create_info.pNext = nullptr;
-    pipeline_layout_create_info.flags = 0;
-    pipeline_layout_create_info.setLayoutCount = static_cast<uint32_t>(descriptor_set_layouts.size());
-    pipeline_layout_create_info.pSetLayouts = descriptor_set_layouts.data();
-    pipeline_layout_create_info.pushConstantRangeCount = reflector.get_push_constant_range_count();
-    pipeline_layout_create_info.pPushConstantRanges = reflector.get_push_constant_ranges();
-
-    VkPipelineLayout pipeline_layout = VK_NULL_HANDLE;
-    if (VK_FAILED(vkCreatePipelineLayout(m_device, &pipeline_layout_create_info, nullptr, &pipeline_layout)))
-    {
-        return VK_NULL_HANDLE;
-    }
+    // Pipelines with equal set layouts & push constant ranges share a pipeline layout
+    VkPipelineLayout pipeline_layout = m_layout_cache->get_pipeline_layout(
+        descriptor_set_layouts.data(),
+        static_cast<uint32_t>(descriptor_set_layouts.size()),
+        reflector.get_push_constant_ranges(),
+        reflector.get_push_constant_range_count()
+    );
 
     return pipeline_layout;
 }
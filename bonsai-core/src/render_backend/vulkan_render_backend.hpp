@@ -7,8 +7,13 @@
 #include <vk_mem_alloc.h>
 #include "bonsai/render_backend/render_backend.hpp"
 #include "render_backend/vulkan/spirv_reflector.hpp"
+#include "render_backend/vulkan/vulkan_depth_pyramid_pass.hpp"
+#include "render_backend/vulkan/vulkan_gpu_profiler.hpp"
+#include "render_backend/vulkan/vulkan_layout_cache.hpp"
+#include "render_backend/vulkan/vulkan_parallel_recorder_pool.hpp"
 #include "render_backend/vulkan/vulkan_render_commands.hpp"
-#include "render_backend/shader_compiler.hpp"
+#include "render_backend/shader_compiler_pool.hpp"
+#include "render_backend/shader_variant_cache.hpp"
 
 static constexpr uint32_t BONSAI_VULKAN_VERSION = VK_API_VERSION_1_3;
 
@@ -60,6 +65,14 @@ struct VulkanSwapchainConfiguration
     std::vector<RenderTexture*> swap_render_textures = {};
 };
 
+/// @brief Specialization info for a single shader stage, owns the map entries & constant data the info points to.
+struct VulkanSpecializationData
+{
+    std::vector<VkSpecializationMapEntry> map_entries = {};
+    std::vector<uint32_t> data = {};
+    VkSpecializationInfo info = {};
+};
+
 /// @brief Vulkan implementation for the render backend.
 class VulkanRenderBackend : public RenderBackend
 {
@@ -67,7 +80,7 @@ public:
     /// @brief Create a new Vulkan render backend.
     /// @param platform_surface Main application surface, used for setting up initial state for device selection, swap chain, etc.
     /// @param imgui_context ImGui context created by engine.
-    VulkanRenderBackend(PlatformSurface* platform_surface, ImGuiContext* imgui_context);
+    VulkanRenderBackend(PlatformSurface* platform_surface, ImGuiContext* imgui_context, JobSystem* job_system);
     ~VulkanRenderBackend() override;
 
     VulkanRenderBackend(VulkanRenderBackend const&) = delete;
@@ -83,6 +96,8 @@ public:
 
     bool is_swap_srgb() const override;
 
+    void imgui_new_frame() override;
+
     RenderBackendFrameResult new_frame() override;
 
     RenderBackendFrameResult end_frame() override;
@@ -109,13 +124,88 @@ public:
         RenderTextureTilingMode tiling_mode
     ) override;
 
+    RenderMemoryRequirements get_buffer_memory_requirements(size_t size, RenderBufferUsageFlags buffer_usage) const override;
+
+    RenderMemoryRequirements get_texture_memory_requirements(
+        RenderTextureType texture_type,
+        RenderFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t depth_or_layers,
+        uint32_t mip_levels,
+        SampleCount sample_count,
+        RenderTextureUsageFlags texture_usage,
+        RenderTextureTilingMode tiling_mode
+    ) const override;
+
+    RenderMemoryHeap* create_memory_heap(RenderMemoryRequirements const& requirements) override;
+
+    RenderBuffer* create_aliased_buffer(
+        RenderMemoryHeap* heap,
+        size_t offset,
+        size_t size,
+        RenderBufferUsageFlags buffer_usage
+    ) override;
+
+    RenderTexture* create_aliased_texture(
+        RenderMemoryHeap* heap,
+        size_t offset,
+        RenderTextureType texture_type,
+        RenderFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t depth_or_layers,
+        uint32_t mip_levels,
+        SampleCount sample_count,
+        RenderTextureUsageFlags texture_usage,
+        RenderTextureTilingMode tiling_mode
+    ) override;
+
     ShaderPipeline* create_graphics_pipeline(GraphicsPipelineDescriptor pipeline_descriptor) override;
 
     ShaderPipeline* create_compute_pipeline(ComputePipelineDescriptor pipeline_descriptor) override;
 
     uint64_t get_current_frame_index() const override { return m_frame_idx; }
 
+    RenderGpuProfile const& get_gpu_profile() const override;
+
 private:
+    /// @brief Get the buffer create info for a render buffer.
+    /// @param size Buffer size in bytes.
+    /// @param buffer_usage Buffer usage flags.
+    /// @return The Vulkan buffer create info.
+    static VkBufferCreateInfo get_buffer_create_info(size_t size, RenderBufferUsageFlags buffer_usage);
+
+    /// @brief Get the image create info for a render texture.
+    /// See @ref RenderBackend::create_texture for parameter descriptions.
+    /// @return The Vulkan image create info.
+    static VkImageCreateInfo get_image_create_info(
+        RenderTextureType texture_type,
+        RenderFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t depth_or_layers,
+        uint32_t mip_levels,
+        SampleCount sample_count,
+        RenderTextureUsageFlags texture_usage,
+        RenderTextureTilingMode tiling_mode
+    );
+
+    /// @brief Create the image views & texture object for a created image, the image is destroyed on failure.
+    /// @param image Image to create a texture for.
+    /// @param allocation Image allocation, VK_NULL_HANDLE for images placed in a memory heap.
+    /// @param image_create_info Create info used to create the image.
+    /// @param texture_type Texture type used for the image.
+    /// @param format Texture format used for the image.
+    /// @return A new render texture object, or nullptr on failure.
+    RenderTexture* create_texture_object(
+        VkImage image,
+        VmaAllocation allocation,
+        VkImageCreateInfo const& image_create_info,
+        RenderTextureType texture_type,
+        RenderFormat format
+    );
+
     /// @brief Check if device extensions are available on a physical device.
     /// @param device Device to check support for.
     /// @param extension_names Required extension names.
@@ -180,17 +270,40 @@ private:
         VulkanSwapchainConfiguration& swapchain_config
     );
 
-    /// @brief Compile shader source code using the shader compiler.
+    /// @brief Get the shader compiler request for a shader source, compiling into SPIR-V.
+    /// @param source Shader source structure, must outlive the request.
+    /// @param target_profile Shader target profile.
+    /// @return A shader compile request.
+    static ShaderCompileRequest get_compile_request(ShaderSource const& source, LPCWSTR target_profile);
+
+    /// @brief Compile shader source code using the shader compiler pool, cached permutations are reused.
     /// @param source Shader source structure.
     /// @param target_profile Shader target profile.
-    /// @param compiled_shader Output compiled shader blob.
+    /// @param result Output compiled shader blob & reflection data.
     /// @return A boolean indicating successful compilation.
-    bool compile_shader_source(ShaderSource const& source, LPCWSTR target_profile, IDxcBlob** compiled_shader) const;
+    bool compile_shader_source(ShaderSource const& source, LPCWSTR target_profile, ShaderCompileResult& result);
+
+    /// @brief Map specialization constants onto a shader stage, constants not declared by the stage are skipped.
+    /// @param reflector Reflection data for the pipeline shaders.
+    /// @param stage Shader stage to map constants for.
+    /// @param constants Specialization constant values.
+    /// @param constant_count Number of specialization constants.
+    /// @param constants_applied Per constant flags, set for each constant that is declared by the stage.
+    /// @param specialization_data Output specialization data for the stage.
+    /// @return A boolean indicating if any constants apply to the stage, the specialization info is unused if not.
+    static bool get_specialization_data(
+        SPIRVReflector const& reflector,
+        VkShaderStageFlagBits stage,
+        SpecializationConstant const* constants,
+        uint32_t constant_count,
+        std::vector<bool>& constants_applied,
+        VulkanSpecializationData& specialization_data
+    );
 
-    /// @brief Generate a pipeline layout based on reflection data for shaders.
+    /// @brief Get a pipeline layout based on reflection data for shaders, layouts are shared through the layout cache.
     /// @param reflector Reflection data for one or more shaders.
     /// @param descriptor_set_layouts Output descriptor set layouts associated with the pipeline layout.
-    /// @return A generated pipeline layout.
+    /// @return A pipeline layout owned by the layout cache, or VK_NULL_HANDLE on failure.
     VkPipelineLayout generate_pipeline_layout(SPIRVReflector const& reflector, std::vector<VkDescriptorSetLayout>& descriptor_set_layouts);
 
 private:
@@ -219,8 +332,14 @@ private:
     VkCommandPool m_graphics_cmd_pool = VK_NULL_HANDLE;
     VkCommandBuffer m_frame_cmd_buffer = VK_NULL_HANDLE;
     VulkanRenderCommands m_frame_commands = {};
-
-    ShaderCompiler m_shader_compiler = {};
+    VulkanDepthPyramidPass* m_depth_pyramid_pass = nullptr;
+    VulkanParallelRecorderPool* m_parallel_recorder_pool = nullptr;
+    VulkanGpuProfiler* m_gpu_profiler = nullptr;
+    VulkanLayoutCache* m_layout_cache = nullptr;
+
+    ShaderCompilerPool m_shader_compiler_pool;
+    ShaderBundle m_shader_bundle;   // Declared before the variant cache, cached blobs may point into the mapped bundle
+    ShaderVariantCache m_shader_variant_cache;
     uint64_t m_frame_idx = 0;
 };
 
@@ -0,0 +1,190 @@
+#include "bonsai/systems/draw_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include "bonsai/core/assert.hpp"
+#include "bonsai/core/job_system.hpp"
+
+/// @brief Radix sort digit size, keys are sorted in 8 passes of 8 bits.
+static constexpr uint32_t RADIX_BITS = 8;
+static constexpr uint32_t RADIX_BUCKET_COUNT = 1U << RADIX_BITS;
+static constexpr uint32_t RADIX_PASS_COUNT = 64 / RADIX_BITS;
+
+/// @brief Minimum number of keys per sort job, smaller queues are sorted on the calling thread.
+static constexpr size_t PARALLEL_SORT_MIN_CHUNK_SIZE = 16384;
+
+/// @brief Maximum number of sort jobs per radix pass step.
+static constexpr size_t PARALLEL_SORT_MAX_CHUNK_COUNT = 16;
+
+typedef std::array<size_t, RADIX_BUCKET_COUNT> RadixHistogram;
+
+/// @brief Run a function for each chunk, a single chunk runs on the calling thread & multiple chunks run as jobs.
+template<typename Func>
+static void for_each_chunk(JobSystem* job_system, size_t chunk_count, Func const& func)
+{
+    if (chunk_count == 1)
+    {
+        func(0);
+        return;
+    }
+
+    job_system->parallel_for(chunk_count, 1, [&func](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; chunk++)
+        {
+            func(chunk);
+        }
+    });
+}
+
+void DrawQueue::push(uint64_t key, DrawPacket const& packet)
+{
+    BONSAI_ASSERT(m_packets.size() < UINT32_MAX && "Draw queue packet count exceeds the maximum packet count!");
+    m_sorted_keys.push_back(SortKey{ key, static_cast<uint32_t>(m_packets.size()) });
+    m_packets.push_back(packet);
+    m_sorted = false;
+}
+
+void DrawQueue::sort(JobSystem* job_system)
+{
+    if (m_sorted)
+    {
+        return;
+    }
+
+    // The calling thread helps while waiting on sort jobs, so it counts towards the available threads
+    size_t const key_count = m_sorted_keys.size();
+    size_t const thread_count = job_system != nullptr ? job_system->worker_count() + 1 : 1;
+    size_t const chunk_count = std::clamp<size_t>(key_count / PARALLEL_SORT_MIN_CHUNK_SIZE, 1, std::min(thread_count, PARALLEL_SORT_MAX_CHUNK_COUNT));
+    size_t const chunk_size = (key_count + chunk_count - 1) / chunk_count;
+    m_scratch_keys.resize(key_count);
+
+    // LSD radix sort, stable per pass so equal keys keep their submission order.
+    // Each chunk builds a digit histogram, chunk offsets are ordered bucket major so the scatter stays stable across chunks.
+    RadixHistogram histograms[PARALLEL_SORT_MAX_CHUNK_COUNT]{};
+    for (uint32_t pass = 0; pass < RADIX_PASS_COUNT; pass++)
+    {
+        uint32_t const shift = pass * RADIX_BITS;
+        std::vector<SortKey> const& source = m_sorted_keys;
+        std::vector<SortKey>& destination = m_scratch_keys;
+
+        for_each_chunk(job_system, chunk_count, [&](size_t chunk) {
+            size_t const begin = std::min(chunk * chunk_size, key_count);
+            size_t const end = std::min(begin + chunk_size, key_count);
+            RadixHistogram& histogram = histograms[chunk];
+            histogram.fill(0);
+            for (size_t i = begin; i < end; i++)
+            {
+                histogram[(source[i].key >> shift) & (RADIX_BUCKET_COUNT - 1)]++;
+            }
+        });
+
+        // Skip passes where all keys share the same digit, e.g. unused pass bits
+        bool is_uniform = false;
+        size_t offset = 0;
+        for (uint32_t bucket = 0; bucket < RADIX_BUCKET_COUNT; bucket++)
+        {
+            size_t bucket_count = 0;
+            for (size_t chunk = 0; chunk < chunk_count; chunk++)
+            {
+                size_t const count = histograms[chunk][bucket];
+                histograms[chunk][bucket] = offset;
+                offset += count;
+                bucket_count += count;
+            }
+
+            is_uniform = is_uniform || bucket_count == key_count;
+        }
+
+        if (is_uniform)
+        {
+            continue;
+        }
+
+        for_each_chunk(job_system, chunk_count, [&](size_t chunk) {
+            size_t const begin = std::min(chunk * chunk_size, key_count);
+            size_t const end = std::min(begin + chunk_size, key_count);
+            RadixHistogram& offsets = histograms[chunk];
+            for (size_t i = begin; i < end; i++)
+            {
+                destination[offsets[(source[i].key >> shift) & (RADIX_BUCKET_COUNT - 1)]++] = source[i];
+            }
+        });
+
+        m_sorted_keys.swap(m_scratch_keys);
+    }
+
+    m_sorted = true;
+}
+
+size_t DrawQueue::submit(RenderCommands* commands, uint32_t pass) const
+{
+    BONSAI_ASSERT(commands != nullptr && "Render commands were NULL!");
+    BONSAI_ASSERT(m_sorted && "Draw queue must be sorted before submission!");
+
+    ShaderPipeline* bound_pipeline = nullptr;
+    RenderBuffer* bound_vertex_buffer = nullptr;
+    size_t bound_vertex_buffer_offset = 0;
+    RenderBuffer* bound_index_buffer = nullptr;
+    size_t bound_index_buffer_offset = 0;
+    IndexType bound_index_type = IndexTypeUint16;
+
+    size_t packet_count = 0;
+    for (size_t i = find_pass_begin(pass); i < m_sorted_keys.size() && get_draw_key_pass(m_sorted_keys[i].key) == pass; i++)
+    {
+        DrawPacket const& packet = m_packets[m_sorted_keys[i].packet_index];
+        if (packet.pipeline != bound_pipeline)
+        {
+            commands->set_pipeline(packet.pipeline);
+            bound_pipeline = packet.pipeline;
+        }
+
+        if (packet.vertex_buffer != nullptr
+            && (packet.vertex_buffer != bound_vertex_buffer || packet.vertex_buffer_offset != bound_vertex_buffer_offset))
+        {
+            RenderBuffer* vertex_buffers[] = { packet.vertex_buffer };
+            size_t offsets[] = { packet.vertex_buffer_offset };
+            commands->bind_vertex_buffers(0, 1, vertex_buffers, offsets);
+            bound_vertex_buffer = packet.vertex_buffer;
+            bound_vertex_buffer_offset = packet.vertex_buffer_offset;
+        }
+
+        if (packet.index_buffer == nullptr)
+        {
+            commands->draw_instanced(packet.index_count, packet.instance_count, packet.first_index, packet.first_instance);
+        }
+        else
+        {
+            if (packet.index_buffer != bound_index_buffer
+                || packet.index_buffer_offset != bound_index_buffer_offset
+                || packet.index_type != bound_index_type)
+            {
+                commands->bind_index_buffer(packet.index_buffer, packet.index_buffer_offset, packet.index_type);
+                bound_index_buffer = packet.index_buffer;
+                bound_index_buffer_offset = packet.index_buffer_offset;
+                bound_index_type = packet.index_type;
+            }
+
+            commands->draw_indexed_instanced(packet.index_count, packet.instance_count, packet.first_index, packet.vertex_offset, packet.first_instance);
+        }
+
+        packet_count++;
+    }
+
+    return packet_count;
+}
+
+void DrawQueue::clear()
+{
+    m_packets.clear();
+    m_sorted_keys.clear();
+    m_sorted = true;
+}
+
+size_t DrawQueue::find_pass_begin(uint32_t pass) const
+{
+    auto const it = std::lower_bound(m_sorted_keys.begin(), m_sorted_keys.end(), pass, [](SortKey const& sort_key, uint32_t value) {
+        return get_draw_key_pass(sort_key.key) < value;
+    });
+
+    return static_cast<size_t>(it - m_sorted_keys.begin());
+}
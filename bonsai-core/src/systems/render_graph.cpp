@@ -0,0 +1,499 @@
+#include "bonsai/systems/render_graph.hpp"
+
+#include <algorithm>
+#include "bonsai/core/assert.hpp"
+#include "bonsai/core/logger.hpp"
+
+/// @brief Transient resource placement in a memory heap.
+struct RenderGraphPlacement
+{
+    RenderGraphResource resource;
+    RenderMemoryRequirements requirements;
+    size_t offset;
+};
+
+/// @brief Memory heap group, resources in a group share memory types & are placed in the same heap.
+struct RenderGraphHeapGroup
+{
+    bool is_texture;
+    uint32_t memory_type_bits;
+    size_t size;
+    size_t alignment;
+    std::vector<RenderGraphPlacement> placements;
+};
+
+static size_t align_up(size_t value, size_t alignment)
+{
+    return alignment == 0 ? value : ((value + alignment - 1) / alignment) * alignment;
+}
+
+RenderGraph::PassBuilder::PassBuilder(RenderGraph* graph, uint32_t pass_index)
+    :
+    m_graph(graph),
+    m_pass_index(pass_index)
+{
+    //
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::read(RenderGraphResource resource, RenderResourceState state)
+{
+    m_graph->add_access(m_pass_index, resource, state, false);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::write(RenderGraphResource resource, RenderResourceState state)
+{
+    m_graph->add_access(m_pass_index, resource, state, true);
+    return *this;
+}
+
+RenderGraph::RenderGraph(RenderBackend* render_backend)
+    :
+    m_render_backend(render_backend)
+{
+    //
+}
+
+RenderGraph::~RenderGraph()
+{
+    free_transient_resources();
+}
+
+RenderGraphResource RenderGraph::create_texture(char const* name, RenderGraphTextureDesc const& desc)
+{
+    BONSAI_ASSERT(!m_compiled && "Cannot add resources to a compiled render graph!");
+    Resource resource{};
+    resource.name = name;
+    resource.is_texture = true;
+    resource.texture_desc = desc;
+    resource.final_state = RenderResourceStateUndefined;
+    m_resources.push_back(resource);
+    return static_cast<RenderGraphResource>(m_resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::create_buffer(char const* name, RenderGraphBufferDesc const& desc)
+{
+    BONSAI_ASSERT(!m_compiled && "Cannot add resources to a compiled render graph!");
+    Resource resource{};
+    resource.name = name;
+    resource.is_texture = false;
+    resource.buffer_desc = desc;
+    resource.final_state = RenderResourceStateUndefined;
+    m_resources.push_back(resource);
+    return static_cast<RenderGraphResource>(m_resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::import_texture(char const* name, RenderTexture* texture, RenderResourceState final_state)
+{
+    BONSAI_ASSERT(!m_compiled && "Cannot add resources to a compiled render graph!");
+    Resource resource{};
+    resource.name = name;
+    resource.is_texture = true;
+    resource.imported = true;
+    resource.output = true;
+    resource.texture = texture;
+    resource.final_state = final_state;
+    m_resources.push_back(resource);
+    return static_cast<RenderGraphResource>(m_resources.size() - 1);
+}
+
+RenderGraphResource RenderGraph::import_buffer(char const* name, RenderBuffer* buffer, RenderResourceState final_state)
+{
+    BONSAI_ASSERT(!m_compiled && "Cannot add resources to a compiled render graph!");
+    Resource resource{};
+    resource.name = name;
+    resource.is_texture = false;
+    resource.imported = true;
+    resource.output = true;
+    resource.buffer = buffer;
+    resource.final_state = final_state;
+    m_resources.push_back(resource);
+    return static_cast<RenderGraphResource>(m_resources.size() - 1);
+}
+
+void RenderGraph::set_imported_texture(RenderGraphResource resource, RenderTexture* texture)
+{
+    BONSAI_ASSERT(resource < m_resources.size() && m_resources[resource].imported && m_resources[resource].is_texture && "Resource is not an imported texture!");
+    m_resources[resource].texture = texture;
+}
+
+void RenderGraph::set_imported_buffer(RenderGraphResource resource, RenderBuffer* buffer)
+{
+    BONSAI_ASSERT(resource < m_resources.size() && m_resources[resource].imported && !m_resources[resource].is_texture && "Resource is not an imported buffer!");
+    m_resources[resource].buffer = buffer;
+}
+
+void RenderGraph::set_output(RenderGraphResource resource)
+{
+    BONSAI_ASSERT(resource < m_resources.size() && "Render graph resource out of range!");
+    m_resources[resource].output = true;
+}
+
+RenderGraph::PassBuilder RenderGraph::add_pass(char const* name, RenderGraphPassCallback callback)
+{
+    BONSAI_ASSERT(!m_compiled && "Cannot add passes to a compiled render graph!");
+    Pass pass{};
+    pass.name = name;
+    pass.callback = std::move(callback);
+    pass.live = false;
+    m_passes.push_back(pass);
+    return PassBuilder(this, static_cast<uint32_t>(m_passes.size() - 1));
+}
+
+bool RenderGraph::compile()
+{
+    BONSAI_ASSERT(!m_compiled && "Render graph was already compiled!");
+    m_statistics = {};
+    m_statistics.pass_count = static_cast<uint32_t>(m_passes.size());
+
+    cull_passes();
+    compute_lifetimes();
+    if (!allocate_transient_resources())
+    {
+        BONSAI_ENGINE_LOG_ERROR("Failed to allocate render graph transient resources");
+        free_transient_resources();
+        return false;
+    }
+
+    m_compiled = true;
+    return true;
+}
+
+void RenderGraph::execute(RenderCommands* commands)
+{
+    BONSAI_ASSERT(m_compiled && "Render graph must be compiled before execution!");
+    for (uint32_t pass_idx = 0; pass_idx < m_passes.size(); pass_idx++)
+    {
+        Pass const& pass = m_passes[pass_idx];
+        if (!pass.live)
+        {
+            continue;
+        }
+
+        commands->begin_profile_scope(pass.name.c_str(), m_pipeline_statistics_enabled);
+        for (auto const& access : pass.accesses)
+        {
+            Resource const& resource = m_resources[access.resource];
+
+            // Transient resources take over their memory on first use, their previous contents are undefined
+            bool const first_use = !resource.imported && resource.first_pass == pass_idx;
+            if (first_use)
+            {
+                m_alias_states.clear();
+                for (auto const& predecessor : resource.alias_predecessors)
+                {
+                    m_alias_states.push_back(m_resources[predecessor].last_state);
+                }
+
+                if (resource.is_texture)
+                {
+                    commands->alias_texture(resource.texture, m_alias_states.data(), m_alias_states.size());
+                }
+                else
+                {
+                    commands->alias_buffer(resource.buffer, m_alias_states.data(), m_alias_states.size());
+                }
+            }
+
+            if (resource.is_texture)
+            {
+                commands->transition_texture(resource.texture, access.state, first_use);
+            }
+            else
+            {
+                commands->transition_buffer(resource.buffer, access.state);
+            }
+        }
+
+        pass.callback(*this, commands);
+        commands->end_profile_scope();
+    }
+
+    for (auto const& resource : m_resources)
+    {
+        if (!resource.imported || resource.final_state == RenderResourceStateUndefined)
+        {
+            continue;
+        }
+
+        if (resource.is_texture && resource.texture != nullptr)
+        {
+            commands->transition_texture(resource.texture, resource.final_state, false);
+        }
+        else if (!resource.is_texture && resource.buffer != nullptr)
+        {
+            commands->transition_buffer(resource.buffer, resource.final_state);
+        }
+    }
+}
+
+void RenderGraph::reset()
+{
+    free_transient_resources();
+    m_passes.clear();
+    m_resources.clear();
+    m_statistics = {};
+    m_compiled = false;
+}
+
+RenderTexture* RenderGraph::get_texture(RenderGraphResource resource) const
+{
+    BONSAI_ASSERT(resource < m_resources.size() && m_resources[resource].is_texture && "Resource is not a texture!");
+    return m_resources[resource].texture;
+}
+
+RenderBuffer* RenderGraph::get_buffer(RenderGraphResource resource) const
+{
+    BONSAI_ASSERT(resource < m_resources.size() && !m_resources[resource].is_texture && "Resource is not a buffer!");
+    return m_resources[resource].buffer;
+}
+
+void RenderGraph::add_access(uint32_t pass_index, RenderGraphResource resource, RenderResourceState state, bool write)
+{
+    BONSAI_ASSERT(!m_compiled && "Cannot add accesses to a compiled render graph!");
+    BONSAI_ASSERT(resource < m_resources.size() && "Render graph resource out of range!");
+    BONSAI_ASSERT(state != RenderResourceStateUndefined && "Resources cannot be accessed in the undefined state!");
+
+    // A pass uses each resource in a single state, repeated accesses are merged
+    for (auto& access : m_passes[pass_index].accesses)
+    {
+        if (access.resource == resource)
+        {
+            BONSAI_ASSERT(access.state == state && "Passes must access a resource in a single state!");
+            access.write = access.write || write;
+            return;
+        }
+    }
+
+    m_passes[pass_index].accesses.push_back(ResourceAccess{ resource, state, write });
+}
+
+void RenderGraph::cull_passes()
+{
+    // Walk passes back to front, a pass is live if it writes a resource that is an output or used by a later live pass
+    std::vector<bool> needed(m_resources.size(), false);
+    for (size_t i = 0; i < m_resources.size(); i++)
+    {
+        needed[i] = m_resources[i].output;
+    }
+
+    for (size_t i = m_passes.size(); i > 0; i--)
+    {
+        Pass& pass = m_passes[i - 1];
+        pass.live = false;
+        for (auto const& access : pass.accesses)
+        {
+            if (access.write && needed[access.resource])
+            {
+                pass.live = true;
+                break;
+            }
+        }
+
+        if (!pass.live)
+        {
+            m_statistics.culled_pass_count++;
+            continue;
+        }
+
+        // Writes may preserve earlier contents, so earlier writers of written resources are needed as well
+        for (auto const& access : pass.accesses)
+        {
+            needed[access.resource] = true;
+        }
+    }
+}
+
+void RenderGraph::compute_lifetimes()
+{
+    for (auto& resource : m_resources)
+    {
+        resource.first_pass = UINT32_MAX;
+        resource.last_pass = 0;
+        resource.last_state = RenderResourceStateUndefined;
+        resource.alias_predecessors.clear();
+    }
+
+    for (uint32_t pass_idx = 0; pass_idx < m_passes.size(); pass_idx++)
+    {
+        Pass const& pass = m_passes[pass_idx];
+        if (!pass.live)
+        {
+            continue;
+        }
+
+        for (auto const& access : pass.accesses)
+        {
+            Resource& resource = m_resources[access.resource];
+            resource.first_pass = std::min(resource.first_pass, pass_idx);
+            resource.last_pass = pass_idx;
+            resource.last_state = access.state;
+        }
+    }
+}
+
+bool RenderGraph::allocate_transient_resources()
+{
+    // Gather the memory requirements of used transient resources
+    std::vector<RenderGraphPlacement> placements{};
+    for (RenderGraphResource i = 0; i < m_resources.size(); i++)
+    {
+        Resource const& resource = m_resources[i];
+        if (resource.imported || resource.first_pass == UINT32_MAX)
+        {
+            continue;
+        }
+
+        RenderGraphPlacement placement{};
+        placement.resource = i;
+        placement.offset = 0;
+        if (resource.is_texture)
+        {
+            RenderGraphTextureDesc const& desc = resource.texture_desc;
+            placement.requirements = m_render_backend->get_texture_memory_requirements(
+                desc.texture_type,
+                desc.format,
+                desc.width,
+                desc.height,
+                desc.depth_or_layers,
+                desc.mip_levels,
+                desc.sample_count,
+                desc.texture_usage,
+                RenderTextureTilingOptimal
+            );
+        }
+        else
+        {
+            placement.requirements = m_render_backend->get_buffer_memory_requirements(resource.buffer_desc.size, resource.buffer_desc.buffer_usage);
+        }
+        placements.push_back(placement);
+    }
+
+    // Place large resources first, this keeps the heaps tightly packed
+    std::stable_sort(placements.begin(), placements.end(), [](RenderGraphPlacement const& lhs, RenderGraphPlacement const& rhs) {
+        return lhs.requirements.size > rhs.requirements.size;
+    });
+
+    // Buffers & textures use separate heaps, this avoids buffer image granularity conflicts
+    std::vector<RenderGraphHeapGroup> heap_groups{};
+    for (auto& placement : placements)
+    {
+        Resource const& resource = m_resources[placement.resource];
+        auto group_it = std::find_if(heap_groups.begin(), heap_groups.end(), [&](RenderGraphHeapGroup const& group) {
+            return group.is_texture == resource.is_texture && group.memory_type_bits == placement.requirements.memory_type_bits;
+        });
+
+        if (group_it == heap_groups.end())
+        {
+            heap_groups.push_back(RenderGraphHeapGroup{ resource.is_texture, placement.requirements.memory_type_bits, 0, 1, {} });
+            group_it = heap_groups.end() - 1;
+        }
+
+        // Move the resource past every placed resource it overlaps with in both memory & lifetime
+        size_t offset = 0;
+        bool moved = true;
+        while (moved)
+        {
+            moved = false;
+            for (auto const& placed : group_it->placements)
+            {
+                Resource const& placed_resource = m_resources[placed.resource];
+                bool const lifetimes_overlap = resource.first_pass <= placed_resource.last_pass && placed_resource.first_pass <= resource.last_pass;
+                bool const memory_overlaps = offset < placed.offset + placed.requirements.size && placed.offset < offset + placement.requirements.size;
+                if (lifetimes_overlap && memory_overlaps)
+                {
+                    offset = align_up(placed.offset + placed.requirements.size, placement.requirements.alignment);
+                    moved = true;
+                }
+            }
+        }
+
+        placement.offset = offset;
+        group_it->size = std::max(group_it->size, offset + placement.requirements.size);
+        group_it->alignment = std::max(group_it->alignment, placement.requirements.alignment);
+        group_it->placements.push_back(placement);
+        m_statistics.transient_memory_size += placement.requirements.size;
+    }
+
+    // Allocate heaps & create the placed resources
+    for (auto const& group : heap_groups)
+    {
+        RenderMemoryHeap* heap = m_render_backend->create_memory_heap(RenderMemoryRequirements{ group.size, group.alignment, group.memory_type_bits });
+        if (heap == nullptr)
+        {
+            return false;
+        }
+        m_memory_heaps.push_back(heap);
+        m_statistics.memory_heap_count++;
+        m_statistics.aliased_memory_size += group.size;
+
+        for (auto const& placement : group.placements)
+        {
+            Resource& resource = m_resources[placement.resource];
+            if (resource.is_texture)
+            {
+                RenderGraphTextureDesc const& desc = resource.texture_desc;
+                resource.texture = m_render_backend->create_aliased_texture(
+                    heap,
+                    placement.offset,
+                    desc.texture_type,
+                    desc.format,
+                    desc.width,
+                    desc.height,
+                    desc.depth_or_layers,
+                    desc.mip_levels,
+                    desc.sample_count,
+                    desc.texture_usage,
+                    RenderTextureTilingOptimal
+                );
+            }
+            else
+            {
+                resource.buffer = m_render_backend->create_aliased_buffer(heap, placement.offset, resource.buffer_desc.size, resource.buffer_desc.buffer_usage);
+            }
+
+            if (resource.texture == nullptr && resource.buffer == nullptr)
+            {
+                BONSAI_ENGINE_LOG_ERROR("Failed to create render graph resource {}", resource.name);
+                return false;
+            }
+            m_statistics.transient_resource_count++;
+
+            // Earlier resources in overlapping memory must finish their accesses before this resource takes over
+            for (auto const& other : group.placements)
+            {
+                Resource const& other_resource = m_resources[other.resource];
+                bool const memory_overlaps = placement.offset < other.offset + other.requirements.size && other.offset < placement.offset + placement.requirements.size;
+                if (memory_overlaps && other_resource.last_pass < resource.first_pass)
+                {
+                    resource.alias_predecessors.push_back(other.resource);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void RenderGraph::free_transient_resources()
+{
+    for (auto& resource : m_resources)
+    {
+        if (resource.imported)
+        {
+            continue;
+        }
+
+        delete resource.texture;
+        delete resource.buffer;
+        resource.texture = nullptr;
+        resource.buffer = nullptr;
+    }
+
+    // Heaps are freed after the resources placed in them
+    for (auto const& heap : m_memory_heaps)
+    {
+        delete heap;
+    }
+    m_memory_heaps.clear();
+}
@@ -0,0 +1,62 @@
+#include "bonsai/systems/render_thread.hpp"
+
+#include "bonsai/core/assert.hpp"
+#include "bonsai/core/profiler.hpp"
+
+RenderThread::RenderThread(Renderer* renderer)
+    :
+    m_renderer(renderer)
+{
+    BONSAI_ASSERT(renderer != nullptr && "Renderer was NULL!");
+    m_thread = std::thread(&RenderThread::run, this);
+}
+
+RenderThread::~RenderThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_submit_condition.notify_one();
+    m_thread.join();
+}
+
+void RenderThread::submit()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        BONSAI_ASSERT(m_submitted_snapshot == nullptr && "Render thread must be idle before submitting a frame!");
+        m_submitted_snapshot = &m_snapshots[m_write_index];
+        m_write_index = (m_write_index + 1) % 2;
+    }
+    m_submit_condition.notify_one();
+}
+
+void RenderThread::wait_idle()
+{
+    BONSAI_ENGINE_PROFILE_SCOPE("RenderThread::wait_idle");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle_condition.wait(lock, [this]() { return m_submitted_snapshot == nullptr; });
+}
+
+void RenderThread::run()
+{
+    Profiler::get()->set_thread_name("render");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_submit_condition.wait(lock, [this]() { return m_stop || m_submitted_snapshot != nullptr; });
+        if (m_submitted_snapshot == nullptr)
+        {
+            break; // Stop requested with no frame in flight
+        }
+
+        RenderSnapshot* snapshot = m_submitted_snapshot;
+        lock.unlock();
+        m_renderer->render(*snapshot);
+        lock.lock();
+
+        m_submitted_snapshot = nullptr;
+        m_idle_condition.notify_all();
+    }
+}
@@ -1,7 +1,11 @@
 #include "bonsai/systems/renderer.hpp"
 
+#include <fstream>
 #include <string>
+#include "bonsai/core/assert.hpp"
 #include "bonsai/core/fatal_exit.hpp"
+#include "bonsai/core/logger.hpp"
+#include "bonsai/core/profiler.hpp"
 
 // TODO(nemjit001): Add shader asset type support w/ loading from disk
 static char const* SHADER_CODE = R"(
@@ -48,9 +52,81 @@ static uint16_t INDEX_DATA[] = {
     2, 3, 0,
 };
 
-Renderer::Renderer(RenderBackend* render_backend)
+/// @brief GPU profile CSV export path, relative to the working directory.
+static char const* GPU_PROFILE_CSV_PATH = "gpu_profile.csv";
+
+/// @brief CPU profiler trace export path, relative to the working directory.
+static char const* CPU_TRACE_PATH = "cpu_trace.json";
+
+/// @brief Draw a GPU profile scope & its children as ImGui tree nodes.
+/// @param scopes Profile scopes in begin order.
+/// @param index Index of the scope to draw.
+/// @return The index of the next scope that is not a child of the drawn scope.
+static size_t draw_gpu_profile_scope(std::vector<RenderProfileScope> const& scopes, size_t index)
+{
+    RenderProfileScope const& scope = scopes[index];
+    size_t next = index + 1;
+    bool const has_children = next < scopes.size() && scopes[next].depth > scope.depth;
+
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_DefaultOpen;
+    if (!has_children)
+    {
+        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    }
+
+    bool const open = ImGui::TreeNodeEx(reinterpret_cast<void*>(index), flags, "%s: %.3f ms", scope.name.c_str(), scope.duration_ms);
+    if (scope.has_pipeline_statistics && ImGui::IsItemHovered())
+    {
+        RenderPipelineStatistics const& statistics = scope.pipeline_statistics;
+        ImGui::BeginTooltip();
+        ImGui::Text("Vertex invocations: %llu", static_cast<unsigned long long>(statistics.vertex_shader_invocations));
+        ImGui::Text("Clipping invocations: %llu", static_cast<unsigned long long>(statistics.clipping_invocations));
+        ImGui::Text("Clipping primitives: %llu", static_cast<unsigned long long>(statistics.clipping_primitives));
+        ImGui::Text("Fragment invocations: %llu", static_cast<unsigned long long>(statistics.fragment_shader_invocations));
+        ImGui::Text("Compute invocations: %llu", static_cast<unsigned long long>(statistics.compute_shader_invocations));
+        ImGui::EndTooltip();
+    }
+
+    while (next < scopes.size() && scopes[next].depth > scope.depth)
+    {
+        next = open ? draw_gpu_profile_scope(scopes, next) : next + 1;
+    }
+
+    if (has_children && open)
+    {
+        ImGui::TreePop();
+    }
+
+    return next;
+}
+
+/// @brief Release the ImGui command lists cloned into a snapshot.
+/// @param draw_data Snapshot draw data.
+static void release_draw_lists(ImDrawData& draw_data)
+{
+    for (ImDrawList* draw_list : draw_data.CmdLists)
+    {
+        IM_DELETE(draw_list);
+    }
+    draw_data.CmdLists.clear();
+}
+
+RenderSnapshot::~RenderSnapshot()
+{
+    release_draw_lists(draw_data);
+}
+
+/// @brief Draw queue pass IDs.
+enum DrawPass : uint32_t
+{
+    DrawPassScene = 0,
+};
+
+Renderer::Renderer(RenderBackend* render_backend, JobSystem* job_system)
     :
-    m_render_backend(render_backend)
+    m_render_backend(render_backend),
+    m_job_system(job_system),
+    m_render_graph(render_backend)
 {
     m_swap_extent = m_render_backend->get_swap_extent();
 
@@ -106,6 +182,7 @@ Renderer::Renderer(RenderBackend* render_backend)
     pipeline_descriptor.color_attachment_count = 1;
     pipeline_descriptor.color_attachment_formats[0] = m_render_backend->get_swap_format();
     pipeline_descriptor.depth_stencil_attachment_format = RenderFormatUndefined;
+    pipeline_descriptor.view_mask = 0;
 
     m_shader_pipeline = m_render_backend->create_graphics_pipeline(pipeline_descriptor);
     if (!m_shader_pipeline)
@@ -131,11 +208,14 @@ Renderer::Renderer(RenderBackend* render_backend)
     }
     memcpy(index_buffer_data, INDEX_DATA, sizeof(INDEX_DATA));
     m_index_buffer->unmap();
+
+    build_render_graph();
 }
 
 Renderer::~Renderer()
 {
     m_render_backend->wait_idle();
+    m_render_graph.reset();
     delete m_index_buffer;
     delete m_vertex_buffer;
     delete m_shader_pipeline;
@@ -152,25 +232,71 @@ void Renderer::on_resize(uint32_t width, uint32_t height)
     m_render_backend->wait_idle();
     m_render_backend->reconfigure_swap_chain(width, height);
     m_swap_extent = m_render_backend->get_swap_extent();
+    build_render_graph();
 }
 
-void Renderer::render()
+void Renderer::prepare(RenderSnapshot& snapshot)
 {
-    if (m_swap_extent.width == 0 || m_swap_extent.height == 0)
+    BONSAI_ENGINE_PROFILE_SCOPE("Renderer::prepare");
+    double gpu_time_ms = 0.0;
+    for (auto const& scope : m_render_backend->get_gpu_profile().scopes)
     {
-        return;
+        gpu_time_ms += scope.depth == 0 ? scope.duration_ms : 0.0;
     }
+    m_gpu_frame_time_ms = gpu_time_ms;
 
-    if (m_render_backend->new_frame() == RenderBackendFrameResult::FatalError)
+    release_draw_lists(snapshot.draw_data);
+    snapshot.has_draw_data = false;
+    if (m_swap_extent.width == 0 || m_swap_extent.height == 0)
     {
-        BONSAI_FATAL_EXIT("Failed to start renderer frame\n");
+        return;
     }
 
+    m_render_backend->imgui_new_frame();
     ImGui::NewFrame();
     // TODO(nemjit001): render GUI here (using app specific function?)
+    if (ImGui::Begin("Renderer statistics"))
+    {
+        ImGui::Text("Pipeline barriers: %u", m_frame_statistics.pipeline_barriers);
+        ImGui::Text("Image barriers:    %u", m_frame_statistics.image_barriers);
+        ImGui::Text("Memory barriers:   %u", m_frame_statistics.memory_barriers);
+        ImGui::Text("Skipped barriers:  %u", m_frame_statistics.skipped_transitions);
+        ImGui::Text("Skipped binds:     %u", m_frame_statistics.skipped_state_changes);
+
+        RenderGraphStatistics const graph_statistics = m_render_graph.get_statistics();
+        ImGui::Text("Graph passes:      %u (%u culled)", graph_statistics.pass_count, graph_statistics.culled_pass_count);
+        ImGui::Text("Transient memory:  %zu / %zu bytes", graph_statistics.aliased_memory_size, graph_statistics.transient_memory_size);
+    }
+    ImGui::End();
+    draw_cpu_profiler();
+    draw_gpu_profiler();
     ImGui::EndFrame();
     ImGui::Render();
 
+    // The next ImGui frame reuses the context draw lists, so the render thread draws from clones
+    ImDrawData const* draw_data = ImGui::GetDrawData();
+    snapshot.draw_data = *draw_data;
+    for (int i = 0; i < draw_data->CmdLists.Size; i++)
+    {
+        snapshot.draw_data.CmdLists[i] = draw_data->CmdLists[i]->CloneOutput();
+    }
+    snapshot.has_draw_data = true;
+}
+
+void Renderer::render(RenderSnapshot& snapshot)
+{
+    BONSAI_ENGINE_PROFILE_SCOPE("Renderer::render");
+    if (!snapshot.has_draw_data || m_swap_extent.width == 0 || m_swap_extent.height == 0)
+    {
+        return;
+    }
+
+    if (m_render_backend->new_frame() == RenderBackendFrameResult::FatalError)
+    {
+        BONSAI_FATAL_EXIT("Failed to start renderer frame\n");
+    }
+
+    m_active_snapshot = &snapshot;
     RenderCommands* frame_commands = m_render_backend->get_frame_commands();
     RenderTexture* swap_texture = m_render_backend->get_current_swap_texture();
     if (!frame_commands->begin())
@@ -178,49 +304,200 @@ void Renderer::render()
         BONSAI_FATAL_EXIT("Failed to start renderer frame command recording\n");
     }
 
+    queue_draws();
+    m_render_graph.set_imported_texture(m_swap_target, swap_texture);
+    frame_commands->begin_profile_scope("frame", false);
+    m_render_graph.execute(frame_commands);
+    frame_commands->end_profile_scope();
+
+    if (!frame_commands->end())
+    {
+        BONSAI_FATAL_EXIT("Failed to end renderer frame command recording\n");
+    }
+    m_frame_statistics = frame_commands->get_statistics();
+    m_active_snapshot = nullptr;
+
+    if (m_render_backend->end_frame() == RenderBackendFrameResult::FatalError)
+    {
+        BONSAI_FATAL_EXIT("Failed to end renderer frame\n");
+    }
+}
+
+double Renderer::get_gpu_frame_time_ms() const
+{
+    return m_gpu_frame_time_ms;
+}
+
+void Renderer::draw_cpu_profiler()
+{
+    if (ImGui::Begin("CPU profiler"))
+    {
+        Profiler* profiler = Profiler::get();
+        bool capturing = profiler->is_capturing();
+        if (ImGui::Checkbox("Capture", &capturing))
+        {
+            profiler->set_capturing(capturing);
+        }
+
+        ImGui::Text("Captured zones: %zu", profiler->get_captured_zones().size());
+        ImGui::Text("Dropped zones:  %llu", static_cast<unsigned long long>(profiler->get_dropped_zone_count()));
+        if (ImGui::Button("Export trace"))
+        {
+            profiler->write_chrome_trace(CPU_TRACE_PATH);
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+        {
+            profiler->clear_capture();
+        }
+    }
+    ImGui::End();
+}
+
+void Renderer::draw_gpu_profiler()
+{
+    if (ImGui::Begin("GPU profiler"))
+    {
+        RenderGpuProfile const& profile = m_render_backend->get_gpu_profile();
+        ImGui::Text("Frame: %llu", static_cast<unsigned long long>(profile.frame_index));
+        if (ImGui::Button("Export CSV"))
+        {
+            export_gpu_profile_csv(GPU_PROFILE_CSV_PATH);
+        }
+
+        bool pipeline_statistics = m_render_graph.pipeline_statistics_enabled();
+        if (ImGui::Checkbox("Pipeline statistics", &pipeline_statistics))
+        {
+            m_render_graph.set_pipeline_statistics_enabled(pipeline_statistics);
+        }
+
+        size_t scope_index = 0;
+        while (scope_index < profile.scopes.size())
+        {
+            scope_index = draw_gpu_profile_scope(profile.scopes, scope_index);
+        }
+    }
+    ImGui::End();
+}
+
+bool Renderer::export_gpu_profile_csv(char const* path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        BONSAI_ENGINE_LOG_ERROR("Failed to open GPU profile CSV file \"{}\"", path);
+        return false;
+    }
+
+    // Scope paths are joined with '/' so nested passes can be compared across exports, missing statistics are left empty
+    RenderGpuProfile const& profile = m_render_backend->get_gpu_profile();
+    std::vector<std::string> scope_paths(profile.scopes.size());
+    file << "frame,scope,depth,start_ms,duration_ms,"
+        << "vertex_invocations,clipping_invocations,clipping_primitives,fragment_invocations,compute_invocations\n";
+    for (size_t i = 0; i < profile.scopes.size(); i++)
+    {
+        RenderProfileScope const& scope = profile.scopes[i];
+        scope_paths[i] = scope.parent < i ? scope_paths[scope.parent] + "/" + scope.name : scope.name;
+        file << profile.frame_index << ","
+            << scope_paths[i] << ","
+            << scope.depth << ","
+            << scope.start_ms << ","
+            << scope.duration_ms;
+
+        RenderPipelineStatistics const& statistics = scope.pipeline_statistics;
+        if (scope.has_pipeline_statistics)
+        {
+            file << "," << statistics.vertex_shader_invocations
+                << "," << statistics.clipping_invocations
+                << "," << statistics.clipping_primitives
+                << "," << statistics.fragment_shader_invocations
+                << "," << statistics.compute_shader_invocations << "\n";
+        }
+        else
+        {
+            file << ",,,,,\n";
+        }
+    }
+
+    BONSAI_ENGINE_LOG_INFO("Exported GPU profile to \"{}\"", path);
+    return true;
+}
+
+void Renderer::build_render_graph()
+{
+    m_render_graph.reset();
+    m_swap_target = m_render_graph.import_texture("swap_target", nullptr, RenderResourceStatePresent);
+
+    m_render_graph.add_pass("scene", [this](RenderGraph const& graph, RenderCommands* commands) { record_scene_pass(graph, commands); })
+        .write(m_swap_target, RenderResourceStateColorTarget);
+
+    m_render_graph.add_pass("imgui", [this](RenderGraph const& graph, RenderCommands* commands) { record_imgui_pass(graph, commands); })
+        .write(m_swap_target, RenderResourceStateColorTarget);
+
+    if (!m_render_graph.compile())
+    {
+        BONSAI_FATAL_EXIT("Failed to compile frame render graph\n");
+    }
+}
+
+void Renderer::queue_draws()
+{
+    DrawPacket quad_packet{};
+    quad_packet.pipeline = m_shader_pipeline;
+    quad_packet.vertex_buffer = m_vertex_buffer;
+    quad_packet.vertex_buffer_offset = 0;
+    quad_packet.index_buffer = m_index_buffer;
+    quad_packet.index_buffer_offset = 0;
+    quad_packet.index_type = IndexTypeUint16;
+    quad_packet.index_count = static_cast<uint32_t>(std::size(INDEX_DATA));
+    quad_packet.instance_count = 1;
+    quad_packet.first_index = 0;
+    quad_packet.vertex_offset = 0;
+    quad_packet.first_instance = 0;
+
+    m_draw_queue.clear();
+    m_draw_queue.push(make_draw_key(DrawPassScene, 0, 0, 0, 0), quad_packet);
+    m_draw_queue.sort(m_job_system);
+}
+
+void Renderer::record_scene_pass(RenderGraph const& graph, RenderCommands* commands)
+{
     RenderRect2D render_area{};
     render_area.offset = { 0, 0 };
     render_area.extent = { m_swap_extent.width, m_swap_extent.height  };
 
     RenderAttachmentInfo color_attachment{};
-    color_attachment.render_target = swap_texture;
+    color_attachment.render_target = graph.get_texture(m_swap_target);
     color_attachment.load_op = RenderLoadOpClear;
     color_attachment.store_op = RenderStoreOpStore;
     color_attachment.clear_value = RenderClearValue{{{ 0.0F, 0.0F, 0.0F, 0.0F }}};
 
-    frame_commands->begin_render_pass(render_area, &color_attachment, 1, nullptr, nullptr);
-    frame_commands->set_pipeline(m_shader_pipeline);
+    commands->begin_render_pass(render_area, &color_attachment, 1, nullptr, nullptr, 1, 0);
 
     RenderViewport viewport{ 0.0F, 0.0F, static_cast<float>(m_swap_extent.width), static_cast<float>(m_swap_extent.height), 0.0F, 1.0F };
     RenderRect2D scissor{ { 0, 0 }, { m_swap_extent.width, m_swap_extent.height } };
-    frame_commands->set_viewports(1, &viewport);
-    frame_commands->set_scissor_rects(1, &scissor);
-    frame_commands->set_primitive_topology(PrimitiveTopologyTypeTriangleList);
+    commands->set_viewports(1, &viewport);
+    commands->set_scissor_rects(1, &scissor);
+    commands->set_primitive_topology(PrimitiveTopologyTypeTriangleList);
+    m_draw_queue.submit(commands, DrawPassScene);
+    commands->end_render_pass();
+}
 
-    size_t offsets[] = { 0 };
-    frame_commands->bind_vertex_buffers(0, 1, &m_vertex_buffer, offsets);
-    frame_commands->bind_index_buffer(m_index_buffer, 0, IndexTypeUint16);
-    frame_commands->draw_indexed_instanced(6, 1, 0, 0, 0);
-    frame_commands->end_render_pass();
+void Renderer::record_imgui_pass(RenderGraph const& graph, RenderCommands* commands)
+{
+    RenderRect2D render_area{};
+    render_area.offset = { 0, 0 };
+    render_area.extent = { m_swap_extent.width, m_swap_extent.height  };
 
     RenderAttachmentInfo imgui_color_attachment{};
-    imgui_color_attachment.render_target = swap_texture;
+    imgui_color_attachment.render_target = graph.get_texture(m_swap_target);
     imgui_color_attachment.load_op = RenderLoadOpLoad;
     imgui_color_attachment.store_op = RenderStoreOpStore;
     imgui_color_attachment.clear_value = {};
 
-    frame_commands->begin_render_pass(render_area, &imgui_color_attachment, 1, nullptr, nullptr);
-    frame_commands->imgui_render_draw_data(ImGui::GetDrawData());
-    frame_commands->end_render_pass();
-    frame_commands->mark_for_present(swap_texture);
-
-    if (!frame_commands->end())
-    {
-        BONSAI_FATAL_EXIT("Failed to end renderer frame command recording\n");
-    }
-
-    if (m_render_backend->end_frame() == RenderBackendFrameResult::FatalError)
-    {
-        BONSAI_FATAL_EXIT("Failed to end renderer frame\n");
-    }
+    commands->begin_render_pass(render_area, &imgui_color_attachment, 1, nullptr, nullptr, 1, 0);
+    BONSAI_ASSERT(m_active_snapshot != nullptr && "ImGui pass recorded outside of a frame!");
+    commands->imgui_render_draw_data(&m_active_snapshot->draw_data);
+    commands->end_render_pass();
 }
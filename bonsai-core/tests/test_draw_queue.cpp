@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "bonsai/core/job_system.hpp"
+#include "bonsai/systems/draw_queue.hpp"
+
+/*
+ * Draw queue sorting tests, packets are never submitted so no render backend is required.
+ */
+static DrawPacket get_test_packet(uint32_t first_instance)
+{
+    DrawPacket packet{};
+    packet.index_count = 3;
+    packet.instance_count = 1;
+    packet.first_instance = first_instance;
+    return packet;
+}
+
+TEST(draw_queue_tests, key_fields_are_ordered_by_significance)
+{
+    EXPECT_LT(make_draw_key(0, 1, 0, 0, 0), make_draw_key(1, 0, 0, 0, 0));
+    EXPECT_LT(make_draw_key(0, 0, 1, 0, 0), make_draw_key(0, 1, 0, 0, 0));
+    EXPECT_LT(make_draw_key(0, 0, 0, 1, 0), make_draw_key(0, 0, 1, 0, 0));
+    EXPECT_LT(make_draw_key(0, 0, 0, 0, 1), make_draw_key(0, 0, 0, 1, 0));
+    EXPECT_EQ(get_draw_key_pass(make_draw_key(5, 4095, 0, 0, 0)), 5);
+}
+
+TEST(draw_queue_tests, equal_keys_keep_submission_order)
+{
+    DrawQueue queue{};
+    queue.push(make_draw_key(1, 2, 0, 0, 0), get_test_packet(0));
+    queue.push(make_draw_key(0, 7, 0, 0, 0), get_test_packet(1));
+    queue.push(make_draw_key(1, 2, 0, 0, 0), get_test_packet(2));
+    queue.push(make_draw_key(0, 3, 0, 0, 0), get_test_packet(3));
+    queue.sort();
+
+    ASSERT_EQ(queue.size(), 4);
+    EXPECT_EQ(queue.get_packet(0).first_instance, 3);
+    EXPECT_EQ(queue.get_packet(1).first_instance, 1);
+    EXPECT_EQ(queue.get_packet(2).first_instance, 0);
+    EXPECT_EQ(queue.get_packet(3).first_instance, 2);
+}
+
+TEST(draw_queue_tests, large_queue_matches_stable_sort)
+{
+    // Large enough to be sorted in multiple jobs, the serial sort must give the same order
+    static constexpr uint32_t PACKET_COUNT = 100'000;
+    std::vector<uint64_t> keys{};
+    keys.reserve(PACKET_COUNT);
+
+    DrawQueue queue{};
+    DrawQueue serial_queue{};
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t i = 0; i < PACKET_COUNT; i++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t const key = make_draw_key(
+            static_cast<uint32_t>(state >> 62),
+            static_cast<uint32_t>(state >> 50),
+            static_cast<uint32_t>(state >> 40) & 0x3,
+            static_cast<uint32_t>(state >> 30),
+            static_cast<uint32_t>(state >> 10)
+        );
+        keys.push_back(key);
+        queue.push(key, get_test_packet(i));
+        serial_queue.push(key, get_test_packet(i));
+    }
+
+    std::vector<uint32_t> expected(PACKET_COUNT);
+    for (uint32_t i = 0; i < PACKET_COUNT; i++)
+    {
+        expected[i] = i;
+    }
+    std::stable_sort(expected.begin(), expected.end(), [&keys](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+    JobSystem job_system(4);
+    queue.sort(&job_system);
+    serial_queue.sort();
+
+    ASSERT_EQ(queue.size(), PACKET_COUNT);
+    ASSERT_EQ(serial_queue.size(), PACKET_COUNT);
+    size_t mismatch_count = 0;
+    size_t serial_mismatch_count = 0;
+    for (uint32_t i = 0; i < PACKET_COUNT; i++)
+    {
+        mismatch_count += queue.get_packet(i).first_instance != expected[i] ? 1 : 0;
+        serial_mismatch_count += serial_queue.get_packet(i).first_instance != expected[i] ? 1 : 0;
+    }
+    EXPECT_EQ(mismatch_count, 0);
+    EXPECT_EQ(serial_mismatch_count, 0);
+}
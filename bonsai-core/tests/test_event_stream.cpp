@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "bonsai/core/event_stream.hpp"
+
+/*
+ * Event stream tests, each test uses its own event stream so the engine event stream is left untouched.
+ */
+TEST(event_stream_tests, events_are_decoded_in_write_order)
+{
+    static constexpr uint64_t EVENTS_PER_THREAD = 1000;
+    char const* path = "test_event_stream_order.bin";
+    EventStream stream{};
+    ASSERT_TRUE(stream.open(path, 4096));
+    stream.write(EventTypeSwapchainRecreated, 1600, 900);
+
+    std::vector<std::thread> threads{};
+    for (uint64_t thread_index = 0; thread_index < 2; thread_index++)
+    {
+        threads.emplace_back([&stream, thread_index]() {
+            for (uint64_t i = 0; i < EVENTS_PER_THREAD; i++)
+            {
+                stream.write(EventTypeAllocation, thread_index, i);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    stream.close();
+
+    EventStreamInfo info{};
+    std::vector<EventRecord> records{};
+    ASSERT_TRUE(read_event_stream(path, info, records));
+    std::remove(path);
+
+    EXPECT_EQ(info.capacity, 4096);
+    EXPECT_EQ(info.write_count, 2 * EVENTS_PER_THREAD + 1);
+    ASSERT_EQ(records.size(), 2 * EVENTS_PER_THREAD + 1);
+    EXPECT_EQ(records[0].type, EventTypeSwapchainRecreated);
+    EXPECT_EQ(records[0].data[0], 1600);
+    EXPECT_EQ(records[0].data[1], 900);
+
+    // Events of a single thread keep their order & all threads get distinct IDs
+    uint64_t next_event[2] = { 0, 0 };
+    uint32_t thread_ids[2] = { UINT32_MAX, UINT32_MAX };
+    size_t mismatch_count = 0;
+    for (size_t i = 1; i < records.size(); i++)
+    {
+        EventRecord const& record = records[i];
+        uint64_t const thread_index = record.data[0];
+        ASSERT_LT(thread_index, 2);
+        mismatch_count += record.type != EventTypeAllocation || record.data[1] != next_event[thread_index] ? 1 : 0;
+        next_event[thread_index]++;
+        thread_ids[thread_index] = record.thread_id;
+    }
+    EXPECT_EQ(mismatch_count, 0);
+    EXPECT_NE(thread_ids[0], thread_ids[1]);
+    EXPECT_NE(records[0].thread_id, thread_ids[0]);
+}
+
+TEST(event_stream_tests, full_ring_keeps_newest_events)
+{
+    char const* path = "test_event_stream_ring.bin";
+    EventStream stream{};
+    ASSERT_TRUE(stream.open(path, 100)); // Rounded up to 128 records
+    for (uint64_t i = 0; i < 300; i++)
+    {
+        stream.write(EventTypeFrameBegin, i, 0);
+    }
+    stream.close();
+
+    EventStreamInfo info{};
+    std::vector<EventRecord> records{};
+    ASSERT_TRUE(read_event_stream(path, info, records));
+    std::remove(path);
+
+    EXPECT_EQ(info.capacity, 128);
+    EXPECT_EQ(info.write_count, 300);
+    ASSERT_EQ(records.size(), 128);
+    EXPECT_EQ(records.front().data[0], 300 - 128);
+    EXPECT_EQ(records.back().data[0], 299);
+    for (size_t i = 1; i < records.size(); i++)
+    {
+        EXPECT_LE(records[i - 1].timestamp_ns, records[i].timestamp_ns);
+    }
+}
+
+TEST(event_stream_tests, invalid_files_are_rejected)
+{
+    char const* path = "test_event_stream_invalid.bin";
+    std::ofstream file(path, std::ios::binary);
+    file << "not an event stream, but long enough to hold an event stream header........................";
+    file.close();
+
+    EventStreamInfo info{};
+    std::vector<EventRecord> records{};
+    EXPECT_FALSE(read_event_stream(path, info, records));
+    std::remove(path);
+
+    EXPECT_FALSE(read_event_stream("missing_event_stream.bin", info, records));
+}
+
+TEST(event_stream_tests, corrupt_capacity_is_rejected)
+{
+    char const* path = "test_event_stream_capacity.bin";
+    {
+        EventStream stream{};
+        ASSERT_TRUE(stream.open(path, 16));
+        stream.write(EventTypeFrameBegin, 1, 0);
+        stream.close();
+    }
+
+    EventStreamInfo info{};
+    std::vector<EventRecord> records{};
+    ASSERT_TRUE(read_event_stream(path, info, records));
+
+    // Capacities that are not a power of two, or larger than the records in the file, must fail before allocating.
+    // The capacity follows the four 32 bit header fields.
+    static constexpr std::streamoff CAPACITY_OFFSET = 4 * sizeof(uint32_t);
+    uint64_t const corrupt_capacities[] = { 12, 32, UINT64_C(1) << 62 };
+    for (uint64_t const capacity : corrupt_capacities)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(CAPACITY_OFFSET);
+        file.write(reinterpret_cast<char const*>(&capacity), sizeof(capacity));
+        file.close();
+        EXPECT_FALSE(read_event_stream(path, info, records));
+    }
+    std::remove(path);
+}
+
+TEST(event_stream_tests, closed_stream_ignores_events)
+{
+    EventStream stream{};
+    EXPECT_FALSE(stream.is_open());
+    stream.write(EventTypeFrameEnd, 0, 0);
+    EXPECT_FALSE(stream.is_open());
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include "bonsai/core/frame_clock.hpp"
+
+/*
+ * Frame clock tests, the accumulator is advanced manually so results do not depend on wall time.
+ */
+static FrameClockConfig get_test_config(double target_frame_rate)
+{
+    FrameClockConfig config{};
+    config.fixed_timestep = 0.01;
+    config.max_fixed_steps = 4;
+    config.max_frame_delta = 0.1;
+    config.target_frame_rate = target_frame_rate;
+    return config;
+}
+
+static uint32_t consume_all_steps(FrameClock& clock)
+{
+    uint32_t step_count = 0;
+    while (clock.consume_fixed_step())
+    {
+        step_count++;
+    }
+
+    return step_count;
+}
+
+TEST(frame_clock_tests, fixed_steps_consume_accumulated_time)
+{
+    FrameClock clock(get_test_config(0.0));
+    clock.advance(0.025);
+    EXPECT_EQ(consume_all_steps(clock), 2);
+    EXPECT_LT(std::abs(clock.get_timings().interpolation_alpha - 0.5), 1e-6);
+
+    // The remainder carries over to the next frame
+    clock.advance(0.005);
+    EXPECT_EQ(consume_all_steps(clock), 1);
+    EXPECT_LT(clock.get_timings().interpolation_alpha, 1e-6);
+}
+
+TEST(frame_clock_tests, slow_frames_are_clamped_to_the_step_budget)
+{
+    FrameClock clock(get_test_config(0.0));
+    clock.advance(1.0);
+    EXPECT_LT(std::abs(clock.get_timings().frame_delta - 0.1), 1e-9);
+    EXPECT_EQ(consume_all_steps(clock), 4);
+    EXPECT_EQ(clock.get_timings().fixed_step_count, 4);
+    EXPECT_LT(clock.get_timings().interpolation_alpha, 1.0);
+
+    // Excess time was dropped, so the next short frame does not catch up on it
+    clock.begin_frame();
+    EXPECT_EQ(consume_all_steps(clock), 0);
+}
+
+TEST(frame_clock_tests, frame_cap_paces_frames)
+{
+    static constexpr uint32_t FRAME_COUNT = 5;
+    FrameClock clock(get_test_config(200.0));
+
+    auto const start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        clock.begin_frame();
+        clock.end_frame(0.0);
+    }
+    double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(clock.get_timings().frame_index, FRAME_COUNT);
+    EXPECT_GE(elapsed, FRAME_COUNT / 200.0 * 0.99);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+/*
+ * These are Vulkan only unit tests for the image state tracker, they only test barrier generation and do not require
+ * a Vulkan device.
+ */
+#if BONSAI_USE_VULKAN
+#include "../src/render_backend/vulkan/image_state_tracker.hpp"
+
+static constexpr VkImage TEST_IMAGE = VK_NULL_HANDLE;
+
+static constexpr ImageSubresourceState SAMPLED_STATE = {
+    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+    VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+};
+
+static constexpr ImageSubresourceState COLOR_WRITE_STATE = {
+    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+    VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+    VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+};
+
+TEST(image_state_tracker_tests, full_range_transition_is_single_barrier)
+{
+    ImageStateTracker tracker(VK_IMAGE_ASPECT_COLOR_BIT, 4, 6);
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 4, 0, 6 }, SAMPLED_STATE, false, barriers), 1);
+    ASSERT_EQ(barriers.size(), 1);
+    EXPECT_EQ(barriers[0].oldLayout, VK_IMAGE_LAYOUT_UNDEFINED);
+    EXPECT_EQ(barriers[0].newLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    EXPECT_EQ(barriers[0].subresourceRange.baseMipLevel, 0);
+    EXPECT_EQ(barriers[0].subresourceRange.levelCount, 4);
+    EXPECT_EQ(barriers[0].subresourceRange.baseArrayLayer, 0);
+    EXPECT_EQ(barriers[0].subresourceRange.layerCount, 6);
+}
+
+TEST(image_state_tracker_tests, single_mip_transition_leaves_other_mips)
+{
+    ImageStateTracker tracker(VK_IMAGE_ASPECT_COLOR_BIT, 4, 1);
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, 1 }, SAMPLED_STATE, false, barriers);
+
+    barriers.clear();
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 2, 1, 0, 1 }, COLOR_WRITE_STATE, false, barriers), 1);
+    EXPECT_EQ(barriers[0].oldLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    EXPECT_EQ(barriers[0].subresourceRange.baseMipLevel, 2);
+    EXPECT_EQ(barriers[0].subresourceRange.levelCount, 1);
+    EXPECT_EQ(tracker.get_layout(1, 0), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    EXPECT_EQ(tracker.get_layout(2, 0), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    EXPECT_EQ(tracker.get_layout(3, 0), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+TEST(image_state_tracker_tests, mixed_states_split_into_minimal_barriers)
+{
+    ImageStateTracker tracker(VK_IMAGE_ASPECT_COLOR_BIT, 2, 4);
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 2, 1, 2 }, COLOR_WRITE_STATE, false, barriers);
+
+    // Layers 0 & 3 are undefined, layers 1 & 2 are color attachments, the same layer runs merge across both mips
+    barriers.clear();
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 2, 0, 4 }, SAMPLED_STATE, false, barriers), 3);
+    for (auto const& barrier : barriers)
+    {
+        EXPECT_EQ(barrier.subresourceRange.levelCount, 2);
+        EXPECT_EQ(barrier.newLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+    EXPECT_EQ(barriers[1].oldLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    EXPECT_EQ(barriers[1].srcAccessMask, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+    EXPECT_EQ(barriers[1].subresourceRange.baseArrayLayer, 1);
+    EXPECT_EQ(barriers[1].subresourceRange.layerCount, 2);
+}
+
+TEST(image_state_tracker_tests, read_after_read_skips_barrier)
+{
+    ImageStateTracker tracker(VK_IMAGE_ASPECT_COLOR_BIT, 1, 1);
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, SAMPLED_STATE, false, barriers);
+
+    barriers.clear();
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, SAMPLED_STATE, false, barriers), 0);
+
+    // A read in a new stage needs a barrier with no source access, after which both stages may read freely
+    ImageSubresourceState const compute_read_state{ SAMPLED_STATE.layout, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, SAMPLED_STATE.access_mask };
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, compute_read_state, false, barriers), 1);
+    EXPECT_EQ(barriers[0].srcAccessMask, VK_ACCESS_2_NONE);
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, SAMPLED_STATE, false, barriers), 0);
+}
+
+TEST(image_state_tracker_tests, write_after_write_emits_barrier)
+{
+    ImageStateTracker tracker(VK_IMAGE_ASPECT_COLOR_BIT, 1, 1);
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, COLOR_WRITE_STATE, false, barriers);
+
+    barriers.clear();
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, COLOR_WRITE_STATE, false, barriers), 1);
+    EXPECT_EQ(barriers[0].oldLayout, barriers[0].newLayout);
+}
+
+TEST(image_state_tracker_tests, discard_transitions_from_undefined)
+{
+    ImageStateTracker tracker(VK_IMAGE_ASPECT_COLOR_BIT, 1, 1);
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, SAMPLED_STATE, false, barriers);
+
+    barriers.clear();
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, COLOR_WRITE_STATE, true, barriers), 1);
+    EXPECT_EQ(barriers[0].oldLayout, VK_IMAGE_LAYOUT_UNDEFINED);
+    EXPECT_EQ(barriers[0].srcStageMask, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+}
+
+TEST(image_state_tracker_tests, alias_waits_on_previous_memory_users)
+{
+    ImageStateTracker tracker(VK_IMAGE_ASPECT_COLOR_BIT, 1, 1);
+    std::vector<VkImageMemoryBarrier2> barriers{};
+    tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, SAMPLED_STATE, false, barriers);
+
+    // The aliased memory was last written as a color attachment by another image
+    tracker.alias(COLOR_WRITE_STATE.stage_mask, COLOR_WRITE_STATE.access_mask);
+    EXPECT_EQ(tracker.get_layout(0, 0), VK_IMAGE_LAYOUT_UNDEFINED);
+
+    barriers.clear();
+    EXPECT_EQ(tracker.transition(TEST_IMAGE, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }, SAMPLED_STATE, true, barriers), 1);
+    EXPECT_EQ(barriers[0].oldLayout, VK_IMAGE_LAYOUT_UNDEFINED);
+    EXPECT_EQ(barriers[0].srcStageMask, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+    EXPECT_EQ(barriers[0].srcAccessMask, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+}
+#endif //BONSAI_USE_VULKAN
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "bonsai/core/job_system.hpp"
+
+/*
+ * Job system tests, each test creates its own job system with a fixed worker count.
+ */
+TEST(job_system_tests, parallel_for_visits_each_element_once)
+{
+    static constexpr size_t ELEMENT_COUNT = 10'000;
+    JobSystem job_system(4);
+    std::vector<uint32_t> visits(ELEMENT_COUNT, 0);
+    job_system.parallel_for(ELEMENT_COUNT, 64, [&visits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            visits[i]++;
+        }
+    });
+
+    size_t mismatch_count = 0;
+    for (auto const& visit_count : visits)
+    {
+        mismatch_count += visit_count != 1 ? 1 : 0;
+    }
+    EXPECT_EQ(mismatch_count, 0);
+}
+
+TEST(job_system_tests, dependent_jobs_run_after_their_dependency)
+{
+    JobSystem job_system(2);
+    std::atomic<uint32_t> finished_count{ 0 };
+    std::atomic<bool> dependency_order_ok{ true };
+
+    JobCounter first_counter{};
+    JobCounter second_counter{};
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        job_system.submit([&finished_count]() {
+            std::this_thread::yield();
+            finished_count.fetch_add(1);
+        }, &first_counter);
+    }
+
+    job_system.submit([&finished_count, &dependency_order_ok]() {
+        dependency_order_ok = finished_count.load() == 32;
+    }, &second_counter, &first_counter);
+    job_system.wait(second_counter);
+
+    EXPECT_TRUE(first_counter.is_done());
+    EXPECT_TRUE(dependency_order_ok.load());
+}
+
+TEST(job_system_tests, chained_dependencies_do_not_deadlock_a_single_worker)
+{
+    JobSystem job_system(1);
+    std::atomic<bool> gate_open{ false };
+    std::atomic<uint32_t> next_order{ 0 };
+    uint32_t first_order = UINT32_MAX;
+    uint32_t second_order = UINT32_MAX;
+    uint32_t third_order = UINT32_MAX;
+
+    // The gate holds the worker until all jobs are queued, the worker then pops the second job before the last one.
+    // A worker that waits on dependencies inside a job would block on a job deeper in its own stack.
+    JobCounter gate_counter{};
+    JobCounter first_counter{};
+    JobCounter second_counter{};
+    JobCounter third_counter{};
+    job_system.submit([&gate_open]() {
+        while (!gate_open.load())
+        {
+            std::this_thread::yield();
+        }
+    }, &gate_counter);
+    job_system.submit([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        first_order = next_order.fetch_add(1);
+    }, &first_counter);
+    job_system.submit([&]() { third_order = next_order.fetch_add(1); }, &third_counter, &second_counter);
+    job_system.submit([&]() { second_order = next_order.fetch_add(1); }, &second_counter, &first_counter);
+    gate_open = true;
+    job_system.wait(third_counter);
+    job_system.wait(gate_counter);
+
+    EXPECT_EQ(first_order, 0);
+    EXPECT_EQ(second_order, 1);
+    EXPECT_EQ(third_order, 2);
+}
+
+TEST(job_system_tests, nested_jobs_are_stolen_by_other_workers)
+{
+    static constexpr uint32_t NESTED_JOB_COUNT = 256;
+    JobSystem job_system(4);
+    std::atomic<uint32_t> job_count{ 0 };
+
+    // All nested jobs are pushed onto a single worker queue, idle workers must steal them
+    JobCounter outer_counter{};
+    JobCounter nested_counter{};
+    job_system.submit([&]() {
+        for (uint32_t i = 0; i < NESTED_JOB_COUNT; i++)
+        {
+            job_system.submit([&job_count]() { job_count.fetch_add(1); }, &nested_counter);
+        }
+    }, &outer_counter);
+    job_system.wait(outer_counter);
+    job_system.wait(nested_counter);
+
+    EXPECT_EQ(job_count.load(), NESTED_JOB_COUNT);
+}
+
+TEST(job_system_tests, main_thread_jobs_run_on_the_main_thread)
+{
+    JobSystem job_system(2);
+    std::thread::id const main_thread_id = std::this_thread::get_id();
+    std::atomic<bool> ran_on_main_thread{ false };
+
+    // A worker job hands work to the main thread, which runs it while waiting
+    JobCounter counter{};
+    job_system.submit([&]() {
+        job_system.submit_main_thread([&]() { ran_on_main_thread = std::this_thread::get_id() == main_thread_id; }, &counter);
+    }, &counter);
+    job_system.wait(counter);
+
+    EXPECT_TRUE(job_system.is_main_thread());
+    EXPECT_TRUE(ran_on_main_thread.load());
+}
@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+
+/*
+ * These are Vulkan only smoke tests for parallel render passes. Vulkan entry points are replaced by recording stubs,
+ * so no device is required, the tests check the secondary command buffers recorded by the parallel recorders.
+ */
+#if BONSAI_USE_VULKAN
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <volk.h>
+#include "bonsai/core/job_system.hpp"
+#include "../src/render_backend/vulkan/vulkan_parallel_recorder_pool.hpp"
+#include "../src/render_backend/vulkan/vulkan_render_commands.hpp"
+#include "../src/render_backend/vulkan/vulkan_shader_pipeline.hpp"
+#include "../src/render_backend/vulkan/vulkan_texture.hpp"
+
+/// @brief Maximum number of fake command buffers handed out by the stubs, index 0 is the primary command buffer.
+static constexpr uint32_t MAX_STUB_COMMAND_BUFFERS = 128;
+
+/// @brief State captured for a fake command buffer by the stubbed entry points.
+struct StubCommandBuffer
+{
+    bool ended;
+    VkCommandBufferUsageFlags usage_flags;
+    uint32_t inherited_color_count;
+    VkFormat inherited_color_format;
+    uint32_t draw_count;
+};
+
+static StubCommandBuffer s_command_buffers[MAX_STUB_COMMAND_BUFFERS] = {};
+static uint32_t s_allocated_command_buffers = 0;
+static VkRenderingFlags s_rendering_flags = 0;
+static std::vector<VkCommandBuffer> s_executed_command_buffers = {};
+
+static VkCommandBuffer get_stub_handle(uint32_t index)
+{
+    return reinterpret_cast<VkCommandBuffer>(static_cast<uintptr_t>(index + 1));
+}
+
+static StubCommandBuffer& get_stub_command_buffer(VkCommandBuffer command_buffer)
+{
+    uintptr_t const index = reinterpret_cast<uintptr_t>(command_buffer) - 1;
+    return s_command_buffers[index];
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL stub_create_command_pool(VkDevice, VkCommandPoolCreateInfo const*, VkAllocationCallbacks const*, VkCommandPool* command_pool)
+{
+    *command_pool = VK_NULL_HANDLE;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL stub_destroy_command_pool(VkDevice, VkCommandPool, VkAllocationCallbacks const*) {}
+static VKAPI_ATTR VkResult VKAPI_CALL stub_reset_command_pool(VkDevice, VkCommandPool, VkCommandPoolResetFlags) { return VK_SUCCESS; }
+
+static VKAPI_ATTR VkResult VKAPI_CALL stub_allocate_command_buffers(VkDevice, VkCommandBufferAllocateInfo const* allocate_info, VkCommandBuffer* command_buffers)
+{
+    for (uint32_t i = 0; i < allocate_info->commandBufferCount; i++)
+    {
+        if (s_allocated_command_buffers + 1 >= MAX_STUB_COMMAND_BUFFERS)
+        {
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        command_buffers[i] = get_stub_handle(++s_allocated_command_buffers);
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL stub_begin_command_buffer(VkCommandBuffer command_buffer, VkCommandBufferBeginInfo const* begin_info)
+{
+    StubCommandBuffer& stub = get_stub_command_buffer(command_buffer);
+    stub = {};
+    stub.usage_flags = begin_info->flags;
+    if (begin_info->pInheritanceInfo != nullptr)
+    {
+        auto const* rendering_info = static_cast<VkCommandBufferInheritanceRenderingInfo const*>(begin_info->pInheritanceInfo->pNext);
+        stub.inherited_color_count = rendering_info->colorAttachmentCount;
+        stub.inherited_color_format = rendering_info->colorAttachmentCount > 0 ? rendering_info->pColorAttachmentFormats[0] : VK_FORMAT_UNDEFINED;
+    }
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL stub_end_command_buffer(VkCommandBuffer command_buffer)
+{
+    get_stub_command_buffer(command_buffer).ended = true;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_begin_rendering(VkCommandBuffer, VkRenderingInfo const* rendering_info)
+{
+    s_rendering_flags = rendering_info->flags;
+}
+
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_execute_commands(VkCommandBuffer, uint32_t command_buffer_count, VkCommandBuffer const* command_buffers)
+{
+    s_executed_command_buffers.insert(s_executed_command_buffers.end(), command_buffers, command_buffers + command_buffer_count);
+}
+
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_draw(VkCommandBuffer command_buffer, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+    get_stub_command_buffer(command_buffer).draw_count++;
+}
+
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_end_rendering(VkCommandBuffer) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_pipeline_barrier2(VkCommandBuffer, VkDependencyInfo const*) {}
+static VKAPI_ATTR void VKAPI_CALL stub_cmd_set_primitive_topology(VkCommandBuffer, VkPrimitiveTopology) {}
+static VKAPI_ATTR void VKAPI_CALL stub_destroy_pipeline(VkDevice, VkPipeline, VkAllocationCallbacks const*) {}
+
+/// @brief Test fixture replacing the used Vulkan entry points with recording stubs, the original entry points are
+/// restored after each test.
+class parallel_recording_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_create_command_pool = vkCreateCommandPool;
+        m_destroy_command_pool = vkDestroyCommandPool;
+        m_reset_command_pool = vkResetCommandPool;
+        m_allocate_command_buffers = vkAllocateCommandBuffers;
+        m_begin_command_buffer = vkBeginCommandBuffer;
+        m_end_command_buffer = vkEndCommandBuffer;
+        m_cmd_begin_rendering = vkCmdBeginRendering;
+        m_cmd_end_rendering = vkCmdEndRendering;
+        m_cmd_execute_commands = vkCmdExecuteCommands;
+        m_cmd_pipeline_barrier2 = vkCmdPipelineBarrier2;
+        m_cmd_set_primitive_topology = vkCmdSetPrimitiveTopology;
+        m_cmd_draw = vkCmdDraw;
+        m_destroy_pipeline = vkDestroyPipeline;
+
+        vkCreateCommandPool = stub_create_command_pool;
+        vkDestroyCommandPool = stub_destroy_command_pool;
+        vkResetCommandPool = stub_reset_command_pool;
+        vkAllocateCommandBuffers = stub_allocate_command_buffers;
+        vkBeginCommandBuffer = stub_begin_command_buffer;
+        vkEndCommandBuffer = stub_end_command_buffer;
+        vkCmdBeginRendering = stub_cmd_begin_rendering;
+        vkCmdEndRendering = stub_cmd_end_rendering;
+        vkCmdExecuteCommands = stub_cmd_execute_commands;
+        vkCmdPipelineBarrier2 = stub_cmd_pipeline_barrier2;
+        vkCmdSetPrimitiveTopology = stub_cmd_set_primitive_topology;
+        vkCmdDraw = stub_cmd_draw;
+        vkDestroyPipeline = stub_destroy_pipeline;
+
+        std::fill(std::begin(s_command_buffers), std::end(s_command_buffers), StubCommandBuffer{});
+        s_allocated_command_buffers = 0;
+        s_rendering_flags = 0;
+        s_executed_command_buffers.clear();
+
+        // All handles are NULL or fake, the stubbed entry points never dereference them
+        VulkanTextureDesc target_desc{};
+        target_desc.format = RenderFormatRGBA8_UNORM;
+        target_desc.extent = RenderExtent3D{ 64, 64, 1 };
+        target_desc.mip_levels = 1;
+        target_desc.array_layers = 1;
+        target_desc.vk_aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT;
+        target_desc.vk_sample_count = VK_SAMPLE_COUNT_1_BIT;
+        m_target = new VulkanTexture(VK_NULL_HANDLE, VK_NULL_HANDLE, target_desc);
+        m_pipeline = new VulkanShaderPipeline(ShaderPipeline::Graphics, ShaderPipeline::WorkgroupSize{}, VK_NULL_HANDLE, {}, VK_NULL_HANDLE, VK_NULL_HANDLE);
+        m_recorder_pool = new VulkanParallelRecorderPool(VK_NULL_HANDLE, 0);
+        m_commands = new VulkanRenderCommands(get_stub_handle(0), nullptr, m_recorder_pool, nullptr, 1);
+    }
+
+    void TearDown() override
+    {
+        delete m_commands;
+        delete m_recorder_pool;
+        delete m_pipeline;
+        delete m_target;
+
+        vkCreateCommandPool = m_create_command_pool;
+        vkDestroyCommandPool = m_destroy_command_pool;
+        vkResetCommandPool = m_reset_command_pool;
+        vkAllocateCommandBuffers = m_allocate_command_buffers;
+        vkBeginCommandBuffer = m_begin_command_buffer;
+        vkEndCommandBuffer = m_end_command_buffer;
+        vkCmdBeginRendering = m_cmd_begin_rendering;
+        vkCmdEndRendering = m_cmd_end_rendering;
+        vkCmdExecuteCommands = m_cmd_execute_commands;
+        vkCmdPipelineBarrier2 = m_cmd_pipeline_barrier2;
+        vkCmdSetPrimitiveTopology = m_cmd_set_primitive_topology;
+        vkCmdDraw = m_cmd_draw;
+        vkDestroyPipeline = m_destroy_pipeline;
+    }
+
+    /// @brief Record a parallel render pass, recorder i records i + 1 draws from a job system worker.
+    /// @return true if all recorders recorded successfully.
+    bool record_parallel_pass(JobSystem& job_system, uint32_t recorder_count)
+    {
+        RenderAttachmentInfo color_target{};
+        color_target.render_target = m_target;
+        color_target.resolve_target = nullptr;
+        color_target.load_op = RenderLoadOpClear;
+        color_target.store_op = RenderStoreOpStore;
+        RenderRect2D const render_area{ RenderOffset2D{ 0, 0 }, RenderExtent2D{ 64, 64 } };
+
+        if (!m_commands->begin())
+        {
+            return false;
+        }
+
+        m_commands->begin_parallel_render_pass(render_area, &color_target, 1, nullptr, nullptr, 1, 0, recorder_count);
+        std::vector<uint8_t> recorder_results(recorder_count, 0);
+        job_system.parallel_for(recorder_count, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                RenderCommands* recorder = m_commands->get_parallel_recorder(static_cast<uint32_t>(i));
+                if (!recorder->begin())
+                {
+                    continue;
+                }
+
+                recorder->set_pipeline(m_pipeline);
+                recorder->set_primitive_topology(PrimitiveTopologyTypeTriangleList);
+                for (size_t draw = 0; draw <= i; draw++)
+                {
+                    recorder->draw_instanced(3, 1, 0, 0);
+                }
+                recorder_results[i] = recorder->end() ? 1 : 0;
+            }
+        });
+        m_commands->end_render_pass();
+
+        bool const commands_ok = m_commands->end();
+        return commands_ok && std::all_of(recorder_results.begin(), recorder_results.end(), [](uint8_t result) { return result != 0; });
+    }
+
+protected:
+    VulkanTexture* m_target = nullptr;
+    VulkanShaderPipeline* m_pipeline = nullptr;
+    VulkanParallelRecorderPool* m_recorder_pool = nullptr;
+    VulkanRenderCommands* m_commands = nullptr;
+
+private:
+    PFN_vkCreateCommandPool m_create_command_pool = nullptr;
+    PFN_vkDestroyCommandPool m_destroy_command_pool = nullptr;
+    PFN_vkResetCommandPool m_reset_command_pool = nullptr;
+    PFN_vkAllocateCommandBuffers m_allocate_command_buffers = nullptr;
+    PFN_vkBeginCommandBuffer m_begin_command_buffer = nullptr;
+    PFN_vkEndCommandBuffer m_end_command_buffer = nullptr;
+    PFN_vkCmdBeginRendering m_cmd_begin_rendering = nullptr;
+    PFN_vkCmdEndRendering m_cmd_end_rendering = nullptr;
+    PFN_vkCmdExecuteCommands m_cmd_execute_commands = nullptr;
+    PFN_vkCmdPipelineBarrier2 m_cmd_pipeline_barrier2 = nullptr;
+    PFN_vkCmdSetPrimitiveTopology m_cmd_set_primitive_topology = nullptr;
+    PFN_vkCmdDraw m_cmd_draw = nullptr;
+    PFN_vkDestroyPipeline m_destroy_pipeline = nullptr;
+};
+
+TEST_F(parallel_recording_tests, parallel_pass_executes_recorders_in_order)
+{
+    uint32_t const recorder_count = std::min(4U, m_commands->get_max_parallel_recorders());
+    ASSERT_GT(recorder_count, 0U);
+
+    JobSystem job_system(4);
+    ASSERT_TRUE(record_parallel_pass(job_system, recorder_count));
+    EXPECT_NE(s_rendering_flags & VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT, 0U);
+
+    ASSERT_EQ(s_executed_command_buffers.size(), recorder_count);
+    for (uint32_t i = 0; i < recorder_count; i++)
+    {
+        StubCommandBuffer const& recorded = get_stub_command_buffer(s_executed_command_buffers[i]);
+        EXPECT_TRUE(recorded.ended);
+        EXPECT_NE(recorded.usage_flags & VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, 0U);
+        EXPECT_EQ(recorded.inherited_color_count, 1U);
+        EXPECT_EQ(recorded.inherited_color_format, VK_FORMAT_R8G8B8A8_UNORM);
+        EXPECT_EQ(recorded.draw_count, i + 1);
+    }
+}
+
+TEST_F(parallel_recording_tests, recorder_command_buffers_are_reused_after_reset)
+{
+    uint32_t const recorder_count = std::min(4U, m_commands->get_max_parallel_recorders());
+    ASSERT_GT(recorder_count, 0U);
+
+    JobSystem job_system(4);
+    ASSERT_TRUE(record_parallel_pass(job_system, recorder_count));
+    uint32_t const allocated_command_buffers = s_allocated_command_buffers;
+    std::vector<VkCommandBuffer> const first_frame_command_buffers = s_executed_command_buffers;
+
+    s_executed_command_buffers.clear();
+    m_recorder_pool->reset();
+    ASSERT_TRUE(record_parallel_pass(job_system, recorder_count));
+    EXPECT_EQ(s_allocated_command_buffers, allocated_command_buffers);
+    EXPECT_EQ(s_executed_command_buffers, first_frame_command_buffers);
+}
+#endif //BONSAI_USE_VULKAN
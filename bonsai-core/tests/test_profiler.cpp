@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bonsai/core/profiler.hpp"
+
+/*
+ * CPU profiler tests, each test uses its own profiler so the engine profiler is left untouched.
+ */
+TEST(profiler_tests, zones_are_captured_per_thread)
+{
+    Profiler profiler{};
+    profiler.set_capturing(true);
+    {
+        ProfileScope outer(&profiler, "outer");
+        ProfileScope inner(&profiler, "inner");
+    }
+
+    std::thread worker([&profiler]() {
+        profiler.set_thread_name("worker");
+        ProfileScope scope(&profiler, "worker_zone");
+    });
+    worker.join();
+    profiler.flush();
+
+    std::vector<ProfileZone> const& zones = profiler.get_captured_zones();
+    ASSERT_EQ(zones.size(), 3);
+
+    // Scopes are recorded on destruction, so inner zones complete first
+    EXPECT_STREQ(zones[0].name, "inner");
+    EXPECT_STREQ(zones[1].name, "outer");
+    EXPECT_STREQ(zones[2].name, "worker_zone");
+    EXPECT_LE(zones[1].start_ns, zones[0].start_ns);
+    EXPECT_GE(zones[1].end_ns, zones[0].end_ns);
+    EXPECT_EQ(zones[0].thread_id, zones[1].thread_id);
+    EXPECT_NE(zones[0].thread_id, zones[2].thread_id);
+}
+
+TEST(profiler_tests, zones_are_discarded_when_not_capturing)
+{
+    Profiler profiler{};
+    {
+        ProfileScope scope(&profiler, "discarded");
+    }
+    profiler.flush();
+    EXPECT_TRUE(profiler.get_captured_zones().empty());
+
+    profiler.set_capturing(true);
+    profiler.flush();
+    EXPECT_TRUE(profiler.get_captured_zones().empty());
+}
+
+TEST(profiler_tests, full_ring_buffer_drops_zones)
+{
+    Profiler profiler{};
+    profiler.set_capturing(true);
+    for (size_t i = 0; i < BONSAI_PROFILER_THREAD_ZONE_CAPACITY + 10; i++)
+    {
+        profiler.record_zone("zone", i, i + 1);
+    }
+    profiler.flush();
+
+    EXPECT_EQ(profiler.get_captured_zones().size(), BONSAI_PROFILER_THREAD_ZONE_CAPACITY);
+    EXPECT_EQ(profiler.get_dropped_zone_count(), 10);
+}
+
+TEST(profiler_tests, chrome_trace_contains_zones)
+{
+    Profiler profiler{};
+    profiler.set_capturing(true);
+    profiler.set_thread_name("main");
+    profiler.record_zone("quoted \"zone\"", 1000, 3000);
+    profiler.flush();
+
+    char const* path = "test_profiler_trace.json";
+    ASSERT_TRUE(profiler.write_chrome_trace(path));
+
+    std::ifstream file(path);
+    std::stringstream contents{};
+    contents << file.rdbuf();
+    file.close();
+    std::remove(path);
+
+    std::string const trace = contents.str();
+    EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(trace.find("\"thread_name\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"quoted \\\"zone\\\"\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ts\":1,\"dur\":2"), std::string::npos);
+}
+
+TEST(profiler_tests, exited_thread_buffers_are_reused)
+{
+    static constexpr size_t ROUND_COUNT = 32;
+    static constexpr size_t THREADS_PER_ROUND = 4;
+
+    Profiler profiler{};
+    profiler.set_capturing(true);
+    for (size_t round = 0; round < ROUND_COUNT; round++)
+    {
+        std::vector<std::thread> workers{};
+        for (size_t i = 0; i < THREADS_PER_ROUND; i++)
+        {
+            workers.emplace_back([&profiler]() {
+                ProfileScope scope(&profiler, "worker_zone");
+            });
+        }
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        profiler.flush();
+    }
+
+    // Zones of exited threads are still flushed, while their buffers are reused by the next round
+    EXPECT_EQ(profiler.get_captured_zones().size(), ROUND_COUNT * THREADS_PER_ROUND);
+    EXPECT_LE(profiler.get_thread_buffer_count(), THREADS_PER_ROUND);
+}
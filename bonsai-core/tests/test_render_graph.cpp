@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "bonsai/systems/render_graph.hpp"
+
+/*
+ * Render graph compilation tests, these use a fake backend that records resource placements without a GPU device.
+ */
+class FakeMemoryHeap : public RenderMemoryHeap
+{
+public:
+    explicit FakeMemoryHeap(size_t size) : m_size(size) {}
+    size_t size() const override { return m_size; }
+
+private:
+    size_t m_size = 0;
+};
+
+class FakeBuffer : public RenderBuffer
+{
+public:
+    explicit FakeBuffer(size_t size) : m_size(size) {}
+    size_t size() const override { return m_size; }
+    bool map(void**, size_t, size_t) override { return false; }
+    void unmap() override {}
+
+private:
+    size_t m_size = 0;
+};
+
+class FakeTexture : public RenderTexture
+{
+public:
+    explicit FakeTexture(RenderFormat format) : m_format(format) {}
+    RenderFormat format() const override { return m_format; }
+    RenderExtent3D extent() const override { return {}; }
+    uint32_t mip_levels() const override { return 1; }
+    uint32_t array_layers() const override { return 1; }
+
+private:
+    RenderFormat m_format = RenderFormatUndefined;
+};
+
+/// @brief Fake backend, texture memory size is width * height and buffer memory size is the buffer size.
+class FakeRenderBackend : public RenderBackend
+{
+public:
+    struct Placement
+    {
+        RenderMemoryHeap* heap;
+        size_t offset;
+        size_t size;
+    };
+
+    void wait_idle() const override {}
+    void reconfigure_swap_chain(uint32_t, uint32_t) override {}
+    RenderExtent2D get_swap_extent() const override { return {}; }
+    RenderFormat get_swap_format() const override { return RenderFormatUndefined; }
+    bool is_swap_srgb() const override { return false; }
+    void imgui_new_frame() override {}
+    RenderBackendFrameResult new_frame() override { return RenderBackendFrameResult::Ok; }
+    RenderBackendFrameResult end_frame() override { return RenderBackendFrameResult::Ok; }
+    RenderCommands* get_frame_commands() override { return nullptr; }
+    RenderTexture* get_current_swap_texture() override { return nullptr; }
+    RenderBuffer* create_buffer(size_t, RenderBufferUsageFlags, bool) override { return nullptr; }
+    RenderTexture* create_texture(RenderTextureType, RenderFormat, uint32_t, uint32_t, uint32_t, uint32_t, SampleCount, RenderTextureUsageFlags, RenderTextureTilingMode) override { return nullptr; }
+    ShaderPipeline* create_graphics_pipeline(GraphicsPipelineDescriptor) override { return nullptr; }
+    ShaderPipeline* create_compute_pipeline(ComputePipelineDescriptor) override { return nullptr; }
+    uint64_t get_current_frame_index() const override { return 0; }
+    RenderGpuProfile const& get_gpu_profile() const override { return gpu_profile; }
+
+    RenderMemoryRequirements get_buffer_memory_requirements(size_t size, RenderBufferUsageFlags) const override
+    {
+        return RenderMemoryRequirements{ size, 256, 0x1 };
+    }
+
+    RenderMemoryRequirements get_texture_memory_requirements(
+        RenderTextureType,
+        RenderFormat,
+        uint32_t width,
+        uint32_t height,
+        uint32_t,
+        uint32_t,
+        SampleCount,
+        RenderTextureUsageFlags,
+        RenderTextureTilingMode
+    ) const override
+    {
+        return RenderMemoryRequirements{ static_cast<size_t>(width) * height, 1024, 0x3 };
+    }
+
+    RenderMemoryHeap* create_memory_heap(RenderMemoryRequirements const& requirements) override
+    {
+        return new FakeMemoryHeap(requirements.size);
+    }
+
+    RenderBuffer* create_aliased_buffer(RenderMemoryHeap* heap, size_t offset, size_t size, RenderBufferUsageFlags) override
+    {
+        placements.push_back(Placement{ heap, offset, size });
+        return new FakeBuffer(size);
+    }
+
+    RenderTexture* create_aliased_texture(
+        RenderMemoryHeap* heap,
+        size_t offset,
+        RenderTextureType,
+        RenderFormat format,
+        uint32_t width,
+        uint32_t height,
+        uint32_t,
+        uint32_t,
+        SampleCount,
+        RenderTextureUsageFlags,
+        RenderTextureTilingMode
+    ) override
+    {
+        placements.push_back(Placement{ heap, offset, static_cast<size_t>(width) * height });
+        return new FakeTexture(format);
+    }
+
+    std::vector<Placement> placements = {};
+    RenderGpuProfile gpu_profile = {};
+};
+
+static RenderGraphTextureDesc get_target_desc(uint32_t size)
+{
+    return RenderGraphTextureDesc{
+        RenderTextureType2D,
+        RenderFormatRGBA8_UNORM,
+        size, size, 1, 1,
+        SampleCount1Sample,
+        RenderTextureUsageRenderTarget | RenderTextureUsageSampled,
+    };
+}
+
+static void empty_pass(RenderGraph const&, RenderCommands*)
+{
+    //
+}
+
+TEST(render_graph_tests, unused_passes_are_culled)
+{
+    FakeRenderBackend backend{};
+    RenderGraph graph(&backend);
+    RenderGraphResource const output = graph.import_texture("output", nullptr, RenderResourceStatePresent);
+    RenderGraphResource const unused = graph.create_texture("unused", get_target_desc(64));
+
+    graph.add_pass("unused", empty_pass).write(unused, RenderResourceStateColorTarget);
+    graph.add_pass("output", empty_pass).write(output, RenderResourceStateColorTarget);
+    ASSERT_TRUE(graph.compile());
+
+    RenderGraphStatistics const statistics = graph.get_statistics();
+    EXPECT_EQ(statistics.pass_count, 2);
+    EXPECT_EQ(statistics.culled_pass_count, 1);
+    EXPECT_EQ(statistics.transient_resource_count, 0);
+    EXPECT_EQ(graph.get_texture(unused), nullptr);
+}
+
+TEST(render_graph_tests, disjoint_lifetimes_share_memory)
+{
+    FakeRenderBackend backend{};
+    RenderGraph graph(&backend);
+    RenderGraphResource const output = graph.import_texture("output", nullptr, RenderResourceStatePresent);
+    RenderGraphResource const gbuffer = graph.create_texture("gbuffer", get_target_desc(64));
+    RenderGraphResource const lighting = graph.create_texture("lighting", get_target_desc(64));
+    RenderGraphResource const bloom = graph.create_texture("bloom", get_target_desc(64));
+
+    graph.add_pass("gbuffer", empty_pass).write(gbuffer, RenderResourceStateColorTarget);
+    graph.add_pass("lighting", empty_pass)
+        .read(gbuffer, RenderResourceStateShaderRead)
+        .write(lighting, RenderResourceStateColorTarget);
+    graph.add_pass("bloom", empty_pass)
+        .read(lighting, RenderResourceStateShaderRead)
+        .write(bloom, RenderResourceStateColorTarget);
+    graph.add_pass("composite", empty_pass)
+        .read(bloom, RenderResourceStateShaderRead)
+        .write(output, RenderResourceStateColorTarget);
+    ASSERT_TRUE(graph.compile());
+
+    // The gbuffer is dead before the bloom target is written, so both fit in the same memory
+    RenderGraphStatistics const statistics = graph.get_statistics();
+    EXPECT_EQ(statistics.transient_resource_count, 3);
+    EXPECT_EQ(statistics.memory_heap_count, 1);
+    EXPECT_EQ(statistics.transient_memory_size, 3 * 64 * 64);
+    EXPECT_EQ(statistics.aliased_memory_size, 2 * 64 * 64);
+    ASSERT_EQ(backend.placements.size(), 3);
+    EXPECT_EQ(backend.placements[0].offset, 0);
+    EXPECT_EQ(backend.placements[1].offset, 64 * 64);
+    EXPECT_EQ(backend.placements[2].offset, 0);
+}
+
+TEST(render_graph_tests, buffers_and_textures_use_separate_heaps)
+{
+    FakeRenderBackend backend{};
+    RenderGraph graph(&backend);
+    RenderGraphResource const output = graph.import_texture("output", nullptr, RenderResourceStatePresent);
+    RenderGraphResource const target = graph.create_texture("target", get_target_desc(32));
+    RenderGraphResource const arguments = graph.create_buffer("arguments", RenderGraphBufferDesc{ 4096, RenderBufferUsageIndirectBuffer });
+
+    graph.add_pass("cull", empty_pass).write(arguments, RenderResourceStateShaderReadWrite);
+    graph.add_pass("draw", empty_pass)
+        .read(arguments, RenderResourceStateIndirectArgument)
+        .write(target, RenderResourceStateColorTarget);
+    graph.add_pass("composite", empty_pass)
+        .read(target, RenderResourceStateShaderRead)
+        .write(output, RenderResourceStateColorTarget);
+    ASSERT_TRUE(graph.compile());
+
+    RenderGraphStatistics const statistics = graph.get_statistics();
+    EXPECT_EQ(statistics.culled_pass_count, 0);
+    EXPECT_EQ(statistics.memory_heap_count, 2);
+    EXPECT_NE(graph.get_buffer(arguments), nullptr);
+    EXPECT_NE(graph.get_texture(target), nullptr);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "../src/render_backend/shader_bundle.hpp"
+
+/*
+ * Shader bundle tests, bundles are written with placeholder shader code since the bundle format does not inspect it.
+ */
+TEST(shader_bundle_tests, bundle_lookup_returns_written_code)
+{
+    char const* path = "test_shader_bundle_lookup.bundle";
+    uint32_t const vertex_code[] = { 0x0723'0203, 1, 2, 3 };
+    uint32_t const fragment_code[] = { 0x0723'0203, 4, 5 };
+    uint8_t const fragment_reflection[] = { 1, 2, 3, 4, 5, 6 };
+
+    ShaderBundleWriter bundle_writer{};
+    EXPECT_TRUE(bundle_writer.add("vs_6_7|VSMain|file:shader.hlsl", vertex_code, sizeof(vertex_code)));
+    EXPECT_TRUE(bundle_writer.add("ps_6_7|PSMain|file:shader.hlsl", fragment_code, sizeof(fragment_code), fragment_reflection, sizeof(fragment_reflection)));
+    EXPECT_FALSE(bundle_writer.add("ps_6_7|PSMain|file:shader.hlsl", vertex_code, sizeof(vertex_code)));
+    ASSERT_TRUE(bundle_writer.write(path));
+
+    ShaderBundle bundle{};
+    ASSERT_TRUE(bundle.open(path));
+    EXPECT_EQ(bundle.entry_count(), 2U);
+
+    ShaderBundleShader shader{};
+    ASSERT_TRUE(bundle.find("vs_6_7|VSMain|file:shader.hlsl", shader));
+    ASSERT_EQ(shader.code_size, sizeof(vertex_code));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(shader.code) % 4, 0U);
+    EXPECT_EQ(std::memcmp(shader.code, vertex_code, shader.code_size), 0);
+    EXPECT_EQ(shader.reflection_size, 0U);
+
+    ASSERT_TRUE(bundle.find("ps_6_7|PSMain|file:shader.hlsl", shader));
+    ASSERT_EQ(shader.code_size, sizeof(fragment_code));
+    EXPECT_EQ(std::memcmp(shader.code, fragment_code, shader.code_size), 0);
+    ASSERT_EQ(shader.reflection_size, sizeof(fragment_reflection));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(shader.reflection) % 4, 0U);
+    EXPECT_EQ(std::memcmp(shader.reflection, fragment_reflection, shader.reflection_size), 0);
+
+    EXPECT_FALSE(bundle.find("cs_6_7|CSMain|file:shader.hlsl", shader));
+    bundle.close();
+    std::remove(path);
+}
+
+TEST(shader_bundle_tests, invalid_bundle_is_rejected)
+{
+    char const* path = "test_shader_bundle_invalid.bundle";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a shader bundle";
+    }
+
+    ShaderBundle bundle{};
+    EXPECT_FALSE(bundle.open(path));
+    EXPECT_FALSE(bundle.is_open());
+    EXPECT_FALSE(bundle.open("test_shader_bundle_missing.bundle"));
+    std::remove(path);
+}
+
+TEST(shader_bundle_tests, overflowing_entry_offsets_are_rejected)
+{
+    char const* path = "test_shader_bundle_overflow.bundle";
+    uint32_t const code[] = { 0x0723'0203, 1, 2, 3 };
+    uint8_t const reflection[] = { 1, 2, 3, 4 };
+
+    // Offsets near UINT64_MAX wrap around when the size is added, the entry must still be rejected
+    size_t const offset_fields[] = {
+        offsetof(ShaderBundleEntry, key_offset),
+        offsetof(ShaderBundleEntry, code_offset),
+        offsetof(ShaderBundleEntry, reflection_offset),
+    };
+    for (auto const& offset_field : offset_fields)
+    {
+        ShaderBundleWriter bundle_writer{};
+        EXPECT_TRUE(bundle_writer.add("vs_6_7|VSMain|file:shader.hlsl", code, sizeof(code), reflection, sizeof(reflection)));
+        ASSERT_TRUE(bundle_writer.write(path));
+
+        ShaderBundle bundle{};
+        ASSERT_TRUE(bundle.open(path));
+        bundle.close();
+
+        uint64_t const overflowing_offset = UINT64_MAX - 7;
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(sizeof(ShaderBundleHeader) + offset_field));
+            file.write(reinterpret_cast<char const*>(&overflowing_offset), sizeof(overflowing_offset));
+        }
+
+        EXPECT_FALSE(bundle.open(path));
+        EXPECT_FALSE(bundle.is_open());
+    }
+    std::remove(path);
+}
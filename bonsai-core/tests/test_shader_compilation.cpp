@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
+
+#include <iterator>
+#include <vector>
+#include "bonsai/core/job_system.hpp"
+#include "../src/render_backend/builtin_shaders.hpp"
 #include "../src/render_backend/shader_compiler.hpp"
+#include "../src/render_backend/shader_compiler_pool.hpp"
+#include "../src/render_backend/shader_variant_cache.hpp"
 
 static constexpr char const* COMPUTE_SHADER = R"(
 struct Constants {
@@ -42,6 +49,111 @@ TEST(shader_compilation_tests, compile_compute_shader)
     EXPECT_TRUE(spirv_shader && spirv_shader->GetBufferSize() > 0 && spirv_shader->GetBufferPointer() != nullptr);
 }
 
+TEST(shader_compilation_tests, compile_depth_pyramid_shader)
+{
+    ShaderCompiler const shader_compiler{};
+    DxcBuffer const shader_source{ BONSAI_DEPTH_PYRAMID_SHADER, std::strlen(BONSAI_DEPTH_PYRAMID_SHADER), 0 };
+    CComPtr<IDxcBlob> dxil_shader{};
+    EXPECT_TRUE(shader_compiler.compile_source("dxil_depth_pyramid", BONSAI_DEPTH_PYRAMID_SHADER_ENTRYPOINT, BONSAI_TARGET_PROFILE_CS, shader_source, nullptr, false, &dxil_shader));
+    EXPECT_TRUE(dxil_shader && dxil_shader->GetBufferSize() > 0 && dxil_shader->GetBufferPointer() != nullptr);
+
+    CComPtr<IDxcBlob> spirv_shader{};
+    EXPECT_TRUE(shader_compiler.compile_source("spirv_depth_pyramid", BONSAI_DEPTH_PYRAMID_SHADER_ENTRYPOINT, BONSAI_TARGET_PROFILE_CS, shader_source, nullptr, true, &spirv_shader));
+    EXPECT_TRUE(spirv_shader && spirv_shader->GetBufferSize() > 0 && spirv_shader->GetBufferPointer() != nullptr);
+}
+
+TEST(shader_compilation_tests, compiler_pool_compiles_batch_in_parallel)
+{
+    static constexpr size_t REQUEST_COUNT = 8;
+    static constexpr char const* INVALID_SHADER = "[numthreads(1, 1, 1)] void CSMain() { undefined_function(); }";
+    JobSystem job_system(3);
+    ShaderCompilerPool shader_compiler_pool(4, &job_system);
+
+    // The last request fails, which must not affect the other results
+    std::vector<ShaderCompileRequest> requests(REQUEST_COUNT);
+    for (size_t i = 0; i < REQUEST_COUNT; i++)
+    {
+        char const* source = i + 1 < REQUEST_COUNT ? COMPUTE_SHADER : INVALID_SHADER;
+        requests[i] = ShaderCompileRequest{ "pool_shader", "CSMain", BONSAI_TARGET_PROFILE_CS, { source, std::strlen(source), 0 }, nullptr, nullptr, i % 2 == 0, nullptr, 0 };
+    }
+
+    std::vector<ShaderCompileResult> results(REQUEST_COUNT);
+    EXPECT_EQ(shader_compiler_pool.compile_many(requests.data(), requests.size(), results.data()), REQUEST_COUNT - 1);
+    for (size_t i = 0; i + 1 < REQUEST_COUNT; i++)
+    {
+        EXPECT_TRUE(results[i].success);
+        EXPECT_TRUE(results[i].compiled_shader && results[i].compiled_shader->GetBufferSize() > 0);
+    }
+    EXPECT_FALSE(results[REQUEST_COUNT - 1].success);
+
+    CComPtr<IDxcBlob> single_shader{};
+    EXPECT_TRUE(shader_compiler_pool.compile(requests[0], &single_shader));
+    EXPECT_TRUE(single_shader && single_shader->GetBufferSize() > 0);
+}
+
+static constexpr char const* PERMUTATION_SHADER = R"(
+[[vk::binding(0, 0)]] RWStructuredBuffer<uint> out_buffer : register(u0, space0);
+
+[shader("compute")]
+[numthreads(1, 1, 1)]
+void CSMain()
+{
+#if USE_OFFSET
+    out_buffer[0] = OUTPUT_VALUE + 1;
+#else
+    out_buffer[0] = OUTPUT_VALUE;
+#endif
+}
+)";
+
+TEST(shader_compilation_tests, compile_shader_with_defines)
+{
+    ShaderCompiler const shader_compiler{};
+    DxcBuffer const shader_source{ PERMUTATION_SHADER, std::strlen(PERMUTATION_SHADER), 0 };
+
+    // OUTPUT_VALUE is required, USE_OFFSET defaults to 1 if no value is given
+    CComPtr<IDxcBlob> missing_define_shader{};
+    EXPECT_FALSE(shader_compiler.compile_source("missing_define", "CSMain", BONSAI_TARGET_PROFILE_CS, shader_source, nullptr, true, &missing_define_shader));
+
+    ShaderDefine const defines[] = { { "OUTPUT_VALUE", "42" }, { "USE_OFFSET", nullptr } };
+    CComPtr<IDxcBlob> permutation_shader{};
+    EXPECT_TRUE(shader_compiler.compile_source("permutation", "CSMain", BONSAI_TARGET_PROFILE_CS, shader_source, nullptr, true, &permutation_shader, defines, std::size(defines)));
+    EXPECT_TRUE(permutation_shader && permutation_shader->GetBufferSize() > 0);
+}
+
+TEST(shader_compilation_tests, variant_cache_compiles_unique_permutations_once)
+{
+    ShaderDefine const defines[] = { { "OUTPUT_VALUE", "1" }, { "USE_OFFSET", "0" } };
+    ShaderDefine const reordered_defines[] = { { "USE_OFFSET", "0" }, { "OUTPUT_VALUE", "1" } };
+    ShaderDefine const other_defines[] = { { "OUTPUT_VALUE", "2" }, { "USE_OFFSET", "0" } };
+    DxcBuffer const shader_source{ PERMUTATION_SHADER, std::strlen(PERMUTATION_SHADER), 0 };
+    ShaderCompileRequest const requests[] = {
+        { "permutation", "CSMain", BONSAI_TARGET_PROFILE_CS, shader_source, nullptr, nullptr, true, defines, std::size(defines) },
+        { "permutation", "CSMain", BONSAI_TARGET_PROFILE_CS, shader_source, nullptr, nullptr, true, reordered_defines, std::size(reordered_defines) },
+        { "permutation", "CSMain", BONSAI_TARGET_PROFILE_CS, shader_source, nullptr, nullptr, true, other_defines, std::size(other_defines) },
+    };
+
+    // Define order does not affect the permutation key, define values & the include dir of inline sources do
+    EXPECT_EQ(ShaderVariantCache::get_key(requests[0]), ShaderVariantCache::get_key(requests[1]));
+    EXPECT_NE(ShaderVariantCache::get_key(requests[0]), ShaderVariantCache::get_key(requests[2]));
+    ShaderCompileRequest include_dir_request = requests[0];
+    include_dir_request.base_include_dir = "shaders";
+    EXPECT_NE(ShaderVariantCache::get_key(requests[0]), ShaderVariantCache::get_key(include_dir_request));
+
+    ShaderCompilerPool shader_compiler_pool(2, nullptr);
+    ShaderVariantCache shader_variant_cache{};
+    ShaderCompileResult results[std::size(requests)] = {};
+    EXPECT_EQ(shader_variant_cache.compile_many(shader_compiler_pool, requests, std::size(requests), results), std::size(requests));
+    EXPECT_EQ(shader_variant_cache.size(), 2U);
+    EXPECT_EQ(static_cast<IDxcBlob*>(results[0].compiled_shader), static_cast<IDxcBlob*>(results[1].compiled_shader));
+
+    // A second batch is served from the cache
+    ShaderCompileResult cached_results[std::size(requests)] = {};
+    EXPECT_EQ(shader_variant_cache.compile_many(shader_compiler_pool, requests, std::size(requests), cached_results), std::size(requests));
+    EXPECT_EQ(shader_variant_cache.size(), 2U);
+    EXPECT_EQ(static_cast<IDxcBlob*>(cached_results[2].compiled_shader), static_cast<IDxcBlob*>(results[2].compiled_shader));
+}
+
 /*
  * These are Vulkan only unit tests for the SPIRV reflector. This is separate from the Vulkan backend, but requires Vulkan
  * to be available before use.
@@ -105,4 +217,77 @@ TEST(shader_compilation_tests, reflect_compute_shader_pipeline_layout_spirv)
     }
 }
 
+TEST(shader_compilation_tests, reflect_from_serialized_reflection_spirv)
+{
+    ShaderCompiler const shader_compiler{};
+    CComPtr<IDxcBlob> spirv_shader{};
+    EXPECT_TRUE(shader_compiler.compile_source("reflect_shader", "CSMain", BONSAI_TARGET_PROFILE_CS, { COMPUTE_SHADER, std::strlen(COMPUTE_SHADER), 0 }, nullptr, true, &spirv_shader));
+
+    // A reflector created from deserialized reflection data must match one that parses the SPIR-V
+    ShaderReflectionData reflection{};
+    ASSERT_TRUE(SPIRVReflector::reflect(spirv_shader, reflection));
+    std::vector<uint8_t> serialized_reflection{};
+    serialize_shader_reflection(reflection, serialized_reflection);
+    ShaderReflectionData loaded_reflection{};
+    ASSERT_TRUE(deserialize_shader_reflection(serialized_reflection.data(), serialized_reflection.size(), loaded_reflection));
+
+    SPIRVReflector const spirv_reflector(spirv_shader);
+    SPIRVReflector const cached_reflector(&loaded_reflection, 1);
+    uint32_t x = 0, y = 0, z = 0;
+    cached_reflector.get_workgroup_size(x, y, z);
+    EXPECT_EQ(x, 1);
+    EXPECT_EQ(y, 2);
+    EXPECT_EQ(z, 3);
+
+    ASSERT_EQ(cached_reflector.get_push_constant_range_count(), spirv_reflector.get_push_constant_range_count());
+    ASSERT_EQ(cached_reflector.get_descriptor_binding_count(), spirv_reflector.get_descriptor_binding_count());
+    for (uint32_t i = 0; i < cached_reflector.get_descriptor_binding_count(); i++)
+    {
+        // Bindings are sorted, so both reflectors return them in the same order
+        DescriptorBinding const& cached_binding = cached_reflector.get_descriptor_bindings()[i];
+        DescriptorBinding const& spirv_binding = spirv_reflector.get_descriptor_bindings()[i];
+        EXPECT_EQ(cached_binding.binding, i);
+        EXPECT_EQ(cached_binding.binding, spirv_binding.binding);
+        EXPECT_EQ(cached_binding.set, spirv_binding.set);
+        EXPECT_EQ(cached_binding.layout_binding.descriptorType, spirv_binding.layout_binding.descriptorType);
+        EXPECT_EQ(cached_binding.layout_binding.stageFlags, spirv_binding.layout_binding.stageFlags);
+    }
+}
+
+TEST(shader_compilation_tests, reflect_specialization_constants_spirv)
+{
+    static constexpr char const* SPECIALIZED_SHADER = R"(
+[[vk::constant_id(3)]] const uint LOOP_COUNT = 4;
+[[vk::constant_id(7)]] const bool USE_SCALE = false;
+[[vk::binding(0, 0)]] RWStructuredBuffer<uint> out_buffer : register(u0, space0);
+
+[shader("compute")]
+[numthreads(1, 1, 1)]
+void CSMain()
+{
+    uint value = 0;
+    for (uint i = 0; i < LOOP_COUNT; i++)
+    {
+        value += USE_SCALE ? 2 : 1;
+    }
+    out_buffer[0] = value;
+}
+)";
+
+    ShaderCompiler const shader_compiler{};
+    CComPtr<IDxcBlob> spirv_shader{};
+    EXPECT_TRUE(shader_compiler.compile_source("specialized_shader", "CSMain", BONSAI_TARGET_PROFILE_CS, { SPECIALIZED_SHADER, std::strlen(SPECIALIZED_SHADER), 0 }, nullptr, true, &spirv_shader));
+
+    SPIRVReflector reflector(spirv_shader);
+    uint32_t constant_id = 0;
+    EXPECT_TRUE(reflector.find_specialization_constant(VK_SHADER_STAGE_COMPUTE_BIT, "LOOP_COUNT", constant_id));
+    EXPECT_EQ(constant_id, 3);
+    EXPECT_TRUE(reflector.find_specialization_constant(VK_SHADER_STAGE_COMPUTE_BIT, "USE_SCALE", constant_id));
+    EXPECT_EQ(constant_id, 7);
+
+    // Constants are only found for the stage that declares them
+    EXPECT_FALSE(reflector.find_specialization_constant(VK_SHADER_STAGE_COMPUTE_BIT, "MISSING_CONSTANT", constant_id));
+    EXPECT_FALSE(reflector.find_specialization_constant(VK_SHADER_STAGE_VERTEX_BIT, "LOOP_COUNT", constant_id));
+}
+
 #endif //BONSAI_USE_VULKAN
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include "../src/render_backend/shader_reflection.hpp"
+
+TEST(shader_reflection_tests, serialized_reflection_round_trips)
+{
+    ShaderReflectionData reflection{};
+    reflection.shader_stage = 0x20;
+    reflection.workgroup_size[0] = 8;
+    reflection.workgroup_size[1] = 4;
+    reflection.workgroup_size[2] = 1;
+    reflection.push_constant_blocks.push_back(ReflectedPushConstantBlock{ "constants", 0, 16 });
+    reflection.descriptor_bindings.push_back(ReflectedDescriptorBinding{ "input", 0, 0, 6, 1 });
+    reflection.descriptor_bindings.push_back(ReflectedDescriptorBinding{ "output_buffer", 0, 1, 7, 1 });
+    reflection.specialization_constants.push_back(ReflectedSpecializationConstant{ "LOOP_COUNT", 3 });
+
+    std::vector<uint8_t> data{};
+    serialize_shader_reflection(reflection, data);
+    EXPECT_EQ(data.size() % 4, 0U);
+
+    ShaderReflectionData result{};
+    ASSERT_TRUE(deserialize_shader_reflection(data.data(), data.size(), result));
+    EXPECT_EQ(result.shader_stage, reflection.shader_stage);
+    EXPECT_EQ(result.workgroup_size[0], 8U);
+    EXPECT_EQ(result.workgroup_size[1], 4U);
+    EXPECT_EQ(result.workgroup_size[2], 1U);
+
+    ASSERT_EQ(result.push_constant_blocks.size(), 1U);
+    EXPECT_EQ(result.push_constant_blocks[0].name, "constants");
+    EXPECT_EQ(result.push_constant_blocks[0].size, 16U);
+
+    ASSERT_EQ(result.descriptor_bindings.size(), 2U);
+    EXPECT_EQ(result.descriptor_bindings[1].name, "output_buffer");
+    EXPECT_EQ(result.descriptor_bindings[1].binding, 1U);
+    EXPECT_EQ(result.descriptor_bindings[1].descriptor_type, 7U);
+
+    ASSERT_EQ(result.specialization_constants.size(), 1U);
+    EXPECT_EQ(result.specialization_constants[0].name, "LOOP_COUNT");
+    EXPECT_EQ(result.specialization_constants[0].constant_id, 3U);
+}
+
+TEST(shader_reflection_tests, truncated_reflection_is_rejected)
+{
+    ShaderReflectionData reflection{};
+    reflection.descriptor_bindings.push_back(ReflectedDescriptorBinding{ "output_buffer", 0, 1, 7, 1 });
+
+    std::vector<uint8_t> data{};
+    serialize_shader_reflection(reflection, data);
+
+    ShaderReflectionData result{};
+    EXPECT_FALSE(deserialize_shader_reflection(data.data(), data.size() - 4, result));
+    EXPECT_FALSE(deserialize_shader_reflection(data.data(), 8, result));
+
+    data[0] ^= 0xFF;
+    EXPECT_FALSE(deserialize_shader_reflection(data.data(), data.size(), result));
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+/*
+ * These are Vulkan only unit tests for the layout cache, they only test cache key generation and do not require
+ * a Vulkan device.
+ */
+#if BONSAI_USE_VULKAN
+#include "../src/render_backend/vulkan/vulkan_layout_cache.hpp"
+
+static constexpr VkDescriptorSetLayoutBinding UNIFORM_BINDING = {
+    0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr,
+};
+
+static constexpr VkDescriptorSetLayoutBinding TEXTURE_BINDING = {
+    1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr,
+};
+
+TEST(layout_cache_tests, set_layout_key_ignores_binding_order)
+{
+    VkDescriptorSetLayoutBinding const bindings[] = { UNIFORM_BINDING, TEXTURE_BINDING };
+    VkDescriptorSetLayoutBinding const reversed_bindings[] = { TEXTURE_BINDING, UNIFORM_BINDING };
+    EXPECT_EQ(VulkanLayoutCache::get_descriptor_set_layout_key(bindings, 2), VulkanLayoutCache::get_descriptor_set_layout_key(reversed_bindings, 2));
+    EXPECT_NE(VulkanLayoutCache::get_descriptor_set_layout_key(bindings, 2), VulkanLayoutCache::get_descriptor_set_layout_key(bindings, 1));
+}
+
+TEST(layout_cache_tests, set_layout_key_includes_binding_description)
+{
+    VkDescriptorSetLayoutBinding stage_binding = UNIFORM_BINDING;
+    stage_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    VkDescriptorSetLayoutBinding count_binding = UNIFORM_BINDING;
+    count_binding.descriptorCount = 4;
+
+    std::string const key = VulkanLayoutCache::get_descriptor_set_layout_key(&UNIFORM_BINDING, 1);
+    EXPECT_NE(key, VulkanLayoutCache::get_descriptor_set_layout_key(&stage_binding, 1));
+    EXPECT_NE(key, VulkanLayoutCache::get_descriptor_set_layout_key(&count_binding, 1));
+}
+
+TEST(layout_cache_tests, pipeline_layout_key_includes_push_constants)
+{
+    VkPushConstantRange const vertex_range = { VK_SHADER_STAGE_VERTEX_BIT, 0, 64 };
+    VkPushConstantRange const compute_range = { VK_SHADER_STAGE_COMPUTE_BIT, 0, 64 };
+
+    std::string const empty_key = VulkanLayoutCache::get_pipeline_layout_key(nullptr, 0, nullptr, 0);
+    std::string const vertex_key = VulkanLayoutCache::get_pipeline_layout_key(nullptr, 0, &vertex_range, 1);
+    EXPECT_EQ(vertex_key, VulkanLayoutCache::get_pipeline_layout_key(nullptr, 0, &vertex_range, 1));
+    EXPECT_NE(vertex_key, empty_key);
+    EXPECT_NE(vertex_key, VulkanLayoutCache::get_pipeline_layout_key(nullptr, 0, &compute_range, 1));
+
+    // Empty descriptor sets take up a slot in the pipeline layout, so the set count is part of the key
+    VkDescriptorSetLayout const set_layouts[] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+    EXPECT_NE(VulkanLayoutCache::get_pipeline_layout_key(set_layouts, 1, nullptr, 0), VulkanLayoutCache::get_pipeline_layout_key(set_layouts, 2, nullptr, 0));
+}
+#endif //BONSAI_USE_VULKAN
@@ -0,0 +1,104 @@
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "bonsai/core/event_stream.hpp"
+
+/*
+ * Event stream decoder, prints the records of an event stream file as text or CSV.
+ *
+ * Usage: bonsai_event_decoder [--csv] <event stream file>
+ */
+
+/// @brief Print an event record payload with named fields.
+static void print_event_data(EventRecord const& record)
+{
+    switch (record.type)
+    {
+    case EventTypeFrameBegin:
+        std::printf("frame=%" PRIu64, record.data[0]);
+        break;
+    case EventTypeFrameEnd:
+        std::printf("frame=%" PRIu64 " cpu_time_ms=%.3f", record.data[0], static_cast<double>(record.data[1]) / 1e6);
+        break;
+    case EventTypePipelineCreated:
+        std::printf("pipeline=%s creation_time_ms=%.3f", record.data[0] == 0 ? "graphics" : "compute", static_cast<double>(record.data[1]) / 1e6);
+        break;
+    case EventTypeAllocation:
+        std::printf("resource=%s size=%" PRIu64, record.data[0] == 0 ? "buffer" : "texture", record.data[1]);
+        break;
+    case EventTypeSwapchainRecreated:
+        std::printf("extent=%" PRIu64 "x%" PRIu64, record.data[0], record.data[1]);
+        break;
+    default:
+        std::printf("data0=%" PRIu64 " data1=%" PRIu64, record.data[0], record.data[1]);
+        break;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool csv = false;
+    char const* path = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--csv") == 0)
+        {
+            csv = true;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    if (path == nullptr)
+    {
+        std::fprintf(stderr, "Usage: %s [--csv] <event stream file>\n", argv[0]);
+        return 1;
+    }
+
+    EventStreamInfo info{};
+    std::vector<EventRecord> records{};
+    if (!read_event_stream(path, info, records))
+    {
+        std::fprintf(stderr, "Failed to read event stream file %s\n", path);
+        return 1;
+    }
+
+    if (csv)
+    {
+        std::printf("timestamp_ns,thread_id,type,data0,data1\n");
+        for (auto const& record : records)
+        {
+            std::printf("%" PRIu64 ",%u,%s,%" PRIu64 ",%" PRIu64 "\n",
+                record.timestamp_ns, record.thread_id, get_event_type_name(record.type), record.data[0], record.data[1]);
+        }
+
+        return 0;
+    }
+
+    uint64_t const dropped_count = info.write_count - records.size();
+    std::printf("Event stream: %zu records (%" PRIu64 " written, %" PRIu64 " overwritten), started at %" PRIu64 " ns since the Unix epoch\n",
+        records.size(), info.write_count, dropped_count, info.start_unix_ns);
+
+    uint64_t type_counts[EventTypeCount + 1] = {};
+    for (auto const& record : records)
+    {
+        type_counts[record.type < EventTypeCount ? record.type : EventTypeCount]++;
+        std::printf("%14.6f ms  thread %-3u  %-20s ", static_cast<double>(record.timestamp_ns) / 1e6, record.thread_id, get_event_type_name(record.type));
+        print_event_data(record);
+        std::printf("\n");
+    }
+
+    std::printf("\nEvent counts:\n");
+    for (uint32_t type = 0; type <= EventTypeCount; type++)
+    {
+        if (type_counts[type] > 0)
+        {
+            std::printf("  %-20s %" PRIu64 "\n", get_event_type_name(type), type_counts[type]);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bonsai/core/job_system.hpp"
+#include "render_backend/shader_bundle.hpp"
+#include "render_backend/shader_compiler_pool.hpp"
+#include "render_backend/shader_variant_cache.hpp"
+#if BONSAI_USE_VULKAN
+#include "render_backend/vulkan/spirv_reflector.hpp"
+#endif //BONSAI_USE_VULKAN
+
+/*
+ * Offline shader compiler, compiles the shader permutations listed in a manifest into a shader bundle.
+ * The bundle is loaded by the backend at startup (BONSAI_SHADER_BUNDLE=<bundle file>), bundled permutations are not
+ * compiled or reflected at runtime.
+ *
+ * Usage: bonsai_shaderc [--threads N] <manifest file> <output bundle file>
+ *
+ * --threads limits the number of compiling threads including the calling thread, 1 compiles serially & 0 (the default)
+ * uses all hardware threads.
+ *
+ * The manifest lists one permutation per line, empty lines & lines starting with '#' are ignored:
+ *
+ *      <vs|ps|cs> <entrypoint> <shader file> [NAME[=VALUE] ...]
+ *
+ * Shader file paths are used as permutation keys, so they must match the paths passed to the engine as shader sources.
+ */
+
+/// @brief Shader permutation as listed in the manifest.
+struct ManifestEntry
+{
+    size_t line;
+    LPCWSTR target_profile;
+    std::string entrypoint;
+    std::string file_path;
+    std::vector<std::string> define_names;
+    std::vector<std::string> define_values;
+    std::vector<ShaderDefine> defines;
+};
+
+/// @brief Get the target profile for a manifest shader stage.
+/// @param stage Shader stage name.
+/// @return The target profile, or nullptr for unknown stages.
+static LPCWSTR get_target_profile(std::string const& stage)
+{
+    if (stage == "vs")
+        return BONSAI_TARGET_PROFILE_VS;
+    else if (stage == "ps")
+        return BONSAI_TARGET_PROFILE_PS;
+    else if (stage == "cs")
+        return BONSAI_TARGET_PROFILE_CS;
+
+    return nullptr;
+}
+
+/// @brief Parse a shader manifest file.
+/// @param path Manifest file path.
+/// @param entries Output manifest entries.
+/// @return A boolean indicating successful parsing.
+static bool parse_manifest(char const* path, std::vector<ManifestEntry>& entries)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::fprintf(stderr, "Failed to open manifest %s\n", path);
+        return false;
+    }
+
+    std::string line{};
+    for (size_t line_number = 1; std::getline(file, line); line_number++)
+    {
+        std::istringstream tokens(line);
+        std::string stage{};
+        if (!(tokens >> stage) || stage[0] == '#')
+        {
+            continue;
+        }
+
+        ManifestEntry entry{};
+        entry.line = line_number;
+        entry.target_profile = get_target_profile(stage);
+        if (entry.target_profile == nullptr || !(tokens >> entry.entrypoint >> entry.file_path))
+        {
+            std::fprintf(stderr, "%s:%zu: expected '<vs|ps|cs> <entrypoint> <shader file> [NAME[=VALUE] ...]'\n", path, line_number);
+            return false;
+        }
+
+        std::string define{};
+        while (tokens >> define)
+        {
+            size_t const separator = define.find('=');
+            entry.define_names.push_back(define.substr(0, separator));
+            entry.define_values.push_back(separator != std::string::npos ? define.substr(separator + 1) : "1");
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    // Define pointers are set once all entries are parsed, since the entry strings no longer move
+    for (auto& entry : entries)
+    {
+        for (size_t i = 0; i < entry.define_names.size(); i++)
+        {
+            entry.defines.push_back(ShaderDefine{ entry.define_names[i].c_str(), entry.define_values[i].c_str() });
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t thread_count = 0;
+    std::vector<char const*> paths{};
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            thread_count = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (paths.size() != 2)
+    {
+        std::fprintf(stderr, "Usage: %s [--threads N] <manifest file> <output bundle file>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<ManifestEntry> entries{};
+    if (!parse_manifest(paths[0], entries))
+    {
+        return 1;
+    }
+
+    std::vector<ShaderCompileRequest> requests(entries.size());
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        ShaderCompileRequest& request = requests[i];
+        request = ShaderCompileRequest{};
+        request.name = entries[i].file_path.c_str();
+        request.entrypoint = entries[i].entrypoint.c_str();
+        request.target_profile = entries[i].target_profile;
+        request.file_path = entries[i].file_path.c_str();
+        request.compile_into_spirv = true;
+        request.defines = entries[i].defines.data();
+        request.define_count = entries[i].defines.size();
+    }
+
+    // The variant cache reflects compiled permutations, so reflection data can be stored in the bundle
+    // The calling thread compiles alongside the job system workers, zero threads uses all hardware threads.
+    // A single thread compiles on the calling thread without any workers.
+    JobSystem* job_system = nullptr;
+    if (thread_count != 1)
+    {
+        job_system = new JobSystem(thread_count > 1 ? thread_count - 1 : 0);
+    }
+    ShaderCompilerPool shader_compiler_pool(thread_count, job_system);
+    ShaderVariantCache shader_variant_cache{};
+#if BONSAI_USE_VULKAN
+    shader_variant_cache.set_reflect_function(SPIRVReflector::reflect);
+#endif //BONSAI_USE_VULKAN
+    std::vector<ShaderCompileResult> results(requests.size());
+    size_t const success_count = shader_variant_cache.compile_many(shader_compiler_pool, requests.data(), requests.size(), results.data());
+    delete job_system; // The compiler pool is not used past this point
+    job_system = nullptr;
+
+    ShaderBundleWriter bundle_writer{};
+    std::vector<uint8_t> reflection_data{};
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        if (!results[i].success)
+        {
+            std::fprintf(stderr, "%s:%zu: failed to compile %s (%s)\n", paths[0], entries[i].line, entries[i].file_path.c_str(), entries[i].entrypoint.c_str());
+            continue;
+        }
+
+        reflection_data.clear();
+        if (results[i].has_reflection)
+        {
+            serialize_shader_reflection(results[i].reflection, reflection_data);
+        }
+
+        IDxcBlob* compiled_shader = results[i].compiled_shader;
+        std::string const key = ShaderVariantCache::get_key(requests[i]);
+        if (!bundle_writer.add(key, compiled_shader->GetBufferPointer(), compiled_shader->GetBufferSize(), reflection_data.data(), reflection_data.size()))
+        {
+            std::fprintf(stderr, "%s:%zu: duplicate permutation ignored\n", paths[0], entries[i].line);
+        }
+    }
+
+    if (success_count != requests.size())
+    {
+        std::fprintf(stderr, "%zu of %zu permutations failed to compile\n", requests.size() - success_count, requests.size());
+        return 1;
+    }
+
+    if (!bundle_writer.write(paths[1]))
+    {
+        std::fprintf(stderr, "Failed to write shader bundle %s\n", paths[1]);
+        return 1;
+    }
+
+    std::printf("Wrote %zu permutations to %s\n", bundle_writer.entry_count(), paths[1]);
+    return 0;
+}